@@ -108,5 +108,13 @@ ApplicationWindow {
                 root.enterNav()
             }
         }
+
+        // ─── Input Latency Overlay ───
+        InputLatencyOverlay {
+            anchors.top: parent.top
+            anchors.right: parent.right
+            anchors.margins: 16
+            z: 100
+        }
     }
 }
@@ -0,0 +1,65 @@
+import QtQuick
+
+// Wide artwork (hero) resolved through ArtworkManager and loaded
+// progressively: a cheap downscaled decode paints first, and the
+// full-size decode is only requested once that has loaded and while
+// fullResolution is set — i.e. for the game focus has settled on.
+Item {
+    id: backdrop
+
+    property int gameId: -1
+    property string kind: "hero"
+    property string url: ""
+    property bool fullResolution: false
+    property int previewWidth: 480
+    property int fillMode: Image.PreserveAspectCrop
+
+    readonly property bool ready: lowRes.status === Image.Ready || fullRes.status === Image.Ready
+
+    // Path reported by assetReady; reset whenever the game changes
+    property string downloadedPath: ""
+    onGameIdChanged: downloadedPath = ""
+    onUrlChanged: downloadedPath = ""
+
+    property string localPath: {
+        if (downloadedPath.length > 0) return downloadedPath
+        if (gameId < 0 || !url || url.length === 0) return ""
+        return ArtworkManager.getArtwork(gameId, kind, url) || ""
+    }
+
+    readonly property string source: {
+        if (localPath.length === 0) return ""
+        return localPath.startsWith("/") ? "file://" + localPath : localPath
+    }
+
+    Connections {
+        target: ArtworkManager
+        function onAssetReady(readyGameId, readyKind, path) {
+            if (readyGameId === backdrop.gameId && readyKind === backdrop.kind)
+                backdrop.downloadedPath = path
+        }
+    }
+
+    Image {
+        id: lowRes
+        anchors.fill: parent
+        source: backdrop.source
+        sourceSize.width: backdrop.previewWidth
+        fillMode: backdrop.fillMode
+        asynchronous: true
+        smooth: true
+        opacity: status === Image.Ready && fullRes.status !== Image.Ready ? 1.0 : 0.0
+        Behavior on opacity { NumberAnimation { duration: 250; easing.type: Easing.OutQuad } }
+    }
+
+    Image {
+        id: fullRes
+        anchors.fill: parent
+        source: backdrop.fullResolution && lowRes.status === Image.Ready ? backdrop.source : ""
+        sourceSize.width: Math.max(backdrop.width, backdrop.previewWidth)
+        fillMode: backdrop.fillMode
+        asynchronous: true
+        opacity: status === Image.Ready ? 1.0 : 0.0
+        Behavior on opacity { NumberAnimation { duration: 300; easing.type: Easing.OutQuad } }
+    }
+}
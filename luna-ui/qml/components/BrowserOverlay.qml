@@ -129,6 +129,23 @@ Item {
                 color: BrowserBridge.cdpErrors > 0 ? "#e74c3c" : "#95a5a6"
             }
 
+            Text {
+                text: "cdp rtt p50: " + BrowserBridge.cdpRoundTripMs.toFixed(1)
+                      + " ms  p95: " + BrowserBridge.cdpRoundTripP95Ms.toFixed(1)
+                      + " ms  pending: " + BrowserBridge.cdpPending
+                font.pixelSize: 13
+                font.family: "monospace"
+                color: "#95a5a6"
+            }
+
+            Text {
+                text: "page: " + BrowserBridge.navElements
+                      + " elements  move avg: " + BrowserBridge.navMoveMs.toFixed(2) + " ms"
+                font.pixelSize: 13
+                font.family: "monospace"
+                color: "#95a5a6"
+            }
+
             Text {
                 text: BrowserBridge.diagnostics
                 font.pixelSize: 12
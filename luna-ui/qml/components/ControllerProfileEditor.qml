@@ -33,7 +33,8 @@ Rectangle {
             "navigate_up", "navigate_down", "navigate_left", "navigate_right",
             "previous_tab", "next_tab",
             "filters", "sort",
-            "scroll_up", "scroll_down"
+            "scroll_up", "scroll_down",
+            "jump_previous", "jump_next"
         ]
 
         var actionNames = {
@@ -52,7 +53,9 @@ Rectangle {
             "filters": "Filters",
             "sort": "Sort",
             "scroll_up": "Scroll Up",
-            "scroll_down": "Scroll Down"
+            "scroll_down": "Scroll Down",
+            "jump_previous": "Jump to Previous Letter",
+            "jump_next": "Jump to Next Letter"
         }
 
         var mappings = ProfileResolver.getMappingsForProfile(profileId)
@@ -256,7 +259,9 @@ Rectangle {
                             "filters": "Filters",
                             "sort": "Sort",
                             "scroll_up": "Scroll Up",
-                            "scroll_down": "Scroll Down"
+                            "scroll_down": "Scroll Down",
+                            "jump_previous": "Jump to Previous Letter",
+                            "jump_next": "Jump to Next Letter"
                         }
                         return names[listeningAction] || listeningAction
                     }
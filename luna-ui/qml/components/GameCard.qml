@@ -22,6 +22,9 @@ Rectangle {
     property double downloadProgress: -1.0  // -1 = not downloading, 0..1 = progress
     property string installError: ""        // non-empty = error during install
     property bool isKeyboardFocused: false  // Set by parent grid when this card is selected via keyboard
+    property string dominantColor: ""       // "#rrggbb" placeholder tint, empty until computed
+    property string placeholderPreview: ""  // encoded low-res cover for the blurred placeholder
+    property string protonTier: ""          // ProtonDB tier from games.db, empty if unknown
 
     signal playClicked(int id)
     signal favoriteClicked(int id)
@@ -35,14 +38,29 @@ Rectangle {
         return cached || ""
     }
 
+    // Pre-decoded card-size copy from the memory-mapped store; loads
+    // synchronously since there is nothing to decode.  decodedRevision
+    // re-evaluates it when a decode lands after the card was created.
+    property int decodedRevision: 0
+    property string decodedArt: {
+        decodedRevision
+        return gameId > 0 ? ArtworkManager.getDecodedCover(gameId) : ""
+    }
+
     // When ArtworkManager finishes downloading, update the source
     Connections {
         target: ArtworkManager
         function onArtworkReady(readyGameId, localPath) {
-            if (readyGameId === gameId) {
+            if (readyGameId === gameId && decodedArt.length === 0) {
                 coverImage.source = "file://" + localPath
             }
         }
+        function onDecodedCoverChanged(changedGameId) {
+            if (changedGameId === gameId) {
+                decodedRevision++
+                coverImage.source = decodedArt
+            }
+        }
     }
 
     // Retry timer — if image fails, retry a few times with backoff
@@ -76,6 +94,8 @@ Rectangle {
             id: coverImage
             anchors.fill: parent
             source: {
+                if (decodedArt.length > 0)
+                    return decodedArt
                 if (resolvedArt.length > 0) {
                     // Local paths need file:// prefix, URLs stay as-is
                     if (resolvedArt.startsWith("/"))
@@ -95,7 +115,7 @@ Rectangle {
             fillMode: Image.PreserveAspectFit
             visible: status === Image.Ready
             opacity: isInstalled ? 1.0 : (downloadProgress >= 0 ? 0.7 : 0.5)
-            asynchronous: true
+            asynchronous: decodedArt.length === 0
             cache: true
 
             onStatusChanged: {
@@ -105,15 +125,36 @@ Rectangle {
             }
         }
 
-        // Placeholder if no art loaded
+        // Placeholder until the art is loaded: the cover's blurred preview
+        // and dominant colour when known, otherwise the title initial.
+        // Fades out over the real art (instant for pre-decoded covers).
         Rectangle {
-            visible: coverImage.status !== Image.Ready
+            id: placeholder
+            property real baseOpacity: isInstalled ? 1.0 : (downloadProgress >= 0 ? 0.7 : 0.5)
             anchors.fill: parent
-            color: ThemeManager.getColor("surface")
-            opacity: isInstalled ? 1.0 : (downloadProgress >= 0 ? 0.7 : 0.5)
+            color: dominantColor.length > 0 ? dominantColor : ThemeManager.getColor("surface")
+            opacity: coverImage.status === Image.Ready ? 0.0 : baseOpacity
+            visible: opacity > 0
+
+            Behavior on opacity {
+                enabled: decodedArt.length === 0
+                NumberAnimation { duration: 250; easing.type: Easing.OutQuad }
+            }
+
+            Image {
+                anchors.fill: parent
+                visible: placeholderPreview.length > 0
+                source: placeholderPreview.length > 0
+                        ? "image://artwork/preview/" + placeholderPreview : ""
+                sourceSize: Qt.size(32, 48)
+                fillMode: Image.Stretch
+                smooth: true
+                cache: false
+            }
 
             Text {
                 anchors.centerIn: parent
+                visible: placeholderPreview.length === 0
                 text: gameTitle.length > 0 ? gameTitle.charAt(0).toUpperCase() : "?"
                 font.pixelSize: 48
                 font.bold: true
@@ -204,6 +245,48 @@ Rectangle {
         anchors.margins: 8
     }
 
+    // ProtonDB compatibility badge
+    Rectangle {
+        visible: protonTier.length > 0
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 8
+        width: tierRow.width + 12
+        height: 20
+        radius: 10
+        color: Qt.rgba(0, 0, 0, 0.7)
+
+        Row {
+            id: tierRow
+            anchors.centerIn: parent
+            spacing: 4
+
+            Rectangle {
+                anchors.verticalCenter: parent.verticalCenter
+                width: 8
+                height: 8
+                radius: 4
+                color: {
+                    switch (protonTier.toLowerCase()) {
+                        case "platinum": return "#b4c7dc"
+                        case "gold":     return "#cfb53b"
+                        case "silver":   return "#a6a6a6"
+                        case "bronze":   return "#cd7f32"
+                        case "borked":   return "#ff0000"
+                        default:         return ThemeManager.getColor("textSecondary")
+                    }
+                }
+            }
+
+            Text {
+                text: protonTier.charAt(0).toUpperCase() + protonTier.slice(1)
+                font.pixelSize: 10
+                font.family: ThemeManager.getFont("body")
+                color: ThemeManager.getColor("textPrimary")
+            }
+        }
+    }
+
     // Hover/focus effect: scale 1.05x
     scale: (mouseArea.containsMouse || isKeyboardFocused) ? 1.05 : 1.0
     Behavior on scale { NumberAnimation { duration: 150 } }
@@ -31,6 +31,39 @@ Rectangle {
             gameData.storeSource || "", gameData.id)
     }
 
+    // Hero backdrop behind the header; the detail view is always the
+    // focused game, so it gets the full-resolution decode.
+    Item {
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.top: parent.top
+        height: Math.min(parent.height * 0.45, 360)
+        visible: !controllerEditorOpen
+
+        Rectangle {
+            anchors.fill: parent
+            color: gameData && gameData.dominantColor ? gameData.dominantColor : "transparent"
+            opacity: 0.35
+        }
+
+        ArtworkBackdrop {
+            anchors.fill: parent
+            gameId: gameData ? gameData.id : -1
+            kind: "hero"
+            url: gameData && gameData.backgroundArtUrl ? gameData.backgroundArtUrl : ""
+            fullResolution: detailView.visible
+            opacity: 0.45
+        }
+
+        Rectangle {
+            anchors.fill: parent
+            gradient: Gradient {
+                GradientStop { position: 0.0; color: "transparent" }
+                GradientStop { position: 1.0; color: ThemeManager.getColor("background") }
+            }
+        }
+    }
+
     ColumnLayout {
         anchors.fill: parent
         anchors.margins: 24
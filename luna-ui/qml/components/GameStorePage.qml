@@ -7,19 +7,21 @@ Item {
     id: storePage
 
     // ─── State ───
-    property var topDeals: []
     property var recentDeals: []
     property var searchResults: []
     property bool isSearching: false
-    property bool loadingTopDeals: true
+    // Deals live in DealsModel, which pages itself as the grid scrolls
+    readonly property bool loadingTopDeals: DealsModel.loading && DealsModel.count === 0
     property bool loadingRecentDeals: true
     property bool loadingSearch: false
     property string searchQuery: ""
-    property string currentSort: "Deal Rating"
-    property int currentPage: 0
+    readonly property string currentSort: DealsModel.sortBy
     property bool hasNetwork: GameManager.isNetworkAvailable()
-    property bool appendNextDeals: false  // true when "Load More" is pending
-    property string topDealsError: ""
+    // Last good deals are cached on disk, so the store can still be
+    // browsed without a connection
+    property bool hasOfflineData: false
+    readonly property bool showingSavedData: StoreApi.offline || (!hasNetwork && hasOfflineData)
+    readonly property string topDealsError: DealsModel.error
     property string recentDealsError: ""
 
     // ─── Embedded Store Browser ───
@@ -37,7 +39,7 @@ Item {
     ]
 
     // ─── Keyboard Navigation ───
-    // Zones: "searchBar", "sortChips", "hero", "trending", "dealsGrid", "loadMore"
+    // Zones: "searchBar", "sortChips", "hero", "trending", "dealsGrid"
     // Search mode zones: "searchBar", "backToStore", "searchResults"
     property string navZone: ""
     property int sortChipFocusIndex: 0
@@ -61,7 +63,7 @@ Item {
         if (isSearching) {
             navZone = "searchResults"
             searchResultFocusIndex = 0
-        } else if (topDeals.length > 0) {
+        } else if (DealsModel.count > 0) {
             navZone = "hero"
         } else {
             navZone = "searchBar"
@@ -88,19 +90,18 @@ Item {
             switch (navZone) {
             case "searchBar": navZone = "sortChips"; sortChipFocusIndex = 0; break
             case "sortChips":
-                if (topDeals.length > 0) { navZone = "hero"; heroDotFocusIndex = heroBanner.featuredIndex }
+                if (DealsModel.count > 0) { navZone = "hero"; heroDotFocusIndex = heroBanner.featuredIndex }
                 break
             case "hero":
                 if (recentDeals.length > 0) { navZone = "trending"; trendingFocusIndex = 0 }
-                else if (topDeals.length > 1) { navZone = "dealsGrid"; dealGridFocusIndex = 0 }
+                else if (DealsGridModel.count > 0) { navZone = "dealsGrid"; dealGridFocusIndex = 0 }
                 break
             case "trending":
-                if (topDeals.length > 1 || (currentSort !== "Deal Rating" && topDeals.length > 0)) {
+                if (DealsGridModel.count > 0) {
                     navZone = "dealsGrid"; dealGridFocusIndex = 0
                 }
                 break
-            case "dealsGrid": navZone = "loadMore"; break
-            case "loadMore": break // bottom
+            case "dealsGrid": break // bottom
             }
         }
     }
@@ -129,7 +130,6 @@ Item {
                 if (recentDeals.length > 0) navZone = "trending"
                 else navZone = "hero"
                 break
-            case "loadMore": navZone = "dealsGrid"; break
             }
         }
     }
@@ -160,7 +160,6 @@ Item {
         case "hero": handleHeroKeys(event); break
         case "trending": handleTrendingKeys(event); break
         case "dealsGrid": handleDealsGridKeys(event); break
-        case "loadMore": handleLoadMoreKeys(event); break
         case "backToStore": handleBackToStoreKeys(event); break
         case "searchResults": handleSearchResultsKeys(event); break
         }
@@ -204,24 +203,20 @@ Item {
         case Qt.Key_Down: nextZone(); event.accepted = true; break
         case Qt.Key_Return:
         case Qt.Key_Enter:
-            var opt = sortOptions[sortChipFocusIndex]
-            currentSort = opt.value
-            currentPage = 0
-            storePage.loadingTopDeals = true
-            StoreApi.fetchDeals(opt.value, 0, 30)
+            DealsModel.sortBy = sortOptions[sortChipFocusIndex].value
             event.accepted = true
             break
         }
     }
 
     function handleHeroKeys(event) {
-        var dotCount = Math.min(topDeals.length, 5)
+        var dotCount = Math.min(DealsModel.count, 5)
         switch (event.key) {
         case Qt.Key_Left:
             if (heroDotFocusIndex > 0) {
                 heroDotFocusIndex--
                 heroBanner.featuredIndex = heroDotFocusIndex
-                heroBanner.featuredDeal = topDeals[heroDotFocusIndex]
+                heroBanner.featuredDeal = DealsModel.get(heroDotFocusIndex)
                 heroRotateTimer.restart()
             } else {
                 requestNavFocus()
@@ -232,7 +227,7 @@ Item {
             if (heroDotFocusIndex < dotCount - 1) {
                 heroDotFocusIndex++
                 heroBanner.featuredIndex = heroDotFocusIndex
-                heroBanner.featuredDeal = topDeals[heroDotFocusIndex]
+                heroBanner.featuredDeal = DealsModel.get(heroDotFocusIndex)
                 heroRotateTimer.restart()
             }
             event.accepted = true
@@ -270,10 +265,8 @@ Item {
     }
 
     function handleDealsGridKeys(event) {
-        var gridDeals = (currentSort === "Deal Rating" && topDeals.length > 1) ? topDeals.slice(1) : topDeals
-        var cols = Math.max(1, Math.floor(mainFlickable.width / (Math.floor((mainFlickable.width - 48) / 3) + 16)))
-        if (cols < 1) cols = 3
-        var count = gridDeals.length
+        var cols = Math.max(1, Math.floor(dealsGrid.width / dealsGrid.cellWidth))
+        var count = DealsGridModel.count
         var idx = dealGridFocusIndex
 
         switch (event.key) {
@@ -298,22 +291,7 @@ Item {
             break
         case Qt.Key_Return:
         case Qt.Key_Enter:
-            if (idx >= 0 && idx < count) detailPopup.open(gridDeals[idx])
-            event.accepted = true
-            break
-        }
-    }
-
-    function handleLoadMoreKeys(event) {
-        switch (event.key) {
-        case Qt.Key_Up: prevZone(); event.accepted = true; break
-        case Qt.Key_Left: requestNavFocus(); event.accepted = true; break
-        case Qt.Key_Return:
-        case Qt.Key_Enter:
-            currentPage++
-            storePage.appendNextDeals = true
-            storePage.loadingTopDeals = true
-            StoreApi.fetchDeals(currentSort, currentPage, 30)
+            if (idx >= 0 && idx < count) detailPopup.open(DealsGridModel.get(idx))
             event.accepted = true
             break
         }
@@ -369,17 +347,9 @@ Item {
     onTrendingFocusIndexChanged: if (navZone === "trending") ensureTrendingVisible(trendingFocusIndex)
 
     function ensureDealVisible(idx) {
-        // Scroll mainFlickable so the focused deal card is visible
-        var cardW = Math.floor((mainFlickable.width - 48) / 3)
-        var cardH = cardW * 0.55
-        var cols = 3
-        var row = Math.floor(idx / cols)
-        // Approximate Y position of the deals grid within mainContent
-        var gridY = dealsGridSection.y + (row * (cardH + 16))
-        var viewTop = mainFlickable.contentY
-        var viewBottom = viewTop + mainFlickable.height
-        if (gridY < viewTop) mainFlickable.contentY = gridY - 20
-        else if (gridY + cardH > viewBottom) mainFlickable.contentY = gridY + cardH - mainFlickable.height + 20
+        // The grid scrolls itself; the page only has to show the grid
+        ensureZoneVisible()
+        dealsGrid.positionViewAtIndex(idx, GridView.Contain)
     }
 
     function ensureTrendingVisible(idx) {
@@ -410,11 +380,6 @@ Item {
             targetY = dealsGridSection.y
             targetH = Math.min(dealsGridSection.height, mainFlickable.height)
             break
-        case "loadMore":
-            // loadMore is at the bottom of dealsGridSection
-            targetY = dealsGridSection.y + dealsGridSection.height - 56
-            targetH = 56
-            break
         default:
             // searchBar, sortChips are above the Flickable; scroll to top
             mainFlickable.contentY = 0
@@ -444,9 +409,8 @@ Item {
             storePage.hasNetwork = GameManager.isNetworkAvailable()
             // Auto-load deals when coming back online
             if (wasOffline && storePage.hasNetwork) {
-                storePage.loadingTopDeals = true
                 storePage.loadingRecentDeals = true
-                StoreApi.fetchDeals(storePage.currentSort, 0, 30)
+                DealsModel.reload()
                 StoreApi.fetchRecentDeals(20)
             }
         }
@@ -454,8 +418,9 @@ Item {
 
     Component.onCompleted: {
         hasNetwork = GameManager.isNetworkAvailable()
-        if (hasNetwork) {
-            StoreApi.fetchDeals("Deal Rating", 0, 30)
+        hasOfflineData = !hasNetwork && StoreApi.hasOfflineDeals("Deal Rating", 30)
+        if (hasNetwork || hasOfflineData) {
+            DealsModel.reload()
             StoreApi.fetchRecentDeals(20)
         }
     }
@@ -464,26 +429,6 @@ Item {
     Connections {
         target: StoreApi
 
-        function onDealsReady(deals) {
-            if (storePage.isSearching) return
-            if (storePage.appendNextDeals) {
-                // "Load More" — append new deals to existing list
-                storePage.topDeals = storePage.topDeals.concat(deals)
-                storePage.appendNextDeals = false
-            } else {
-                storePage.topDeals = deals
-            }
-            storePage.topDealsError = ""
-            storePage.loadingTopDeals = false
-        }
-
-        function onDealsError(error) {
-            storePage.loadingTopDeals = false
-            storePage.appendNextDeals = false
-            storePage.topDealsError = error
-            console.warn("Failed to fetch deals:", error)
-        }
-
         function onRecentDealsReady(deals) {
             storePage.recentDeals = deals
             storePage.recentDealsError = ""
@@ -509,7 +454,7 @@ Item {
     ColumnLayout {
         anchors.centerIn: parent
         spacing: 24
-        visible: !storePage.hasNetwork
+        visible: !storePage.hasNetwork && !storePage.hasOfflineData
 
         Rectangle {
             Layout.alignment: Qt.AlignHCenter
@@ -581,7 +526,25 @@ Item {
     ColumnLayout {
         anchors.fill: parent
         spacing: 0
-        visible: storePage.hasNetwork
+        visible: storePage.hasNetwork || storePage.hasOfflineData
+
+        // ─── Offline banner ───
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 44
+            Layout.bottomMargin: 8
+            visible: storePage.showingSavedData
+            radius: 10
+            color: ThemeManager.getColor("surface")
+
+            Text {
+                anchors.centerIn: parent
+                text: "\u26A0  Offline \u2014 showing saved deals"
+                font.pixelSize: 20
+                font.family: ThemeManager.getFont("ui")
+                color: ThemeManager.getColor("textSecondary")
+            }
+        }
 
         // ─── Top bar: Search + Sort ───
         Rectangle {
@@ -630,6 +593,25 @@ Item {
                             clip: true
                             selectByMouse: true
 
+                            // Search as you type: owned titles show at once,
+                            // the network search waits for a pause
+                            onTextChanged: {
+                                var q = text.trim()
+                                if (q.length >= 2) {
+                                    storePage.searchQuery = q
+                                    storePage.isSearching = true
+                                    storePage.loadingSearch = true
+                                    StoreApi.searchGamesAsYouType(q)
+                                } else {
+                                    // Too short to search: drop the pending
+                                    // search for the longer text too
+                                    StoreApi.cancelSearch()
+                                    storePage.loadingSearch = false
+                                    if (q.length === 0 && storePage.isSearching)
+                                        clearSearch()
+                                }
+                            }
+
                             onAccepted: {
                                 if (text.trim().length > 0) {
                                     storePage.searchQuery = text.trim()
@@ -721,10 +703,7 @@ Item {
                                 hoverEnabled: true
                                 cursorShape: Qt.PointingHandCursor
                                 onClicked: {
-                                    currentSort = modelData.value
-                                    currentPage = 0
-                                    storePage.loadingTopDeals = true
-                                    StoreApi.fetchDeals(modelData.value, 0, 30)
+                                    DealsModel.sortBy = modelData.value
                                 }
                             }
                         }
@@ -933,6 +912,7 @@ Item {
                                 steamRatingText: modelData.genres || ""
                                 steamAppID: modelData.steamAppID || ""
                                 gameID: modelData.cheapSharkGameID || ""
+                                owned: modelData.owned || false
                                 isKeyboardFocused: hasKeyboardFocus && navZone === "searchResults" && searchResultFocusIndex === index
 
                                 onClicked: {
@@ -950,7 +930,7 @@ Item {
                 // ─── Hero Banner (Featured Deal) ───
                 Rectangle {
                     id: heroBanner
-                    visible: !storePage.isSearching && topDeals.length > 0
+                    visible: !storePage.isSearching && DealsModel.count > 0
                     Layout.fillWidth: true
                     Layout.preferredHeight: 420
                     radius: 20
@@ -961,18 +941,18 @@ Item {
                     border.width: (hasKeyboardFocus && navZone === "hero") ? 3 : 0
                     Behavior on border.color { ColorAnimation { duration: 150 } }
 
-                    property var featuredDeal: topDeals.length > 0 ? topDeals[0] : null
+                    property var featuredDeal: DealsModel.count > 0 ? DealsModel.get(0) : null
                     property int featuredIndex: 0
 
                     // Auto-rotate featured game
                     Timer {
                         id: heroRotateTimer
                         interval: 8000
-                        running: !storePage.isSearching && topDeals.length > 1 && storePage.visible
+                        running: !storePage.isSearching && DealsModel.count > 1 && storePage.visible
                         repeat: true
                         onTriggered: {
-                            heroBanner.featuredIndex = (heroBanner.featuredIndex + 1) % Math.min(topDeals.length, 5)
-                            heroBanner.featuredDeal = topDeals[heroBanner.featuredIndex]
+                            heroBanner.featuredIndex = (heroBanner.featuredIndex + 1) % Math.min(DealsModel.count, 5)
+                            heroBanner.featuredDeal = DealsModel.get(heroBanner.featuredIndex)
                         }
                     }
 
@@ -1134,10 +1114,10 @@ Item {
                         anchors.horizontalCenter: parent.horizontalCenter
                         anchors.bottomMargin: 16
                         spacing: 12
-                        visible: topDeals.length > 1
+                        visible: DealsModel.count > 1
 
                         Repeater {
-                            model: Math.min(topDeals.length, 5)
+                            model: Math.min(DealsModel.count, 5)
 
                             Rectangle {
                                 width: heroBanner.featuredIndex === index ? 36 : 16
@@ -1155,7 +1135,7 @@ Item {
                                     cursorShape: Qt.PointingHandCursor
                                     onClicked: {
                                         heroBanner.featuredIndex = index
-                                        heroBanner.featuredDeal = topDeals[index]
+                                        heroBanner.featuredDeal = DealsModel.get(index)
                                         heroRotateTimer.restart()
                                     }
                                 }
@@ -1250,7 +1230,7 @@ Item {
 
                 // ─── Error State (deals failed to load) ───
                 ColumnLayout {
-                    visible: !storePage.isSearching && !loadingTopDeals && topDeals.length === 0 && topDealsError !== ""
+                    visible: !storePage.isSearching && !loadingTopDeals && DealsModel.count === 0 && topDealsError !== ""
                     Layout.fillWidth: true
                     Layout.preferredHeight: 320
                     spacing: 16
@@ -1308,12 +1288,9 @@ Item {
                             hoverEnabled: true
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
-                                storePage.topDealsError = ""
                                 storePage.recentDealsError = ""
-                                storePage.loadingTopDeals = true
                                 storePage.loadingRecentDeals = true
-                                storePage.currentPage = 0
-                                StoreApi.fetchDeals(storePage.currentSort, 0, 30)
+                                DealsModel.reload()
                                 StoreApi.fetchRecentDeals(20)
                             }
                         }
@@ -1425,6 +1402,7 @@ Item {
                             gameID: modelData.gameID || ""
                             storeID: modelData.storeID || ""
                             dealRating: modelData.dealRating || ""
+                            owned: modelData.owned || false
                             isKeyboardFocused: hasKeyboardFocus && navZone === "trending" && trendingFocusIndex === index
 
                             onClicked: detailPopup.open(modelData)
@@ -1435,7 +1413,7 @@ Item {
                 // ─── Top Deals Grid ───
                 ColumnLayout {
                     id: dealsGridSection
-                    visible: !storePage.isSearching && topDeals.length > 0
+                    visible: !storePage.isSearching && DealsGridModel.count > 0
                     Layout.fillWidth: true
                     spacing: 16
 
@@ -1468,7 +1446,7 @@ Item {
                         }
 
                         Text {
-                            text: topDeals.length + " deals"
+                            text: DealsModel.count + " deals"
                             font.pixelSize: 24
                             font.family: ThemeManager.getFont("body")
                             color: ThemeManager.getColor("textSecondary")
@@ -1477,84 +1455,39 @@ Item {
                         Item { Layout.fillWidth: true }
                     }
 
-                    // Grid of deal cards
-                    Flow {
+                    // Grid of deal cards.  Its own viewport, so only the
+                    // visible cards (plus the cache buffer) exist; DealsModel
+                    // pages in more as it nears the end.  DealsGridModel
+                    // leaves out the deal the hero banner features.
+                    GridView {
+                        id: dealsGrid
                         Layout.fillWidth: true
-                        spacing: 16
-
-                        Repeater {
-                            // Skip first deal (shown in hero) for "Deal Rating" sort
-                            model: {
-                                if (currentSort === "Deal Rating" && topDeals.length > 1)
-                                    return topDeals.slice(1)
-                                return topDeals
-                            }
-
-                            StoreGameCard {
-                                width: Math.floor((mainFlickable.width - 48) / 3)
-                                height: width * 0.55
-                                gameTitle: modelData.title || ""
-                                headerImage: modelData.headerImage || modelData.thumb || ""
-                                salePrice: modelData.salePrice || ""
-                                normalPrice: modelData.normalPrice || ""
-                                savings: modelData.savings || ""
-                                metacriticScore: modelData.metacriticScore || ""
-                                steamRatingText: modelData.steamRatingText || ""
-                                steamAppID: modelData.steamAppID || ""
-                                gameID: modelData.gameID || ""
-                                storeID: modelData.storeID || ""
-                                dealRating: modelData.dealRating || ""
-                                isKeyboardFocused: hasKeyboardFocus && navZone === "dealsGrid" && dealGridFocusIndex === index
-
-                                onClicked: detailPopup.open(modelData)
-                            }
-                        }
-                    }
-
-                    // Load more button
-                    Rectangle {
-                        property bool isKbFocused: hasKeyboardFocus && navZone === "loadMore"
-                        Layout.alignment: Qt.AlignHCenter
-                        Layout.preferredWidth: loadMoreLabel.width + 56
-                        Layout.preferredHeight: 56
-                        Layout.topMargin: 12
-                        radius: 12
-                        color: (loadMoreArea.containsMouse || isKbFocused)
-                               ? ThemeManager.getColor("primary")
-                               : ThemeManager.getColor("surface")
-                        border.color: (loadMoreArea.containsMouse || isKbFocused)
-                                      ? ThemeManager.getColor("focus")
-                                      : Qt.rgba(ThemeManager.getColor("primary").r,
-                                                ThemeManager.getColor("primary").g,
-                                                ThemeManager.getColor("primary").b, 0.4)
-                        border.width: (loadMoreArea.containsMouse || isKbFocused) ? 3 : 2
-
-                        Behavior on color { ColorAnimation { duration: 200 } }
-                        Behavior on border.color { ColorAnimation { duration: 150 } }
-
-                        Text {
-                            id: loadMoreLabel
-                            anchors.centerIn: parent
-                            text: "Load More Deals"
-                            font.pixelSize: 24
-                            font.family: ThemeManager.getFont("ui")
-                            font.bold: true
-                            color: (loadMoreArea.containsMouse || parent.isKbFocused)
-                                   ? "#ffffff"
-                                   : ThemeManager.getColor("textPrimary")
-                        }
+                        Layout.preferredHeight: Math.min(contentHeight, mainFlickable.height - 60)
+                        cellWidth: Math.floor(width / 3)
+                        cellHeight: Math.floor((cellWidth - 16) * 0.55) + 16
+                        cacheBuffer: cellHeight * 2
+                        clip: true
+                        boundsBehavior: Flickable.StopAtBounds
+                        model: DealsGridModel
 
-                        MouseArea {
-                            id: loadMoreArea
-                            anchors.fill: parent
-                            hoverEnabled: true
-                            cursorShape: Qt.PointingHandCursor
-                            onClicked: {
-                                currentPage++
-                                storePage.appendNextDeals = true
-                                storePage.loadingTopDeals = true
-                                StoreApi.fetchDeals(currentSort, currentPage, 30)
-                            }
+                        delegate: StoreGameCard {
+                            width: dealsGrid.cellWidth - 16
+                            height: width * 0.55
+                            gameTitle: model.title || ""
+                            headerImage: model.headerImage || model.thumb || ""
+                            salePrice: model.salePrice || ""
+                            normalPrice: model.normalPrice || ""
+                            savings: model.savings || ""
+                            metacriticScore: model.metacriticScore || ""
+                            steamRatingText: model.steamRatingText || ""
+                            steamAppID: model.steamAppID || ""
+                            gameID: model.gameID || ""
+                            storeID: model.storeID || ""
+                            dealRating: model.dealRating || ""
+                            owned: model.owned || false
+                            isKeyboardFocused: hasKeyboardFocus && navZone === "dealsGrid" && dealGridFocusIndex === index
+
+                            onClicked: if (model.loaded) detailPopup.open(model.deal)
                         }
                     }
                 }
@@ -2210,6 +2143,7 @@ Item {
 
     // ─── Helper Functions ───
     function clearSearch() {
+        StoreApi.cancelSearch()
         searchInput.text = ""
         storePage.searchQuery = ""
         storePage.isSearching = false
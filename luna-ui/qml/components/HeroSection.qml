@@ -9,13 +9,39 @@ Rectangle {
     property string gameTitle: ""
     property string backgroundArt: ""
     property int gameId: -1
+    property string dominantColor: ""
+    property string placeholderPreview: ""
+    property string logoUrl: ""
+    // Only the focused game decodes the full-size hero; the owner sets it
+    property bool fullResolution: false
 
     signal playClicked(int id)
 
-    Image {
+    // Placeholder painted immediately from the game row — no image I/O
+    Rectangle {
         anchors.fill: parent
-        source: backgroundArt || ""
-        fillMode: Image.PreserveAspectCrop
+        color: dominantColor.length > 0 ? dominantColor : "transparent"
+        opacity: 0.6
+
+        Image {
+            anchors.fill: parent
+            visible: placeholderPreview.length > 0
+            source: placeholderPreview.length > 0
+                    ? "image://artwork/preview/" + placeholderPreview : ""
+            sourceSize: Qt.size(32, 48)
+            fillMode: Image.PreserveAspectCrop
+            smooth: true
+            cache: false
+        }
+    }
+
+    // Cross-fades in over the placeholder, low-res first
+    ArtworkBackdrop {
+        anchors.fill: parent
+        gameId: heroSection.gameId
+        kind: "hero"
+        url: backgroundArt
+        fullResolution: heroSection.fullResolution
         opacity: 0.6
     }
 
@@ -33,7 +59,21 @@ Rectangle {
         anchors.margins: 32
         spacing: 12
 
+        // Title logo when the store has one, plain title otherwise
+        ArtworkBackdrop {
+            id: logo
+            width: 360
+            height: 100
+            gameId: heroSection.gameId
+            kind: "logo"
+            url: logoUrl
+            previewWidth: 360
+            fillMode: Image.PreserveAspectFit
+            visible: ready
+        }
+
         Text {
+            visible: !logo.ready
             text: gameTitle
             font.pixelSize: ThemeManager.getFontSize("xlarge")
             font.family: ThemeManager.getFont("heading")
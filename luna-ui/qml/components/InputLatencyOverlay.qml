@@ -0,0 +1,53 @@
+import QtQuick
+import QtQuick.Layouts
+
+// Controller input latency percentiles (LUNA_INPUT_LATENCY=1)
+Rectangle {
+    id: overlay
+    visible: InputLatency.enabled
+    width: latencyCol.width + 24
+    height: latencyCol.height + 16
+    radius: 12
+    color: Qt.rgba(0, 0, 0, 0.85)
+
+    property var rows: []
+
+    Timer {
+        interval: 500
+        repeat: true
+        running: overlay.visible
+        triggeredOnStart: true
+        onTriggered: overlay.rows = InputLatency.summary()
+    }
+
+    ColumnLayout {
+        id: latencyCol
+        anchors.centerIn: parent
+        spacing: 4
+
+        Text {
+            text: "Input Latency (ms)   p50    p95    p99    max"
+            font.pixelSize: 14
+            font.family: "monospace"
+            font.bold: true
+            color: "#e67e22"
+        }
+
+        Repeater {
+            model: overlay.rows
+            Text {
+                function pad(value) {
+                    var s = value.toFixed(2)
+                    return "       ".substring(s.length) + s
+                }
+                text: (modelData.stage + "          ").substring(0, 10)
+                      + ("n=" + modelData.count + "        ").substring(0, 9)
+                      + pad(modelData.p50) + pad(modelData.p95)
+                      + pad(modelData.p99) + pad(modelData.max)
+                font.pixelSize: 13
+                font.family: "monospace"
+                color: modelData.p95 > 16.7 ? "#e74c3c" : "#2ecc71"
+            }
+        }
+    }
+}
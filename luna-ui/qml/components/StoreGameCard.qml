@@ -21,6 +21,7 @@ Rectangle {
     property string gameID: ""
     property string storeID: ""
     property string dealRating: ""
+    property bool owned: false               // already in the library (any store)
     property bool isKeyboardFocused: false  // Set by parent when selected via keyboard
 
     signal clicked()
@@ -102,13 +103,37 @@ Rectangle {
         }
     }
 
-    // Metacritic badge (top-left)
+    // Owned badge (top-left)
     Rectangle {
-        visible: metacriticScore !== "" && metacriticScore !== "0"
+        id: ownedBadge
+        visible: owned
         anchors.top: parent.top
         anchors.left: parent.left
         anchors.topMargin: 12
         anchors.leftMargin: 12
+        width: ownedText.width + 24
+        height: 44
+        radius: 10
+        color: ThemeManager.getColor("primary")
+
+        Text {
+            id: ownedText
+            anchors.centerIn: parent
+            text: "Owned"
+            font.pixelSize: 20
+            font.family: ThemeManager.getFont("ui")
+            font.bold: true
+            color: "#ffffff"
+        }
+    }
+
+    // Metacritic badge (top-left, below the owned badge)
+    Rectangle {
+        visible: metacriticScore !== "" && metacriticScore !== "0"
+        anchors.top: ownedBadge.visible ? ownedBadge.bottom : parent.top
+        anchors.left: parent.left
+        anchors.topMargin: 12
+        anchors.leftMargin: 12
         width: 56
         height: 56
         radius: 10
@@ -25,6 +25,10 @@ Rectangle {
     // Credential dialog controller focus: 0 = input, 1 = submit, 2 = cancel
     property int credDialogFocusIndex: 0
 
+    // gamesModel row lookup for background patches, rebuilt by refreshGames()
+    property var gameRowById: ({})
+    property var gameRowBySteamAppId: ({})
+
     function gainFocus() {
         focusState = "tabs"
         focusedTabIndex = activeTab
@@ -270,7 +274,46 @@ Rectangle {
             }
             event.accepted = true
             break
+        case Qt.Key_F7:
+            // jump_previous (right stick left)
+            jumpByLetter(-1)
+            event.accepted = true
+            break
+        case Qt.Key_F8:
+            // jump_next (right stick right)
+            jumpByLetter(1)
+            event.accepted = true
+            break
+        }
+    }
+
+    // Move to the first game of the next / previous initial letter.  The
+    // list is installed-first, so each run of one letter counts as a group.
+    function jumpByLetter(direction) {
+        var count = gamesModel.count
+        if (count === 0) return
+        var idx = Math.max(0, gameGrid.currentIndex)
+
+        function initialAt(i) {
+            var c = (gamesModel.get(i).title || "").charAt(0).toUpperCase()
+            return (c >= "A" && c <= "Z") ? c : "#"
+        }
+
+        var target = idx
+        var letter = initialAt(idx)
+        if (direction > 0) {
+            while (target < count - 1 && initialAt(target) === letter) target++
+        } else {
+            // Start of this group, or of the previous one when already there
+            while (target > 0 && initialAt(target - 1) === letter) target--
+            if (target === idx && target > 0) {
+                target--
+                letter = initialAt(target)
+                while (target > 0 && initialAt(target - 1) === letter) target--
+            }
         }
+        gameGrid.currentIndex = target
+        gameGrid.positionViewAtIndex(target, GridView.Contain)
     }
 
     function handleClientsKeys(event) {
@@ -451,6 +494,39 @@ Rectangle {
             Item {
                 id: myGamesTab
 
+                // Focused game's hero art behind the grid.  The low-res
+                // decode follows focus straight away; the full-size one
+                // waits until focus has stayed on a game for a moment, so
+                // scrolling through the grid never decodes full heroes.
+                property var focusedGame: gameGrid.currentIndex >= 0 && gameGrid.currentIndex < gamesModel.count
+                                          ? gamesModel.get(gameGrid.currentIndex) : null
+
+                Timer {
+                    id: focusSettleTimer
+                    property bool settled: false
+                    interval: 400
+                    onTriggered: settled = true
+                }
+
+                Connections {
+                    target: gameGrid
+                    function onCurrentIndexChanged() {
+                        focusSettleTimer.settled = false
+                        focusSettleTimer.restart()
+                    }
+                }
+
+                ArtworkBackdrop {
+                    anchors.fill: parent
+                    visible: gameGrid.count > 0 && gameId > 0
+                    gameId: myGamesTab.focusedGame ? myGamesTab.focusedGame.id : -1
+                    kind: "hero"
+                    url: myGamesTab.focusedGame && myGamesTab.focusedGame.backgroundArtUrl
+                         ? myGamesTab.focusedGame.backgroundArtUrl : ""
+                    fullResolution: focusSettleTimer.settled
+                    opacity: 0.2
+                }
+
                 // Empty state
                 ColumnLayout {
                     anchors.centerIn: parent
@@ -518,6 +594,9 @@ Rectangle {
                         appId: model.appId || ""
                         downloadProgress: model.downloadProgress !== undefined ? model.downloadProgress : -1.0
                         installError: model.installError !== undefined ? model.installError : ""
+                        dominantColor: model.dominantColor || ""
+                        placeholderPreview: model.placeholderPreview || ""
+                        protonTier: model.protonTier || ""
 
                         // Keyboard focus: this card is focused when it's the grid's current item and we're in content mode
                         isKeyboardFocused: gameGrid.currentIndex === index && focusState === "content" && activeTab === 0
@@ -2352,6 +2431,30 @@ Rectangle {
         }
     }
 
+    // Background ProtonDB prefetch: patch the affected card in place
+    Connections {
+        target: StoreApi
+        function onProtonRatingReady(appId, rating) {
+            var row = gameRowBySteamAppId[appId]
+            if (row !== undefined)
+                gamesModel.setProperty(row, "protonTier", rating.tier || "")
+        }
+    }
+
+    // Cover placeholders are computed after the first decode and stored
+    // in the DB; patch rows already in the model so their cards pick the
+    // placeholder up without waiting for the next full reload
+    Connections {
+        target: ArtworkManager
+        function onPlaceholderReady(gameId, dominantColor, preview) {
+            var row = gameRowById[gameId]
+            if (row !== undefined) {
+                gamesModel.setProperty(row, "dominantColor", dominantColor)
+                gamesModel.setProperty(row, "placeholderPreview", preview)
+            }
+        }
+    }
+
     Connections {
         target: GameManager
         function onGamesUpdated() { refreshGames() }
@@ -2445,12 +2548,19 @@ Rectangle {
     function refreshGames() {
         gamesModel.clear()
         var games = GameManager.getGames()
+        var byId = {}
+        var bySteamAppId = {}
         for (var i = 0; i < games.length; i++) {
             games[i].downloadProgress = GameManager.isDownloading(games[i].appId)
                 ? GameManager.getDownloadProgress(games[i].appId)
                 : -1.0
             games[i].installError = ""
             gamesModel.append(games[i])
+            byId[games[i].id] = i
+            if (games[i].storeSource === "steam" && !(games[i].appId in bySteamAppId))
+                bySteamAppId[games[i].appId] = i
         }
+        gameRowById = byId
+        gameRowBySteamAppId = bySteamAppId
     }
 }
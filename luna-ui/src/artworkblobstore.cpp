@@ -0,0 +1,235 @@
+#include "artworkblobstore.h"
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+static const char BLOB_MAGIC[8] = {'L', 'U', 'N', 'A', 'B', 'L', 'O', 'B'};
+
+// mmap offsets must be page-aligned; 4 KiB covers every target we ship on
+static qint64 pageAlign(qint64 n) {
+    const qint64 page = 4096;
+    return (n + page - 1) / page * page;
+}
+
+ArtworkBlobStore::ArtworkBlobStore(const QString& filePath)
+    : m_path(filePath)
+{
+    m_indexBytes = pageAlign(sizeof(Header) + qint64(sizeof(IndexEntry)) * IndexCapacity);
+    m_slotBytes = pageAlign(qint64(CardWidth) * CardHeight * 4);
+}
+
+ArtworkBlobStore::~ArtworkBlobStore() {
+    // Closing the file releases every mapping
+    m_file.close();
+}
+
+bool ArtworkBlobStore::open() {
+    QMutexLocker lock(&m_mutex);
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "ArtworkBlobStore: cannot open" << m_path << m_file.errorString();
+        return false;
+    }
+
+    // Validate an existing file; anything unexpected starts over
+    bool fresh = m_file.size() < m_indexBytes;
+    if (!fresh) {
+        Header h;
+        m_file.seek(0);
+        if (m_file.read(reinterpret_cast<char*>(&h), sizeof(h)) != qint64(sizeof(h))
+            || std::memcmp(h.magic, BLOB_MAGIC, sizeof(BLOB_MAGIC)) != 0
+            || h.version != Version
+            || h.slotWidth != quint32(CardWidth)
+            || h.slotHeight != quint32(CardHeight)
+            || h.indexCapacity != quint32(IndexCapacity)
+            || h.slotCount > quint32(IndexCapacity)) {
+            fresh = true;
+        } else {
+            qint64 chunks = (h.slotCount + SlotsPerChunk - 1) / SlotsPerChunk;
+            if (m_file.size() < m_indexBytes + chunks * SlotsPerChunk * m_slotBytes)
+                fresh = true;
+        }
+    }
+
+    if (!initialize(fresh)) {
+        m_file.close();
+        m_header = nullptr;
+        m_index = nullptr;
+        m_chunks.clear();
+        m_slots.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ArtworkBlobStore::initialize(bool fresh) {
+    if (fresh) {
+        // resize() zero-fills, so the new index starts out empty and the
+        // slot area stays sparse until pixels are written.
+        if (!m_file.resize(0) || !m_file.resize(m_indexBytes))
+            return false;
+    }
+
+    uchar *base = m_file.map(0, m_indexBytes);
+    if (!base) return false;
+    m_header = reinterpret_cast<Header*>(base);
+    m_index = reinterpret_cast<IndexEntry*>(base + sizeof(Header));
+
+    if (fresh) {
+        std::memcpy(m_header->magic, BLOB_MAGIC, sizeof(BLOB_MAGIC));
+        m_header->version = Version;
+        m_header->slotWidth = CardWidth;
+        m_header->slotHeight = CardHeight;
+        m_header->indexCapacity = IndexCapacity;
+        m_header->slotCount = 0;
+    }
+
+    int chunks = (int(m_header->slotCount) + SlotsPerChunk - 1) / SlotsPerChunk;
+    for (int c = 0; c < chunks; ++c) {
+        if (!mapChunk(c)) return false;
+    }
+
+    for (int slot = 0; slot < int(m_header->slotCount); ++slot) {
+        const int gameId = m_index[slot].gameId;
+        if (gameId == 0) {
+            m_freeSlots.append(slot);
+            continue;
+        }
+        // A crash between publishing a replacement and retiring the old
+        // slot leaves two entries; keep the one from the newer source
+        auto it = m_slots.find(gameId);
+        if (it == m_slots.end()) {
+            m_slots.insert(gameId, slot);
+            continue;
+        }
+        int stale = slot;
+        if (m_index[slot].sourceMtime > m_index[it.value()].sourceMtime) {
+            stale = it.value();
+            it.value() = slot;
+        }
+        m_index[stale].gameId = 0;
+        m_freeSlots.append(stale);
+    }
+    return true;
+}
+
+bool ArtworkBlobStore::mapChunk(int chunk) {
+    qint64 chunkBytes = qint64(SlotsPerChunk) * m_slotBytes;
+    qint64 offset = m_indexBytes + chunk * chunkBytes;
+    if (m_file.size() < offset + chunkBytes && !m_file.resize(offset + chunkBytes))
+        return false;
+
+    uchar *data = m_file.map(offset, chunkBytes);
+    if (!data) return false;
+    m_chunks.append(data);
+    return true;
+}
+
+uchar *ArtworkBlobStore::slotData(int slot) const {
+    return m_chunks[slot / SlotsPerChunk] + qint64(slot % SlotsPerChunk) * m_slotBytes;
+}
+
+int ArtworkBlobStore::allocateSlot() {
+    // Retired slots nobody is looking at any more come back first
+    if (!m_retiredSlots.isEmpty()) {
+        QMutexLocker pinLock(&m_pins->mutex);
+        for (int i = m_retiredSlots.size() - 1; i >= 0; --i) {
+            if (!m_pins->count.contains(m_retiredSlots[i])) {
+                m_freeSlots.append(m_retiredSlots[i]);
+                m_retiredSlots.remove(i);
+            }
+        }
+    }
+    if (!m_freeSlots.isEmpty())
+        return m_freeSlots.takeLast();
+
+    int slot = int(m_header->slotCount);
+    if (slot >= IndexCapacity) return -1;
+    if (slot / SlotsPerChunk >= m_chunks.size() && !mapChunk(slot / SlotsPerChunk))
+        return -1;
+    m_header->slotCount++;
+    return slot;
+}
+
+bool ArtworkBlobStore::contains(int gameId) const {
+    QMutexLocker lock(&m_mutex);
+    return m_slots.contains(gameId);
+}
+
+qint64 ArtworkBlobStore::sourceMtime(int gameId) const {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_slots.constFind(gameId);
+    if (it == m_slots.constEnd()) return 0;
+    return m_index[it.value()].sourceMtime;
+}
+
+QImage ArtworkBlobStore::image(int gameId) const {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_slots.constFind(gameId);
+    if (it == m_slots.constEnd()) return QImage();
+
+    const IndexEntry& e = m_index[it.value()];
+    if (e.width == 0 || e.height == 0) return QImage();
+
+    // The const-data constructor wraps the mapping read-only: painting
+    // never copies, and any accidental write detaches instead of
+    // scribbling over the file.  The slot stays pinned until the last
+    // copy of the image is gone, so insert() never writes under it.
+    const int slot = it.value();
+    {
+        QMutexLocker pinLock(&m_pins->mutex);
+        m_pins->count[slot]++;
+    }
+    auto *pin = new std::pair<std::shared_ptr<Pins>, int>(m_pins, slot);
+    return QImage(slotData(slot), e.width, e.height, CardWidth * 4,
+                  QImage::Format_ARGB32_Premultiplied, &ArtworkBlobStore::unpin, pin);
+}
+
+void ArtworkBlobStore::unpin(void *info) {
+    auto *pin = static_cast<std::pair<std::shared_ptr<Pins>, int>*>(info);
+    {
+        QMutexLocker pinLock(&pin->first->mutex);
+        auto it = pin->first->count.find(pin->second);
+        if (it != pin->first->count.end() && --it.value() == 0)
+            pin->first->count.erase(it);
+    }
+    delete pin;
+}
+
+bool ArtworkBlobStore::insert(int gameId, const QImage& decoded, qint64 sourceMtime) {
+    if (gameId <= 0 || decoded.isNull()) return false;
+
+    // Scale and convert outside the lock
+    QImage img = decoded;
+    if (img.width() > CardWidth || img.height() > CardHeight)
+        img = img.scaled(CardWidth, CardHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    img = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    QMutexLocker lock(&m_mutex);
+    if (!m_header) return false;
+
+    // Always a fresh slot: the current one may be on screen right now
+    const int oldSlot = m_slots.value(gameId, -1);
+    const int slot = allocateSlot();
+    if (slot < 0) return false;
+
+    uchar *dst = slotData(slot);
+    const qsizetype rowBytes = qsizetype(img.width()) * 4;
+    for (int y = 0; y < img.height(); ++y)
+        std::memcpy(dst + qsizetype(y) * CardWidth * 4, img.constScanLine(y), rowBytes);
+
+    // Publish the new entry last so a crash mid-copy leaves the slot
+    // unused, then retire the old one
+    IndexEntry& e = m_index[slot];
+    e.width = quint16(img.width());
+    e.height = quint16(img.height());
+    e.sourceMtime = sourceMtime;
+    e.gameId = gameId;
+    m_slots.insert(gameId, slot);
+
+    if (oldSlot >= 0) {
+        m_index[oldSlot].gameId = 0;
+        m_retiredSlots.append(oldSlot);
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef ARTWORKBLOBSTORE_H
+#define ARTWORKBLOBSTORE_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+// Pre-decoded artwork store — a single memory-mapped file holding
+// card-size premultiplied ARGB32 pixels for every cover plus an offset
+// index.  image() returns a QImage that wraps the mapped pages directly,
+// so the grid paints on the first frame without decoding a single JPEG.
+//
+// File layout (all fields native-endian, the file never leaves the box):
+//
+//   [Header][IndexEntry × IndexCapacity]   ← mapped once, page-aligned
+//   [slot 0][slot 1]...                    ← mapped in chunks of SlotsPerChunk
+//
+// Pixels handed out by image() are never written again while a view of
+// them exists: re-inserting a game fills a fresh slot and then switches
+// the index entry over.  The old slot is retired and only reused once
+// the last image over it has been released.  Growing the file maps an
+// additional chunk and never unmaps earlier ones.
+
+class ArtworkBlobStore {
+public:
+    // GameCard's cover area (180×270 card minus 4px margins)
+    static constexpr int CardWidth = 172;
+    static constexpr int CardHeight = 262;
+
+    explicit ArtworkBlobStore(const QString& filePath);
+    ~ArtworkBlobStore();
+
+    bool open();
+    bool isOpen() const { return m_header != nullptr; }
+
+    bool contains(int gameId) const;
+    // mtime of the source file the entry was decoded from (0 if absent)
+    qint64 sourceMtime(int gameId) const;
+    // Zero-copy view of the decoded pixels; null if the game has no entry
+    QImage image(int gameId) const;
+    // Store an already-decoded image (scaled to fit the card if larger).
+    // Thread-safe; called from the thumbnail worker pool.
+    bool insert(int gameId, const QImage& decoded, qint64 sourceMtime);
+
+private:
+    struct Header {
+        char magic[8];
+        quint32 version;
+        quint32 slotWidth;
+        quint32 slotHeight;
+        quint32 indexCapacity;
+        quint32 slotCount;       // slots allocated in the file
+        quint32 reserved[3];
+    };
+
+    struct IndexEntry {
+        qint32 gameId;           // 0 = unused
+        quint16 width;
+        quint16 height;
+        qint64 sourceMtime;
+    };
+
+    static constexpr quint32 Version = 1;
+    static constexpr int IndexCapacity = 16384;
+    static constexpr int SlotsPerChunk = 128;
+
+    QString m_path;
+    QFile m_file;
+    mutable QMutex m_mutex;
+
+    Header *m_header = nullptr;
+    IndexEntry *m_index = nullptr;
+    QVector<uchar*> m_chunks;     // mapped slot chunks
+    QHash<int, int> m_slots;      // gameId → slot
+    QVector<int> m_freeSlots;     // unused slots below slotCount
+    QVector<int> m_retiredSlots;  // replaced, free once unpinned
+
+    // Live image() views per slot.  Shared with the images' cleanup
+    // function, which may run on the render thread and after the store
+    // is gone.
+    struct Pins {
+        QMutex mutex;
+        QHash<int, int> count;    // slot → live views
+    };
+    std::shared_ptr<Pins> m_pins = std::make_shared<Pins>();
+    static void unpin(void *info);
+    qint64 m_indexBytes = 0;      // header + index, page-aligned
+    qint64 m_slotBytes = 0;       // one slot, page-aligned
+
+    bool initialize(bool fresh);
+    bool mapChunk(int chunk);
+    uchar *slotData(int slot) const;
+    int allocateSlot();
+};
+
+#endif
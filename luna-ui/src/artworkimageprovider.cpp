@@ -0,0 +1,44 @@
+#include "artworkimageprovider.h"
+#include "artworkblobstore.h"
+#include <cstring>
+
+ArtworkImageProvider::ArtworkImageProvider(ArtworkBlobStore *store)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_store(store)
+{
+}
+
+QImage ArtworkImageProvider::requestImage(const QString& id, QSize *size, const QSize& requestedSize) {
+    QImage img;
+    if (id.startsWith("preview/")) {
+        img = decodePreview(id.mid(8), requestedSize);
+    } else if (m_store && id.startsWith("cover/")) {
+        // Entries are already card-sized; requestedSize is ignored.  The
+        // trailing revision only exists to defeat the pixmap cache.
+        bool ok = false;
+        int gameId = id.mid(6).section('/', 0, 0).toInt(&ok);
+        if (ok) img = m_store->image(gameId);
+    }
+
+    if (size) *size = img.size();
+    return img;
+}
+
+QImage ArtworkImageProvider::decodePreview(const QString& encoded, const QSize& requestedSize) {
+    QByteArray bytes = QByteArray::fromBase64(encoded.toLatin1(), QByteArray::Base64UrlEncoding);
+    if (bytes.size() < 2) return QImage();
+
+    int w = quint8(bytes[0]);
+    int h = quint8(bytes[1]);
+    if (w == 0 || h == 0 || bytes.size() != 2 + w * h * 3) return QImage();
+
+    QImage img(w, h, QImage::Format_RGB888);
+    for (int y = 0; y < h; ++y)
+        std::memcpy(img.scanLine(y), bytes.constData() + 2 + y * w * 3, w * 3);
+
+    // Upscale here so the blur is baked in rather than left to the
+    // scene graph's texture filtering.
+    if (requestedSize.isValid())
+        img = img.scaled(requestedSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    return img;
+}
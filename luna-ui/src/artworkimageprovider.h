@@ -0,0 +1,27 @@
+#ifndef ARTWORKIMAGEPROVIDER_H
+#define ARTWORKIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+class ArtworkBlobStore;
+
+// Serves "image://artwork/cover/<gameId>/<revision>" straight out of the
+// memory-mapped decoded store.  Requests are answered synchronously on
+// the GUI thread — there is nothing to decode, only a QImage header to
+// build around the mapping.
+//
+// "image://artwork/preview/<base64url>" expands a cover placeholder
+// (see ArtworkManager::lowResPreview) from the id alone, no I/O.
+class ArtworkImageProvider : public QQuickImageProvider {
+public:
+    explicit ArtworkImageProvider(ArtworkBlobStore *store);
+
+    QImage requestImage(const QString& id, QSize *size, const QSize& requestedSize) override;
+
+private:
+    ArtworkBlobStore *m_store;
+
+    static QImage decodePreview(const QString& encoded, const QSize& requestedSize);
+};
+
+#endif
@@ -1,141 +1,629 @@
 #include "artworkmanager.h"
+#include "artworkblobstore.h"
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QColor>
+#include <vector>
+#include <QSaveFile>
 #include <QDebug>
 #include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 
+// Background prefetch tuning
+static const int PREFETCH_CONCURRENCY = 4;
+static const qint64 REVALIDATE_AFTER_SECS = 7 * 24 * 3600;   // conditional GET once a week
+static const int REVALIDATE_INTERVAL_MS = 6 * 3600 * 1000;    // re-check the schedule every 6h
+
+// Placeholder preview size (2:3 like the cards)
+static const int PREVIEW_WIDTH = 4;
+static const int PREVIEW_HEIGHT = 6;
+
 ArtworkManager::ArtworkManager(QObject *parent) : QObject(parent) {
     m_cache.setMaxCost(200);
     m_nam = new QNetworkAccessManager(this);
 
-    QString logDir = QDir::homePath() + "/.local/share/luna-ui";
-    QDir().mkpath(logDir);
-    m_logFile.setFileName(logDir + "/artwork-debug.log");
-    m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    m_logCategory = Logger::instance().registerCategory(
+        "artwork", QDir::homePath() + "/.local/share/luna-ui/artwork-debug.log");
     log("=== ArtworkManager started ===");
+
+    loadValidators();
+
+    // Validators are written in batches — a prefetch pass can touch
+    // hundreds of entries within a few seconds.
+    m_saveValidatorsTimer.setSingleShot(true);
+    m_saveValidatorsTimer.setInterval(2000);
+    connect(&m_saveValidatorsTimer, &QTimer::timeout, this, &ArtworkManager::saveValidators);
+
+    // Periodically re-run the revalidation schedule over the last known
+    // library so a long-running session still picks up refreshed art.
+    m_revalidateTimer.setInterval(REVALIDATE_INTERVAL_MS);
+    connect(&m_revalidateTimer, &QTimer::timeout, this, &ArtworkManager::queueLibraryJobs);
+
+    // Pre-decoded cover store.  Optional: LUNA_NO_DECODED_ARTWORK=1 turns
+    // it off and cards fall back to decoding the cached JPEGs.
+    if (qEnvironmentVariableIsEmpty("LUNA_NO_DECODED_ARTWORK")) {
+        QString path = QDir::homePath() + "/.local/share/luna-ui/artwork-cache/covers-decoded.blob";
+        m_blobStore = std::make_unique<ArtworkBlobStore>(path);
+        if (m_blobStore->open()) {
+            log("decoded store: opened " + path);
+        } else {
+            log("decoded store: FAILED to open " + path + " — disabled", LogLevel::Warning);
+            m_blobStore.reset();
+        }
+    }
+    // JPEG decoding is CPU-bound; keep it off the cores the UI and a
+    // freshly launched game want.
+    m_thumbnailPool.setMaxThreadCount(2);
+}
+
+ArtworkManager::~ArtworkManager() {
+    // Workers write into the store; let them finish before it is unmapped
+    m_thumbnailPool.clear();
+    m_thumbnailPool.waitForDone();
+}
+
+void ArtworkManager::log(const QString& msg, LogLevel level) {
+    Logger::instance().write(m_logCategory, level, msg);
+}
+
+// ─── Asset kinds ───
+// Each kind has its own cache directory and file suffix.  Covers keep
+// their historical covers/<id>-cover.jpg layout.
+
+struct AssetKindInfo {
+    const char *name;     // QML-facing name
+    const char *dir;      // artwork-cache/<dir>
+    const char *suffix;   // <id>-<suffix>.<ext>
+    const char *ext;
+};
+
+static const AssetKindInfo ASSET_KINDS[] = {
+    {"cover", "covers", "cover", "jpg"},
+    {"hero",  "heroes", "hero",  "jpg"},
+    {"logo",  "logos",  "logo",  "png"},
+    {"icon",  "icons",  "icon",  "jpg"},
+};
+
+QString ArtworkManager::kindName(AssetKind kind) {
+    return QString::fromLatin1(ASSET_KINDS[kind].name);
+}
+
+bool ArtworkManager::kindFromName(const QString& name, AssetKind *kind) {
+    for (int k = 0; k < AssetKindCount; ++k) {
+        if (name == QLatin1String(ASSET_KINDS[k].name)) {
+            *kind = AssetKind(k);
+            return true;
+        }
+    }
+    return false;
 }
 
-void ArtworkManager::log(const QString& msg) {
-    if (!m_logFile.isOpen()) return;
-    QString line = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz") +
-                   "  " + msg + "\n";
-    m_logFile.write(line.toUtf8());
-    m_logFile.flush();
+QString ArtworkManager::assetTag(AssetKind kind, int gameId) {
+    // Cover lines keep their original "game N:" prefix
+    if (kind == Cover) return QString("game %1").arg(gameId);
+    return QString("game %1 %2").arg(gameId).arg(kindName(kind));
 }
 
-QString ArtworkManager::cacheDir() {
-    QString dir = QDir::homePath() + "/.local/share/luna-ui/artwork-cache/covers";
+QString ArtworkManager::cacheDir(AssetKind kind) {
+    QString dir = QDir::homePath() + "/.local/share/luna-ui/artwork-cache/" + ASSET_KINDS[kind].dir;
     QDir().mkpath(dir);
     return dir;
 }
 
+QString ArtworkManager::assetPath(AssetKind kind, int gameId) {
+    const AssetKindInfo& info = ASSET_KINDS[kind];
+    return cacheDir(kind) + "/" + QString::number(gameId) + "-" + info.suffix + "." + info.ext;
+}
+
+QString ArtworkManager::coverPath(int gameId) {
+    return assetPath(Cover, gameId);
+}
+
 QString ArtworkManager::getCoverArt(int gameId, const QString& url) {
+    return fetchAsset(Cover, gameId, url);
+}
+
+QString ArtworkManager::getArtwork(int gameId, const QString& kind, const QString& url) {
+    AssetKind k;
+    if (!kindFromName(kind, &k)) {
+        log(QString("game %1: unknown artwork kind \"%2\"").arg(gameId).arg(kind), LogLevel::Warning);
+        return QString();
+    }
+    return fetchAsset(k, gameId, url);
+}
+
+QString ArtworkManager::fetchAsset(AssetKind kind, int gameId, const QString& url) {
+    const QString tag = assetTag(kind, gameId);
     if (url.isEmpty()) {
-        log(QString("game %1: url is EMPTY — no artwork source").arg(gameId));
+        log(tag + ": url is EMPTY — no artwork source", kind == Cover ? LogLevel::Info : LogLevel::Debug);
         return QString();
     }
 
     // Memory cache hit
-    if (m_cache.contains(gameId)) {
-        return *m_cache.object(gameId);
+    const int key = assetKey(kind, gameId);
+    if (m_cache.contains(key)) {
+        return *m_cache.object(key);
     }
 
     // Disk cache hit
-    QString cachedPath = cacheDir() + "/" + QString::number(gameId) + "-cover.jpg";
+    QString cachedPath = assetPath(kind, gameId);
     if (QFile::exists(cachedPath)) {
-        m_cache.insert(gameId, new QString(cachedPath));
-        log(QString("game %1: disk cache HIT -> %2").arg(gameId).arg(cachedPath));
+        m_cache.insert(key, new QString(cachedPath));
+        log(QString("%1: disk cache HIT -> %2").arg(tag, cachedPath), LogLevel::Debug);
+        if (kind == Cover) ensureThumbnail(gameId, cachedPath);
         return cachedPath;
     }
 
     // Local file (e.g. Steam library cache)
     if (QFile::exists(url)) {
-        m_cache.insert(gameId, new QString(url));
-        log(QString("game %1: local file HIT -> %2").arg(gameId).arg(url));
+        m_cache.insert(key, new QString(url));
+        log(QString("%1: local file HIT -> %2").arg(tag, url), LogLevel::Debug);
+        if (kind == Cover) ensureThumbnail(gameId, url);
         return url;
     }
 
     // Remote URL — kick off async download, return empty for now
-    if (url.startsWith("http") && !m_pending.contains(gameId)) {
-        log(QString("game %1: no cache, starting download -> %2").arg(gameId).arg(url));
-        downloadArtwork(gameId, url, steamFallbackUrls(url));
+    if (url.startsWith("http") && !m_pending.contains(key)) {
+        log(QString("%1: no cache, starting download -> %2").arg(tag, url));
+        downloadArtwork(kind, gameId, url, steamFallbackUrls(kind, url));
     } else if (!url.startsWith("http")) {
-        log(QString("game %1: local file MISSING -> %2").arg(gameId).arg(url));
+        log(QString("%1: local file MISSING -> %2").arg(tag, url));
     }
 
     return QString();
 }
 
-void ArtworkManager::downloadArtwork(int gameId, const QString& url,
-                                     const QStringList& fallbacks) {
-    m_pending.insert(gameId);
+void ArtworkManager::downloadArtwork(AssetKind kind, int gameId, const QString& url,
+                                     const QStringList& fallbacks,
+                                     QNetworkRequest::Priority priority) {
+    const int key = assetKey(kind, gameId);
+    m_pending.insert(key);
 
     QNetworkRequest req{QUrl(url)};
     req.setTransferTimeout(10000); // 10s timeout
+    req.setPriority(priority);
+    // Connections to the CDN are kept alive and reused by QNAM; allow
+    // HTTP/2 so a prefetch pass multiplexes over a single connection.
+    req.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
     QNetworkReply *reply = m_nam->get(req);
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply, gameId, url, fallbacks]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply, kind, gameId, key, url, fallbacks, priority]() {
         reply->deleteLater();
 
+        const QString tag = assetTag(kind, gameId);
         int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 
         if (reply->error() != QNetworkReply::NoError) {
-            log(QString("game %1: DOWNLOAD FAILED  http=%2  error=\"%3\"  url=%4")
-                .arg(gameId).arg(httpStatus).arg(reply->errorString(), url));
+            log(QString("%1: DOWNLOAD FAILED  http=%2  error=\"%3\"  url=%4")
+                .arg(tag).arg(httpStatus).arg(reply->errorString(), url), LogLevel::Warning);
 
             // Try the next fallback URL if available
             if (!fallbacks.isEmpty()) {
                 QString next = fallbacks.first();
                 QStringList remaining = fallbacks.mid(1);
-                log(QString("game %1: trying fallback -> %2").arg(gameId).arg(next));
-                downloadArtwork(gameId, next, remaining);
+                log(QString("%1: trying fallback -> %2").arg(tag, next));
+                downloadArtwork(kind, gameId, next, remaining, priority);
             } else {
-                m_pending.remove(gameId);
+                finishPending(key);
             }
             return;
         }
 
         QByteArray data = reply->readAll();
         if (data.isEmpty()) {
-            log(QString("game %1: DOWNLOAD EMPTY BODY  http=%2  url=%3")
-                .arg(gameId).arg(httpStatus).arg(url));
+            log(QString("%1: DOWNLOAD EMPTY BODY  http=%2  url=%3")
+                .arg(tag).arg(httpStatus).arg(url), LogLevel::Warning);
 
             if (!fallbacks.isEmpty()) {
                 QString next = fallbacks.first();
                 QStringList remaining = fallbacks.mid(1);
-                log(QString("game %1: trying fallback -> %2").arg(gameId).arg(next));
-                downloadArtwork(gameId, next, remaining);
+                log(QString("%1: trying fallback -> %2").arg(tag, next));
+                downloadArtwork(kind, gameId, next, remaining, priority);
             } else {
-                m_pending.remove(gameId);
+                finishPending(key);
             }
             return;
         }
 
-        QString path = cacheDir() + "/" + QString::number(gameId) + "-cover.jpg";
+        QString path = assetPath(kind, gameId);
         QFile file(path);
         if (file.open(QIODevice::WriteOnly)) {
             file.write(data);
             file.close();
+            m_cache.insert(key, new QString(path));
+            log(QString("%1: DOWNLOAD OK  %2 bytes  http=%3  saved=%4")
+                .arg(tag).arg(data.size()).arg(httpStatus).arg(path));
+            if (kind == Cover) {
+                rememberValidators(gameId, url, reply);
+                emit artworkReady(gameId, path);
+                m_needsPlaceholder.insert(gameId);
+                ensureThumbnail(gameId, path);
+            }
+            emit assetReady(gameId, kindName(kind), path);
+        } else {
+            log(QString("%1: FILE WRITE FAILED  path=%2  error=\"%3\"")
+                .arg(tag).arg(path, file.errorString()), LogLevel::Warning);
+        }
+        finishPending(key);
+    });
+}
+
+void ArtworkManager::finishPending(int key) {
+    m_pending.remove(key);
+    // Prefetch only handles covers, whose key is the plain gameId
+    if (m_prefetching.remove(key)) {
+        // Duplicates of this game from other stores reuse the download
+        if (QFile::exists(coverPath(key))) {
+            for (auto it = m_canonicalCover.cbegin(); it != m_canonicalCover.cend(); ++it) {
+                if (it.value() != key || QFile::exists(coverPath(it.key()))) continue;
+                if (QFile::copy(coverPath(key), coverPath(it.key())))
+                    ensureThumbnail(it.key(), coverPath(it.key()));
+            }
+        }
+        pumpPrefetch();
+    }
+}
+
+// ─── Background prefetch & revalidation ───
+
+void ArtworkManager::prefetchLibrary(const QVector<Game>& games) {
+    // Rows for a game owned on several stores share the canonical row's
+    // download, when that row has a cover to download at all
+    QSet<int> downloadable;
+    for (const Game& g : games) {
+        if (g.coverArtUrl.startsWith("http"))
+            downloadable.insert(g.id);
+    }
+
+    m_libraryCovers.clear();
+    m_libraryCovers.reserve(games.size());
+    m_canonicalCover.clear();
+    for (const Game& g : games) {
+        if (g.coverArtUrl.isEmpty()) continue;
+        m_libraryCovers.append({g.id, g.coverArtUrl});
+        if (g.canonicalId > 0 && g.canonicalId != g.id && downloadable.contains(g.canonicalId))
+            m_canonicalCover.insert(g.id, g.canonicalId);
+        if (g.dominantColor.isEmpty())
+            m_needsPlaceholder.insert(g.id);
+    }
+    queueLibraryJobs();
+    if (!m_revalidateTimer.isActive())
+        m_revalidateTimer.start();
+}
+
+void ArtworkManager::queueLibraryJobs() {
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    int missing = 0, stale = 0;
+
+    for (const auto& entry : m_libraryCovers) {
+        int gameId = entry.first;
+        const QString& url = entry.second;
+        if (m_pending.contains(gameId) || m_prefetchQueued.contains(gameId))
+            continue;
+
+        if (!QFile::exists(coverPath(gameId))) {
+            auto canonical = m_canonicalCover.constFind(gameId);
+            if (canonical != m_canonicalCover.constEnd()) {
+                // Not downloaded twice: finishPending() copies it over
+                // once the canonical row's download lands
+                if (QFile::copy(coverPath(canonical.value()), coverPath(gameId)))
+                    ensureThumbnail(gameId, coverPath(gameId));
+                continue;
+            }
+
+            // Local (Steam librarycache) art needs no download
+            if (!url.startsWith("http")) {
+                if (QFile::exists(url)) ensureThumbnail(gameId, url);
+                continue;
+            }
+            m_prefetchQueue.append({gameId, url, false});
+            m_prefetchQueued.insert(gameId);
+            missing++;
+            continue;
+        }
+
+        // Fill the decoded store for covers cached before it existed
+        ensureThumbnail(gameId, coverPath(gameId));
+
+        // Only covers we downloaded ourselves carry validators
+        auto it = m_validators.constFind(gameId);
+        if (it == m_validators.constEnd() || it->url.isEmpty())
+            continue;
+        if (now - it->checkedAt < REVALIDATE_AFTER_SECS)
+            continue;
+        m_prefetchQueue.append({gameId, it->url, true});
+        m_prefetchQueued.insert(gameId);
+        stale++;
+    }
+
+    if (missing > 0 || stale > 0) {
+        log(QString("prefetch: queued %1 missing, %2 stale covers").arg(missing).arg(stale));
+    }
+    pumpPrefetch();
+}
+
+void ArtworkManager::setGameRunning(bool running) {
+    if (m_gameRunning == running) return;
+    m_gameRunning = running;
+    log(QString("prefetch: %1").arg(running ? "paused (game running)" : "resumed"));
+    if (!running) pumpPrefetch();
+}
+
+void ArtworkManager::pumpPrefetch() {
+    // Back off entirely while a game is running — the queue is kept and
+    // resumed from where it stopped once Luna is back in the foreground.
+    if (m_gameRunning) return;
+
+    while (m_prefetching.size() < PREFETCH_CONCURRENCY && !m_prefetchQueue.isEmpty()) {
+        PrefetchJob job = m_prefetchQueue.takeFirst();
+        m_prefetchQueued.remove(job.gameId);
+
+        // A visible card may have started (or finished) this cover meanwhile
+        if (m_pending.contains(job.gameId)) continue;
+
+        m_prefetching.insert(job.gameId);
+        if (job.revalidate) {
+            revalidateCover(job.gameId);
+        } else if (QFile::exists(coverPath(job.gameId))) {
+            m_prefetching.remove(job.gameId);
+        } else {
+            downloadArtwork(Cover, job.gameId, job.url, steamFallbackUrls(Cover, job.url),
+                            QNetworkRequest::LowPriority);
+        }
+    }
+}
+
+void ArtworkManager::revalidateCover(int gameId) {
+    const Validator v = m_validators.value(gameId);
+    m_pending.insert(gameId);
+
+    QNetworkRequest req{QUrl(v.url)};
+    req.setTransferTimeout(10000);
+    req.setPriority(QNetworkRequest::LowPriority);
+    req.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (!v.etag.isEmpty())
+        req.setRawHeader("If-None-Match", v.etag.toUtf8());
+    if (!v.lastModified.isEmpty())
+        req.setRawHeader("If-Modified-Since", v.lastModified.toUtf8());
+    QNetworkReply *reply = m_nam->get(req);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, gameId, url = v.url]() {
+        reply->deleteLater();
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            // Keep the existing file; it will be retried on the next pass
+            log(QString("game %1: REVALIDATE FAILED  http=%2  error=\"%3\"")
+                .arg(gameId).arg(httpStatus).arg(reply->errorString()), LogLevel::Warning);
+            finishPending(gameId);
+            return;
+        }
+
+        if (httpStatus == 304) {
+            m_validators[gameId].checkedAt = QDateTime::currentSecsSinceEpoch();
+            m_saveValidatorsTimer.start();
+            finishPending(gameId);
+            return;
+        }
+
+        QByteArray data = reply->readAll();
+        if (data.isEmpty()) {
+            finishPending(gameId);
+            return;
+        }
+
+        // Replace atomically so a card decoding the old file never sees
+        // a half-written JPEG.
+        QString path = coverPath(gameId);
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit()) {
+            m_cache.remove(gameId);
             m_cache.insert(gameId, new QString(path));
-            log(QString("game %1: DOWNLOAD OK  %2 bytes  http=%3  saved=%4")
-                .arg(gameId).arg(data.size()).arg(httpStatus).arg(path));
+            rememberValidators(gameId, url, reply);
+            log(QString("game %1: REVALIDATE CHANGED  %2 bytes  saved=%3")
+                .arg(gameId).arg(data.size()).arg(path));
             emit artworkReady(gameId, path);
+            emit assetReady(gameId, kindName(Cover), path);
+            m_needsPlaceholder.insert(gameId);
+            ensureThumbnail(gameId, path);
         } else {
             log(QString("game %1: FILE WRITE FAILED  path=%2  error=\"%3\"")
-                .arg(gameId).arg(path, file.errorString()));
+                .arg(gameId).arg(path, file.errorString()), LogLevel::Warning);
+        }
+        finishPending(gameId);
+    });
+}
+
+// ─── Pre-decoded store ───
+
+QString ArtworkManager::getDecodedCover(int gameId) const {
+    if (!m_blobStore || !m_blobStore->contains(gameId)) return QString();
+    return QString("image://artwork/cover/%1/%2").arg(gameId).arg(m_decodedRevision.value(gameId));
+}
+
+void ArtworkManager::ensureThumbnail(int gameId, const QString& sourcePath) {
+    qint64 mtime = QFileInfo(sourcePath).lastModified().toMSecsSinceEpoch();
+    if (mtime == 0) return;
+
+    // One decode per game at a time; a newer file (revalidation replaced
+    // the cover meanwhile) is decoded again once the running one is done
+    auto pending = m_thumbnailing.constFind(gameId);
+    if (pending != m_thumbnailing.cend()) {
+        if (*pending != mtime) m_thumbnailRequeue.insert(gameId, sourcePath);
+        return;
+    }
+    bool needsDecoded = m_blobStore && m_blobStore->sourceMtime(gameId) != mtime;
+    if (!needsDecoded && !m_needsPlaceholder.contains(gameId)) return;
+
+    m_thumbnailing.insert(gameId, mtime);
+    ArtworkBlobStore *store = needsDecoded ? m_blobStore.get() : nullptr;
+    m_thumbnailPool.start([this, store, gameId, sourcePath, mtime]() {
+        // Let the decoder downscale while reading (JPEG decodes at 1/2,
+        // 1/4 or 1/8 scale) instead of decoding full-size and shrinking.
+        QImageReader reader(sourcePath);
+        reader.setAutoTransform(true);
+        QSize full = reader.size();
+        if (full.isValid()) {
+            reader.setScaledSize(full.scaled(ArtworkBlobStore::CardWidth,
+                                             ArtworkBlobStore::CardHeight,
+                                             Qt::KeepAspectRatio));
         }
-        m_pending.remove(gameId);
+        QImage img = reader.read();
+        QString error = img.isNull() ? reader.errorString() : QString();
+        bool ok = !img.isNull() && (!store || store->insert(gameId, img, mtime));
+
+        // Placeholders come from the same decode — no second read
+        QString color, preview;
+        if (!img.isNull()) {
+            color = dominantColor(img);
+            preview = lowResPreview(img);
+        }
+
+        QMetaObject::invokeMethod(this, [this, gameId, ok, stored = ok && store, error, color, preview]() {
+            m_thumbnailing.remove(gameId);
+            const QString requeue = m_thumbnailRequeue.take(gameId);
+            if (!requeue.isEmpty()) {
+                // This decode is already stale; the requeued one emits
+                m_needsPlaceholder.insert(gameId);
+                ensureThumbnail(gameId, requeue);
+                return;
+            }
+            if (!ok) {
+                log(QString("game %1: DECODE FAILED  error=\"%2\"").arg(gameId).arg(error), LogLevel::Warning);
+            }
+            if (stored) {
+                m_decodedRevision[gameId]++;
+                emit decodedCoverChanged(gameId);
+            }
+            if (!color.isEmpty()) {
+                m_needsPlaceholder.remove(gameId);
+                emit placeholderReady(gameId, color, preview);
+            }
+        }, Qt::QueuedConnection);
     });
 }
 
-QStringList ArtworkManager::steamFallbackUrls(const QString& url) {
+// ─── Cover placeholders ───
+
+QString ArtworkManager::dominantColor(const QImage& src) {
+    QImage img = src.convertToFormat(QImage::Format_RGB32);
+    const int count = img.width() * img.height();
+    if (count == 0) return QString();
+
+    // 32bpp scanlines are never padded, so the image is one flat array
+    const quint32 *px = reinterpret_cast<const quint32 *>(img.constBits());
+
+    // Pass 1: quantise each pixel to a 4:4:4 bin.  Shifts and masks only,
+    // no branches — the compiler turns this into SIMD.
+    std::vector<quint16> bins(count);
+    for (int i = 0; i < count; ++i) {
+        quint32 p = px[i];
+        bins[i] = quint16(((p >> 12) & 0xF00) | ((p >> 8) & 0x0F0) | ((p >> 4) & 0x00F));
+    }
+
+    // Pass 2: histogram, then pick the most common bin that isn't
+    // near-black or near-white (letterboxing and logos on plain
+    // backgrounds would otherwise win).
+    std::vector<int> hist(4096, 0);
+    for (int i = 0; i < count; ++i)
+        hist[bins[i]]++;
+
+    int best = -1, bestAny = 0;
+    for (int b = 0; b < 4096; ++b) {
+        if (hist[b] > hist[bestAny]) bestAny = b;
+        int r = b >> 8, g = (b >> 4) & 0xF, bl = b & 0xF;
+        bool extreme = (r < 2 && g < 2 && bl < 2) || (r > 13 && g > 13 && bl > 13);
+        if (!extreme && (best < 0 || hist[b] > hist[best])) best = b;
+    }
+    if (best < 0 || hist[best] == 0) best = bestAny;
+
+    // Pass 3: average the real pixels of the winning bin for a precise colour
+    qint64 sr = 0, sg = 0, sb = 0;
+    for (int i = 0; i < count; ++i) {
+        qint64 m = bins[i] == best;
+        quint32 p = px[i];
+        sr += m * ((p >> 16) & 0xFF);
+        sg += m * ((p >> 8) & 0xFF);
+        sb += m * (p & 0xFF);
+    }
+    int n = hist[best];
+    return QColor(int(sr / n), int(sg / n), int(sb / n)).name();
+}
+
+QString ArtworkManager::lowResPreview(const QImage& img) {
+    // Tiny box-filtered copy of the cover; stretched with linear
+    // filtering it reads as a blurred version of the art.
+    QImage small = img.scaled(PREVIEW_WIDTH, PREVIEW_HEIGHT, Qt::IgnoreAspectRatio,
+                              Qt::SmoothTransformation).convertToFormat(QImage::Format_RGB888);
+
+    // [width][height][rgb...] — self-describing so the provider needs no constants
+    QByteArray bytes;
+    bytes.reserve(2 + PREVIEW_WIDTH * PREVIEW_HEIGHT * 3);
+    bytes.append(char(small.width()));
+    bytes.append(char(small.height()));
+    for (int y = 0; y < small.height(); ++y)
+        bytes.append(reinterpret_cast<const char *>(small.constScanLine(y)), small.width() * 3);
+    return QString::fromLatin1(bytes.toBase64(QByteArray::Base64UrlEncoding
+                                              | QByteArray::OmitTrailingEquals));
+}
+
+void ArtworkManager::rememberValidators(int gameId, const QString& url, const QNetworkReply *reply) {
+    Validator v;
+    v.url = url;
+    v.etag = QString::fromUtf8(reply->rawHeader("ETag"));
+    v.lastModified = QString::fromUtf8(reply->rawHeader("Last-Modified"));
+    v.checkedAt = QDateTime::currentSecsSinceEpoch();
+    m_validators.insert(gameId, v);
+    m_saveValidatorsTimer.start();
+}
+
+void ArtworkManager::loadValidators() {
+    QFile file(cacheDir() + "/validators.json");
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        Validator v;
+        v.url = obj["url"].toString();
+        v.etag = obj["etag"].toString();
+        v.lastModified = obj["lastModified"].toString();
+        v.checkedAt = obj["checkedAt"].toInteger();
+        m_validators.insert(it.key().toInt(), v);
+    }
+}
+
+void ArtworkManager::saveValidators() {
+    QJsonObject root;
+    for (auto it = m_validators.constBegin(); it != m_validators.constEnd(); ++it) {
+        QJsonObject obj;
+        obj["url"] = it->url;
+        if (!it->etag.isEmpty()) obj["etag"] = it->etag;
+        if (!it->lastModified.isEmpty()) obj["lastModified"] = it->lastModified;
+        obj["checkedAt"] = it->checkedAt;
+        root[QString::number(it.key())] = obj;
+    }
+
+    QSaveFile file(cacheDir() + "/validators.json");
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+QStringList ArtworkManager::steamFallbackUrls(AssetKind kind, const QString& url) {
     // Build fallback URLs for Steam CDN images.
-    // Not all games have library_600x900_2x.jpg — older/smaller titles
-    // often only have header.jpg.
+    // Not all games have library_600x900_2x.jpg or a library hero —
+    // older/smaller titles often only have header.jpg.
     QStringList fallbacks;
+    // Icons are content-hashed; there is nothing to guess
+    if (kind == Icon) return fallbacks;
 
     // Only generate fallbacks for Steam CDN URLs
     static const QStringList steamHosts = {
@@ -161,12 +649,32 @@ QStringList ArtworkManager::steamFallbackUrls(const QString& url) {
     QString appId = after.left(slash);
     QString basePath = path.left(appsIdx + 6) + appId + "/";
 
-    // Ordered by quality: high-res vertical → standard vertical → header
-    QStringList candidates = {
-        basePath + "library_600x900_2x.jpg",
-        basePath + "library_600x900.jpg",
-        basePath + "header.jpg",
-    };
+    // Ordered by quality per kind
+    QStringList candidates;
+    switch (kind) {
+    case Hero:
+        // wide hero → store capsule → header, all landscape
+        candidates = {
+            basePath + "library_hero.jpg",
+            basePath + "capsule_616x353.jpg",
+            basePath + "header.jpg",
+        };
+        break;
+    case Logo:
+        candidates = {
+            basePath + "logo.png",
+            basePath + "logo_2x.png",
+        };
+        break;
+    default:
+        // high-res vertical → standard vertical → header
+        candidates = {
+            basePath + "library_600x900_2x.jpg",
+            basePath + "library_600x900.jpg",
+            basePath + "header.jpg",
+        };
+        break;
+    }
 
     // Return only candidates that differ from the original URL
     QString origPath = parsed.path();
@@ -4,32 +4,131 @@
 #include <QObject>
 #include <QCache>
 #include <QSet>
+#include <QHash>
+#include <QImage>
 #include <QFile>
+#include <QList>
 #include <QStringList>
+#include <QTimer>
 #include <QUrl>
+#include <QVector>
+#include <QNetworkRequest>
+#include <QThreadPool>
+#include <memory>
+#include "database.h"
+#include "logger.h"
+
+class ArtworkBlobStore;
 
 class QNetworkAccessManager;
+class QNetworkReply;
 
 class ArtworkManager : public QObject {
     Q_OBJECT
 public:
+    // Asset kinds, each with its own cache namespace and CDN fallbacks
+    enum AssetKind { Cover = 0, Hero, Logo, Icon, AssetKindCount };
+
     explicit ArtworkManager(QObject *parent = nullptr);
+    ~ArtworkManager();
 
     Q_INVOKABLE QString getCoverArt(int gameId, const QString& url);
 
+    // Any kind by name ("cover", "hero", "logo", "icon").  Returns the
+    // local path if cached, otherwise starts a download and returns empty;
+    // assetReady fires when it lands.  Nothing is fetched until a view
+    // asks, so large hero art is only pulled for games actually shown.
+    Q_INVOKABLE QString getArtwork(int gameId, const QString& kind, const QString& url);
+
+    // "image://artwork/cover/<id>/<revision>" when a pre-decoded
+    // card-size copy of the cover is in the blob store, empty otherwise.
+    // The revision changes with every re-decode so views reload it.
+    Q_INVOKABLE QString getDecodedCover(int gameId) const;
+
+    // Null when the decoded store is disabled or failed to open
+    ArtworkBlobStore *decodedStore() const { return m_blobStore.get(); }
+
+    // Background job run after a library scan: downloads every missing
+    // cover at low priority and revalidates stale ones with conditional
+    // requests (If-None-Match / If-Modified-Since).
+    void prefetchLibrary(const QVector<Game>& games);
+
+    // Background work backs off while a game is in the foreground
+    void setGameRunning(bool running);
+
 signals:
-    void artworkReady(int gameId, const QString& localPath);
+    void artworkReady(int gameId, const QString& localPath);   // covers
+    void assetReady(int gameId, const QString& kind, const QString& localPath);
+    // Dominant colour ("#rrggbb") and low-res preview computed from a
+    // freshly decoded cover; main.cpp persists them to the games table.
+    void placeholderReady(int gameId, const QString& dominantColor, const QString& preview);
+    // A decoded copy of the cover landed in the blob store or replaced
+    // the previous one; getDecodedCover() now returns a new URL
+    void decodedCoverChanged(int gameId);
 
 private:
+    // HTTP validators remembered per cached cover so refreshed art on the
+    // CDN is picked up without re-downloading unchanged images.
+    struct Validator {
+        QString url;           // URL the cached file was fetched from
+        QString etag;
+        QString lastModified;
+        qint64 checkedAt = 0;  // last successful download or 304 (epoch secs)
+    };
+
+    struct PrefetchJob {
+        int gameId;
+        QString url;
+        bool revalidate;       // true = conditional GET of an existing file
+    };
+
     QNetworkAccessManager *m_nam;
+    // Keyed by assetKey(); a cover's key is its plain gameId
     QCache<int, QString> m_cache;
     QSet<int> m_pending;  // downloads in flight
-    QFile m_logFile;
-    QString cacheDir();
-    void downloadArtwork(int gameId, const QString& url,
-                         const QStringList& fallbacks = {});
-    static QStringList steamFallbackUrls(const QString& failedUrl);
-    void log(const QString& msg);
+    int m_logCategory = -1;
+
+    QHash<int, Validator> m_validators;
+    QList<PrefetchJob> m_prefetchQueue;
+    QSet<int> m_prefetchQueued;     // gameIds in m_prefetchQueue
+    QSet<int> m_prefetching;        // in-flight requests owned by the prefetch job
+    QVector<QPair<int, QString>> m_libraryCovers;  // last scanned library
+    QHash<int, int> m_canonicalCover; // duplicate row → row whose download it reuses
+    QTimer m_revalidateTimer;
+    QTimer m_saveValidatorsTimer;
+    bool m_gameRunning = false;
+
+    std::unique_ptr<ArtworkBlobStore> m_blobStore;
+    QThreadPool m_thumbnailPool;
+    QHash<int, qint64> m_thumbnailing;      // decodes queued or running → source mtime
+    QHash<int, QString> m_thumbnailRequeue; // source changed under a running decode
+    QSet<int> m_needsPlaceholder;   // covers without a stored placeholder
+    QHash<int, int> m_decodedRevision;  // bumped per blob store insert
+
+    static int assetKey(AssetKind kind, int gameId) { return (int(kind) << 28) | gameId; }
+    static QString kindName(AssetKind kind);
+    static bool kindFromName(const QString& name, AssetKind *kind);
+    static QString assetTag(AssetKind kind, int gameId);
+
+    QString cacheDir(AssetKind kind = Cover);
+    QString assetPath(AssetKind kind, int gameId);
+    QString coverPath(int gameId);
+    QString fetchAsset(AssetKind kind, int gameId, const QString& url);
+    void downloadArtwork(AssetKind kind, int gameId, const QString& url,
+                         const QStringList& fallbacks = {},
+                         QNetworkRequest::Priority priority = QNetworkRequest::NormalPriority);
+    void revalidateCover(int gameId);
+    void ensureThumbnail(int gameId, const QString& sourcePath);
+    void finishPending(int key);
+    void queueLibraryJobs();
+    void pumpPrefetch();
+    void rememberValidators(int gameId, const QString& url, const QNetworkReply *reply);
+    void loadValidators();
+    void saveValidators();
+    static QString dominantColor(const QImage& img);
+    static QString lowResPreview(const QImage& img);
+    static QStringList steamFallbackUrls(AssetKind kind, const QString& failedUrl);
+    void log(const QString& msg, LogLevel level = LogLevel::Info);
 };
 
 #endif
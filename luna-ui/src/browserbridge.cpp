@@ -4,8 +4,14 @@
 #include <QJsonArray>
 #include <QNetworkReply>
 #include <QDebug>
-#include <QDateTime>
-#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// How long a CDP command may go unanswered before it counts as failed.
+// Navigation is short: a stuck page should not hold back later moves.
+static const int CDP_COMMAND_TIMEOUT_MS = 5000;
+static const int NAV_COMMAND_TIMEOUT_MS = 1000;
 
 // ── Constructor / Destructor ─────────────────────────────────────────
 
@@ -18,23 +24,27 @@ BrowserBridge::BrowserBridge(QObject *parent) : QObject(parent) {
 
     m_connectTimer.setSingleShot(true);
     connect(&m_connectTimer, &QTimer::timeout, this, &BrowserBridge::attemptConnection);
+
+    m_clock.start();
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &BrowserBridge::expireCommands);
+    m_roundTripsUs.reserve(RoundTripSamples);
+
+    m_logCategory = Logger::instance().registerCategory(
+        "browser", "/tmp/luna-browserbridge-diag.log", 1024 * 1024, 1);
 }
 
 BrowserBridge::~BrowserBridge() {
     disconnect();
 }
 
-void BrowserBridge::diag(const QString &msg) {
+void BrowserBridge::diag(const QString &msg, LogLevel level) {
     qDebug() << "BrowserBridge:" << msg;
     m_diagnostics = msg;
     emit diagnosticsChanged();
 
-    // Append to log file so diagnostics survive even if the overlay isn't visible
-    if (m_diagLog.isOpen()) {
-        QTextStream out(&m_diagLog);
-        out << QDateTime::currentDateTime().toString("hh:mm:ss.zzz") << "  " << msg << "\n";
-        out.flush();
-    }
+    // Also log to file so diagnostics survive even if the overlay isn't visible
+    Logger::instance().write(m_logCategory, level, msg);
 }
 
 void BrowserBridge::updateBrowserDiagOverlay() {
@@ -61,14 +71,22 @@ void BrowserBridge::updateBrowserDiagOverlay() {
         "Luna BrowserBridge Diag\\n"
         "active: %1  connected: %2\\n"
         "actions in: %3  dispatched: %4\\n"
-        "cdp sent: %5  errors: %6\\n"
-        "last: %7")
+        "cdp sent: %5  errors: %6  timeouts: %7\\n"
+        "cdp rtt p50: %8 ms  p95: %9 ms  pending: %10\\n"
+        "page: %11 elements  move avg %12 ms\\n"
+        "last: %13")
         .arg(m_active ? "true" : "false")
         .arg(m_connected ? "true" : "false")
         .arg(m_actionsReceived)
         .arg(m_actionsDispatched)
         .arg(m_cdpCommandsSent)
         .arg(m_cdpErrors)
+        .arg(m_cdpTimeouts)
+        .arg(cdpRoundTripMs(), 0, 'f', 1)
+        .arg(cdpRoundTripP95Ms(), 0, 'f', 1)
+        .arg(m_pending.size())
+        .arg(m_navElements)
+        .arg(m_navMoveMs, 0, 'f', 2)
         .arg(QString(m_diagnostics).replace("'", "\\'").replace("\n", "\\n"));
 
     sendCdpCommand("Runtime.evaluate", {
@@ -80,18 +98,19 @@ void BrowserBridge::updateBrowserDiagOverlay() {
 
 void BrowserBridge::connectToBrowser() {
     m_connectAttempts = 0;
-    m_injected = false;
+    m_scriptRegistered = false;
+    m_pageReady = false;
     m_actionsReceived = 0;
     m_actionsDispatched = 0;
     m_cdpCommandsSent = 0;
     m_cdpErrors = 0;
+    m_cdpTimeouts = 0;
+    m_navElements = 0;
+    m_navMoveMs = 0;
+    m_roundTripsUs.clear();
+    m_roundTripNext = 0;
 
-    // Open (or reopen) the diagnostic log file
-    if (m_diagLog.isOpen()) m_diagLog.close();
-    m_diagLog.setFileName("/tmp/luna-browserbridge-diag.log");
-    m_diagLog.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
-
-    diag("connectToBrowser() called — starting CDP discovery");
+    diag("═══ connectToBrowser() called — starting CDP discovery ═══");
     attemptConnection();
 }
 
@@ -109,8 +128,9 @@ void BrowserBridge::disconnect() {
         m_textFieldFocused = false;
         emit textFieldFocusedChanged();
     }
-    m_injected = false;
-    if (m_diagLog.isOpen()) m_diagLog.close();
+    m_scriptRegistered = false;
+    m_pageReady = false;
+    failPending("disconnected");
 }
 
 void BrowserBridge::setActive(bool active) {
@@ -122,14 +142,13 @@ void BrowserBridge::setActive(bool active) {
 
 void BrowserBridge::navigate(const QString &direction) {
     if (!m_connected) return;
-    QString js = QString("window.__lunaNav && window.__lunaNav.move('%1')").arg(direction);
-    sendCdpCommand("Runtime.evaluate", {{"expression", js}});
+    queueNavCommand(QString("move('%1')").arg(direction));
 }
 
 void BrowserBridge::confirmElement() {
     if (!m_connected) return;
-    sendCdpCommand("Runtime.evaluate",
-        {{"expression", "window.__lunaNav && window.__lunaNav.activate()"}});
+    // Queued behind any pending moves so it activates where they land
+    queueNavCommand("activate()");
 }
 
 void BrowserBridge::goBack() {
@@ -276,13 +295,16 @@ void BrowserBridge::discoverTarget() {
 void BrowserBridge::onWsConnected() {
     m_connected = true;
     m_connectAttempts = 0;
-    diag("WebSocket connected — enabling Runtime + injecting script");
+    diag("WebSocket connected — enabling Runtime + registering script");
     emit connectedChanged();
 
     // Enable Runtime domain to receive console messages from injected JS
     sendCdpCommand("Runtime.enable");
+    sendCdpCommand("Page.enable");
 
-    // Inject the navigation overlay script
+    // Every document loaded from now on gets the navigation script from
+    // the browser itself; the one already showing gets it directly
+    registerNavigationScript();
     injectNavigationScript();
 
     // Show diagnostic overlay inside the browser page after a short delay
@@ -296,11 +318,13 @@ void BrowserBridge::onWsDisconnected() {
     bool wasConnected = m_connected;
     diag(QString("WebSocket disconnected (wasConnected=%1)").arg(wasConnected));
     m_connected = false;
-    m_injected = false;
+    m_scriptRegistered = false;
+    m_pageReady = false;
     if (m_textFieldFocused) {
         m_textFieldFocused = false;
         emit textFieldFocusedChanged();
     }
+    failPending("disconnected");
     if (wasConnected) {
         emit connectedChanged();
         // Only signal browser closed if we actually had a working session.
@@ -329,7 +353,7 @@ void BrowserBridge::onWsTextMessage(const QString &message) {
 
     if (msg.contains("id")) {
         // CDP response to a command we sent
-        handleCdpResult(msg["id"].toInt(), msg["result"].toObject());
+        handleCdpResult(msg);
     } else if (msg.contains("method")) {
         // CDP event
         handleCdpEvent(msg);
@@ -338,7 +362,8 @@ void BrowserBridge::onWsTextMessage(const QString &message) {
 
 // ── CDP Communication ────────────────────────────────────────────────
 
-int BrowserBridge::sendCdpCommand(const QString &method, const QJsonObject &params) {
+int BrowserBridge::sendCdpCommand(const QString &method, const QJsonObject &params,
+                                  CdpCallback done, int timeoutMs) {
     int id = m_cdpId++;
     QJsonObject msg;
     msg["id"] = id;
@@ -346,25 +371,157 @@ int BrowserBridge::sendCdpCommand(const QString &method, const QJsonObject &para
     if (!params.isEmpty()) {
         msg["params"] = params;
     }
+    if (timeoutMs <= 0) timeoutMs = CDP_COMMAND_TIMEOUT_MS;
+    m_pending.insert(id, {method, m_clock.nsecsElapsed(),
+                          m_clock.elapsed() + timeoutMs, std::move(done)});
+    if (!m_timeoutTimer.isActive() || m_timeoutTimer.remainingTime() > timeoutMs)
+        m_timeoutTimer.start(timeoutMs);
+
     m_cdpCommandsSent++;
     m_ws.sendTextMessage(QJsonDocument(msg).toJson(QJsonDocument::Compact));
     return id;
 }
 
-void BrowserBridge::handleCdpResult(int id, const QJsonObject &result) {
-    // Check for CDP-level exceptions (script errors, etc.)
-    if (result.contains("exceptionDetails")) {
+void BrowserBridge::handleCdpResult(const QJsonObject &msg) {
+    const int id = msg["id"].toInt();
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) return;   // already timed out or failed
+    PendingCommand command = std::move(it.value());
+    m_pending.erase(it);
+    if (m_pending.isEmpty()) m_timeoutTimer.stop();
+    recordRoundTrip((m_clock.nsecsElapsed() - command.sentNs) / 1000);
+
+    const QJsonObject result = msg["result"].toObject();
+    QString error;
+    if (msg.contains("error")) {
+        // Protocol-level failure (unknown method, bad params, no target)
+        error = msg["error"].toObject()["message"].toString();
+        if (error.isEmpty()) error = "protocol error";
+    } else if (result.contains("exceptionDetails")) {
+        // Script errors from Runtime.evaluate
         QJsonObject ex = result["exceptionDetails"].toObject();
-        QString text = ex["text"].toString();
-        if (text.isEmpty()) {
+        error = ex["text"].toString();
+        if (error.isEmpty()) {
             QJsonObject exObj = ex["exception"].toObject();
-            text = exObj["description"].toString();
+            error = exObj["description"].toString();
         }
+        if (error.isEmpty()) error = "exception";
+    }
+    if (!error.isEmpty()) {
         m_cdpErrors++;
-        diag(QString("CDP error (id %1): %2").arg(id).arg(text));
+        diag(QString("CDP error (id %1, %2): %3").arg(id).arg(command.method, error),
+             LogLevel::Warning);
+    }
+
+    if (command.done) command.done(error.isEmpty(), result, error);
+}
+
+// ── Command Deadlines ────────────────────────────────────────────────
+
+void BrowserBridge::scheduleTimeouts() {
+    if (m_pending.isEmpty()) {
+        m_timeoutTimer.stop();
+        return;
+    }
+    qint64 next = -1;
+    for (const PendingCommand &command : std::as_const(m_pending)) {
+        if (next < 0 || command.deadlineMs < next)
+            next = command.deadlineMs;
+    }
+    m_timeoutTimer.start(int(qMax<qint64>(0, next - m_clock.elapsed())));
+}
+
+void BrowserBridge::expireCommands() {
+    const qint64 now = m_clock.elapsed();
+    QList<CdpCallback> expired;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->deadlineMs > now) {
+            ++it;
+            continue;
+        }
+        m_cdpErrors++;
+        m_cdpTimeouts++;
+        diag(QString("CDP timeout (id %1, %2): no response after %3 ms")
+                .arg(it.key()).arg(it->method).arg(now - it->sentNs / 1000000),
+             LogLevel::Warning);
+        if (it->done) expired.append(std::move(it->done));
+        it = m_pending.erase(it);
+    }
+    scheduleTimeouts();
+
+    // Callbacks last: they may send new commands
+    for (const CdpCallback &done : expired)
+        done(false, QJsonObject(), "timeout");
+}
+
+void BrowserBridge::failPending(const QString &error) {
+    m_navInFlight = false;
+    m_navQueue.clear();
+    m_timeoutTimer.stop();
+    const QHash<int, PendingCommand> pending = std::exchange(m_pending, {});
+    for (const PendingCommand &command : pending) {
+        if (command.done) command.done(false, QJsonObject(), error);
     }
 }
 
+// ── Round-trip Stats ─────────────────────────────────────────────────
+
+void BrowserBridge::recordRoundTrip(qint64 us) {
+    if (m_roundTripsUs.size() < RoundTripSamples)
+        m_roundTripsUs.append(us);
+    else
+        m_roundTripsUs[m_roundTripNext] = us;
+    m_roundTripNext = (m_roundTripNext + 1) % RoundTripSamples;
+}
+
+double BrowserBridge::roundTripPercentile(double q) const {
+    if (m_roundTripsUs.isEmpty()) return 0;
+    QVector<qint64> sorted = m_roundTripsUs;
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest rank
+    const int rank = int(std::ceil(q * sorted.size()));
+    return sorted[qBound(0, rank - 1, int(sorted.size()) - 1)] / 1000.0;
+}
+
+// ── Navigation Pipeline ──────────────────────────────────────────────
+// A held stick or a fast thumb sends moves quicker than the page can
+// answer.  Rather than stacking up one evaluate per move, only one is in
+// flight; whatever arrives meanwhile is sent as a single evaluate when
+// it returns, in order.
+//
+// While the page is still loading nothing is sent, possibly for seconds.
+// Moves made against a page the user can't see yet aren't replayed one by
+// one: a move replaces everything queued before it, and activate() is
+// kept once, so the queue holds at most two calls.
+
+void BrowserBridge::queueNavCommand(const QString &call) {
+    if (!m_pageReady) {
+        if (call.startsWith("move("))
+            m_navQueue.clear();
+        else if (m_navQueue.contains(call))
+            return;
+    }
+    m_navQueue.append(call);
+    if (!m_navInFlight) flushNavQueue();
+}
+
+void BrowserBridge::flushNavQueue() {
+    if (m_navQueue.isEmpty() || !m_connected || !m_pageReady) return;
+
+    QString js = "(function(n) { if (!n) return;";
+    for (const QString &call : std::as_const(m_navQueue))
+        js += " n." + call + ";";
+    js += " })(window.__lunaNav)";
+    m_navQueue.clear();
+
+    m_navInFlight = true;
+    sendCdpCommand("Runtime.evaluate", {{"expression", js}},
+        [this](bool, const QJsonObject &, const QString &) {
+            m_navInFlight = false;
+            flushNavQueue();
+        }, NAV_COMMAND_TIMEOUT_MS);
+}
+
 void BrowserBridge::handleCdpEvent(const QJsonObject &msg) {
     QString method = msg["method"].toString();
     QJsonObject params = msg["params"].toObject();
@@ -382,8 +539,12 @@ void BrowserBridge::handleCdpEvent(const QJsonObject &msg) {
 
             if (event == "ready") {
                 int count = data["count"].toInt();
-                diag(QString("Script injected OK — %1 interactive elements found").arg(count));
+                diag(QString("Navigation ready — %1 interactive elements found").arg(count));
+                m_pageReady = true;
+                m_navElements = count;
                 updateBrowserDiagOverlay();
+                // Moves made while the page was loading
+                if (!m_navInFlight) flushNavQueue();
             } else if (event == "textFocus") {
                 bool wasFocused = m_textFieldFocused;
                 m_textFieldFocused = true;
@@ -398,49 +559,83 @@ void BrowserBridge::handleCdpEvent(const QJsonObject &msg) {
                     m_textFieldFocused = false;
                     emit textFieldFocusedChanged();
                 }
+            } else if (event == "navStats") {
+                // Sent by the page at most once a second while moving
+                Logger::instance().write(m_logCategory, LogLevel::Debug, QString(
+                    "Nav index: %1 tracked, %2 near view, %3 indexed in %4 cells; "
+                    "%5 moves avg %6 ms max %7 ms; %8 rebuilds avg %9 ms; %10 full scans")
+                    .arg(data["tracked"].toInt()).arg(data["nearby"].toInt())
+                    .arg(data["indexed"].toInt()).arg(data["cells"].toInt())
+                    .arg(data["moves"].toInt()).arg(data["moveMs"].toDouble())
+                    .arg(data["maxMoveMs"].toDouble()).arg(data["rebuilds"].toInt())
+                    .arg(data["rebuildMs"].toDouble()).arg(data["fullScans"].toInt()));
+                m_navMoveMs = data["moveMs"].toDouble();
+                m_navElements = data["tracked"].toInt();
+                emit diagnosticsChanged();
             }
         }
     }
 
-    // Re-inject script on navigation (new page load)
-    if (method == "Runtime.executionContextCreated" ||
-        method == "Runtime.executionContextsCleared") {
-        m_injected = false;
-        // Small delay so the DOM is ready
-        QTimer::singleShot(500, this, [this]() {
-            if (m_connected && !m_injected) {
-                injectNavigationScript();
-            }
-        });
+    // A new top-level document: the old __lunaNav is gone and the
+    // registered script announces the new one with "ready"
+    if (method == "Runtime.executionContextsCleared") {
+        m_pageReady = false;
+        m_navQueue.clear();   // moves meant for the previous page
+    }
+
+    // Browsers without addScriptToEvaluateOnNewDocument: inject into each
+    // new main-world context ourselves.  The script waits for the DOM and
+    // ignores subframes on its own.
+    if (method == "Runtime.executionContextCreated" && !m_scriptRegistered) {
+        QJsonObject context = params["context"].toObject();
+        if (context["auxData"].toObject()["isDefault"].toBool())
+            injectNavigationScript(context["id"].toInt());
     }
 }
 
 // ── Script Injection ─────────────────────────────────────────────────
 
-void BrowserBridge::injectNavigationScript() {
-    if (m_injected) return;
-    m_injected = true;
-    diag("Injecting navigation script...");
-    sendCdpCommand("Runtime.evaluate", {
+void BrowserBridge::registerNavigationScript() {
+    diag("Registering navigation script for new documents...");
+    m_scriptRegistered = true;
+    sendCdpCommand("Page.addScriptToEvaluateOnNewDocument", {
+        {"source", navigationScript()}
+    }, [this](bool ok, const QJsonObject &, const QString &error) {
+        if (ok) return;
+        // Fall back to injecting on every execution context
+        m_scriptRegistered = false;
+        diag(QString("Script registration failed (%1), injecting per page").arg(error),
+             LogLevel::Warning);
+    });
+}
+
+void BrowserBridge::injectNavigationScript(int contextId) {
+    QJsonObject params {
         {"expression", navigationScript()},
         {"allowUnsafeEvalBlockedByCSP", true}
-    });
+    };
+    if (contextId) params["contextId"] = contextId;
+    sendCdpCommand("Runtime.evaluate", params);
 }
 
 // ── Navigation JavaScript ────────────────────────────────────────────
-// This script is injected into the browser page.  It builds a list of
-// all interactive elements, draws a visible highlight ring around the
-// currently focused one, and exposes window.__lunaNav for the C++
-// bridge to call move() / activate() / setText().
+// This script runs in every top-level document — registered with
+// Page.addScriptToEvaluateOnNewDocument, so ahead of the page's own
+// scripts — and sets itself up once the DOM is interactive.  It keeps a
+// spatial index of the interactive elements, draws a visible highlight
+// ring around the currently focused one, and exposes window.__lunaNav for
+// the C++ bridge to call move() / activate() / setText().
 
 QString BrowserBridge::navigationScript() {
     return QStringLiteral(R"JS(
 (function() {
-    if (window.__lunaNav) return;
+    // Subframes get the script too; navigation lives in the top document
+    if (window.top !== window) return;
+    // Already running (bridge reconnected): just say so again
+    if (window.__lunaNav) { window.__lunaNav.announce(); return; }
 
     var nav = {};
-    var currentIndex = 0;
-    var elements = [];
+    var current = null;       // focused element
     var highlightEl = null;
 
     // Selectors for interactive elements
@@ -448,6 +643,27 @@ QString BrowserBridge::navigationScript() {
         + '[role="button"], [role="link"], [role="menuitem"], '
         + '[tabindex]:not([tabindex="-1"]), [onclick]';
 
+    // Element index.  `tracked` holds every element matching SELECTORS,
+    // kept up to date by a MutationObserver; `nearby` the ones an
+    // IntersectionObserver sees within a screen of the viewport.  Only
+    // nearby elements go into the grid: CELL-sized buckets of their
+    // centres in document coordinates, rebuilt lazily after the page
+    // changes, resizes or scrolls an inner container.  Scrolling the
+    // window moves nothing in document coordinates, so it only costs a
+    // rebuild when a fixed-position element is indexed.
+    var CELL = 200;
+    var tracked = new Set();
+    var nearby = new Set();
+    var grid = new Map();     // "cx,cy" -> [{ el, x, y }]
+    var gridBounds = null;    // { minX, maxX, minY, maxY } in cells
+    var indexed = 0;
+    var fixedIndexed = false; // some indexed element moves with the viewport
+    var dirty = true;
+
+    // Timings reported back to the bridge, at most once a second
+    var stats = { moves: 0, moveMs: 0, maxMoveMs: 0, rebuilds: 0, rebuildMs: 0, fullScans: 0 };
+    var statsTimer = 0;
+
     function isVisible(el) {
         if (!el || !el.getBoundingClientRect) return false;
         var r = el.getBoundingClientRect();
@@ -493,13 +709,105 @@ QString BrowserBridge::navigationScript() {
         return r;
     }
 
-    function scanElements() {
-        var all = document.querySelectorAll(SELECTORS);
-        elements = [];
-        for (var i = 0; i < all.length; i++) {
-            if (isVisible(all[i])) elements.push(all[i]);
+    var intersections = new IntersectionObserver(function(entries) {
+        for (var i = 0; i < entries.length; i++) {
+            if (entries[i].isIntersecting) nearby.add(entries[i].target);
+            else nearby.delete(entries[i].target);
         }
-        if (currentIndex >= elements.length) currentIndex = 0;
+        dirty = true;
+    }, { rootMargin: '100% 50%' });
+
+    function track(el) {
+        if (tracked.has(el)) return;
+        tracked.add(el);
+        intersections.observe(el);
+    }
+
+    function untrack(el) {
+        if (!tracked.delete(el)) return;
+        intersections.unobserve(el);
+        nearby.delete(el);
+        if (el === current) current = null;
+    }
+
+    // el and every matching element below it
+    function eachMatch(el, fn) {
+        if (el.nodeType !== 1) return;
+        if (el.matches(SELECTORS)) fn(el);
+        var all = el.querySelectorAll(SELECTORS);
+        for (var i = 0; i < all.length; i++) fn(all[i]);
+    }
+
+    function cellKey(cx, cy) { return cx + ',' + cy; }
+
+    // Document coordinates
+    function centreOf(el) {
+        var r = getVisualRect(el);
+        return { x: r.left + r.width / 2 + window.scrollX,
+                 y: r.top + r.height / 2 + window.scrollY };
+    }
+
+    // Inside a position:fixed box: its offsetParent chain ends at that box
+    // instead of <body>
+    function isFixed(el) {
+        var p = el;
+        while (p.offsetParent) p = p.offsetParent;
+        return p !== document.body && p !== document.documentElement
+            && window.getComputedStyle(p).position === 'fixed';
+    }
+
+    function rebuildIndex() {
+        var t0 = performance.now();
+        grid = new Map();
+        gridBounds = null;
+        indexed = 0;
+        fixedIndexed = false;
+        nearby.forEach(function(el) {
+            if (!el.isConnected || !isVisible(el)) return;
+            if (!fixedIndexed && isFixed(el)) fixedIndexed = true;
+            var c = centreOf(el);
+            var cx = Math.floor(c.x / CELL), cy = Math.floor(c.y / CELL);
+            var key = cellKey(cx, cy);
+            var bucket = grid.get(key);
+            if (!bucket) grid.set(key, bucket = []);
+            bucket.push({ el: el, x: c.x, y: c.y });
+            indexed++;
+            if (!gridBounds) {
+                gridBounds = { minX: cx, maxX: cx, minY: cy, maxY: cy };
+            } else {
+                gridBounds.minX = Math.min(gridBounds.minX, cx);
+                gridBounds.maxX = Math.max(gridBounds.maxX, cx);
+                gridBounds.minY = Math.min(gridBounds.minY, cy);
+                gridBounds.maxY = Math.max(gridBounds.maxY, cy);
+            }
+        });
+        dirty = false;
+        stats.rebuilds++;
+        stats.rebuildMs += performance.now() - t0;
+    }
+
+    function markDirty() { dirty = true; }
+
+    // Where to start when nothing is focused: the top-left indexed
+    // element, or before the first intersection report, the first
+    // visible one in document order
+    function firstElement() {
+        if (dirty) rebuildIndex();
+        var best = null;
+        var top = window.scrollY, left = window.scrollX;
+        grid.forEach(function(bucket) {
+            for (var i = 0; i < bucket.length; i++) {
+                var e = bucket[i];
+                if (e.y < top || e.x < left) continue;   // above or left of the view
+                if (!best || e.y < best.y || (e.y === best.y && e.x < best.x)) best = e;
+            }
+        });
+        if (best) return best.el;
+        var found = null;
+        tracked.forEach(function(el) {
+            if (!found && isVisible(el)) found = el;
+        });
+        return found;
     }
 
     function createHighlight() {
@@ -514,46 +822,51 @@ QString BrowserBridge::navigationScript() {
         document.documentElement.appendChild(highlightEl);
     }
 
-    function updateHighlight() {
+    function positionHighlight() {
         if (!highlightEl) createHighlight();
-        if (elements.length === 0) {
+        if (!current) {
             highlightEl.style.display = 'none';
             return;
         }
-        var el = elements[currentIndex];
-        if (!el) return;
-        var r = getVisualRect(el);
+        var r = getVisualRect(current);
         var pad = 3;
         highlightEl.style.left   = (r.left - pad) + 'px';
         highlightEl.style.top    = (r.top - pad)  + 'px';
         highlightEl.style.width  = (r.width + pad * 2) + 'px';
         highlightEl.style.height = (r.height + pad * 2) + 'px';
         highlightEl.style.display = 'block';
+    }
 
+    function updateHighlight() {
+        positionHighlight();
         // Scroll element into view if needed
-        el.scrollIntoView({ block: 'nearest', behavior: 'smooth' });
+        if (current) current.scrollIntoView({ block: 'nearest', behavior: 'smooth' });
     }
 
-    // Spatial navigation: find the nearest element in the given direction
+    // DOM changes can move or remove the focused element; follow it on
+    // the next frame without scrolling
+    var highlightFrame = 0;
+    function scheduleHighlight() {
+        if (highlightFrame) return;
+        highlightFrame = requestAnimationFrame(function() {
+            highlightFrame = 0;
+            positionHighlight();
+        });
+    }
+
+    // Spatial navigation: find the nearest element in the given direction.
+    // Cells are searched in rings around the current one, skipping those
+    // behind it, until no unsearched cell can hold anything closer.
     function findNearest(direction) {
-        if (elements.length < 2) return currentIndex;
-        var cur = elements[currentIndex];
-        if (!cur) return currentIndex;
-        var cr = getVisualRect(cur);
-        var cx = cr.left + cr.width / 2;
-        var cy = cr.top + cr.height / 2;
-
-        var bestIdx = -1;
+        if (dirty) rebuildIndex();
+        var c = centreOf(current);
+        var best = null;
         var bestDist = Infinity;
 
-        for (var i = 0; i < elements.length; i++) {
-            if (i === currentIndex) continue;
-            var er = getVisualRect(elements[i]);
-            var ex = er.left + er.width / 2;
-            var ey = er.top + er.height / 2;
-
-            var dx = ex - cx;
-            var dy = ey - cy;
+        function consider(el, ex, ey) {
+            if (el === current) return;
+            var dx = ex - c.x;
+            var dy = ey - c.y;
 
             var inDirection = false;
             switch (direction) {
@@ -562,7 +875,7 @@ QString BrowserBridge::navigationScript() {
                 case 'left':  inDirection = dx < -5; break;
                 case 'right': inDirection = dx > 5;  break;
             }
-            if (!inDirection) continue;
+            if (!inDirection) return;
 
             // Weighted distance: primary axis matters more
             var dist;
@@ -574,24 +887,84 @@ QString BrowserBridge::navigationScript() {
 
             if (dist < bestDist) {
                 bestDist = dist;
-                bestIdx = i;
+                best = el;
+            }
+        }
+
+        if (gridBounds) {
+            var gx = Math.floor(c.x / CELL), gy = Math.floor(c.y / CELL);
+            var maxRing = Math.max(gx - gridBounds.minX, gridBounds.maxX - gx,
+                                   gy - gridBounds.minY, gridBounds.maxY - gy);
+            for (var ring = 0; ring <= maxRing; ring++) {
+                // Anything in this ring is more than (ring - 1) cells away
+                // on some axis, and the weighted distance is at least that
+                if (best && bestDist <= (ring - 1) * CELL) break;
+                for (var i = -ring; i <= ring; i++) {
+                    for (var j = -ring; j <= ring; j++) {
+                        if (Math.max(Math.abs(i), Math.abs(j)) !== ring) continue;
+                        if ((direction === 'up' && j > 0) || (direction === 'down' && j < 0)
+                            || (direction === 'left' && i > 0) || (direction === 'right' && i < 0))
+                            continue;
+                        var bucket = grid.get(cellKey(gx + i, gy + j));
+                        if (!bucket) continue;
+                        for (var k = 0; k < bucket.length; k++)
+                            consider(bucket[k].el, bucket[k].x, bucket[k].y);
+                    }
+                }
             }
         }
 
-        return bestIdx >= 0 ? bestIdx : currentIndex;
+        // Nothing near the viewport that way: look at the whole page
+        if (!best) {
+            stats.fullScans++;
+            tracked.forEach(function(el) {
+                if (nearby.has(el) || !isVisible(el)) return;
+                var e = centreOf(el);
+                consider(el, e.x, e.y);
+            });
+        }
+        return best;
+    }
+
+    function reportStats() {
+        statsTimer = 0;
+        var moves = stats.moves || 1;
+        var rebuilds = stats.rebuilds || 1;
+        console.log('__luna:' + JSON.stringify({
+            event: 'navStats',
+            tracked: tracked.size,
+            nearby: nearby.size,
+            indexed: indexed,
+            cells: grid.size,
+            moves: stats.moves,
+            moveMs: +(stats.moveMs / moves).toFixed(2),
+            maxMoveMs: +stats.maxMoveMs.toFixed(2),
+            rebuilds: stats.rebuilds,
+            rebuildMs: +(stats.rebuildMs / rebuilds).toFixed(2),
+            fullScans: stats.fullScans
+        }));
+        stats = { moves: 0, moveMs: 0, maxMoveMs: 0, rebuilds: 0, rebuildMs: 0, fullScans: 0 };
     }
 
     nav.move = function(direction) {
-        scanElements();
-        if (elements.length === 0) return;
-        currentIndex = findNearest(direction);
+        var t0 = performance.now();
+        if (!current) {
+            current = firstElement();
+        } else {
+            var next = findNearest(direction);
+            if (next) current = next;
+        }
         updateHighlight();
+
+        var ms = performance.now() - t0;
+        stats.moves++;
+        stats.moveMs += ms;
+        stats.maxMoveMs = Math.max(stats.maxMoveMs, ms);
+        if (!statsTimer) statsTimer = setTimeout(reportStats, 1000);
     };
 
     nav.activate = function() {
-        scanElements();
-        if (elements.length === 0) return;
-        var el = elements[currentIndex];
+        var el = current;
         if (!el) return;
 
         var tag = el.tagName.toLowerCase();
@@ -657,25 +1030,62 @@ QString BrowserBridge::navigationScript() {
         }
     }, true);
 
-    // Re-scan when the DOM changes so dynamically-added elements are
-    // picked up automatically (SPAs, lazy-loaded content, etc.).
-    var observer = new MutationObserver(function() {
-        var oldLen = elements.length;
-        scanElements();
-        if (elements.length !== oldLen) {
-            updateHighlight();
+    // Keep the index in step with the DOM so dynamically-added elements
+    // are picked up automatically (SPAs, lazy-loaded content, etc.)
+    // without rescanning the whole document.
+    var observer = new MutationObserver(function(records) {
+        for (var i = 0; i < records.length; i++) {
+            var rec = records[i];
+            if (rec.type === 'childList') {
+                for (var j = 0; j < rec.removedNodes.length; j++)
+                    eachMatch(rec.removedNodes[j], untrack);
+                for (var j = 0; j < rec.addedNodes.length; j++)
+                    eachMatch(rec.addedNodes[j], track);
+            } else if (rec.target.matches(SELECTORS)) {
+                track(rec.target);
+            } else {
+                untrack(rec.target);
+            }
         }
+        markDirty();
+        scheduleHighlight();
     });
-    if (document.body) {
-        observer.observe(document.body, { childList: true, subtree: true });
-    }
 
-    // Initial scan
-    scanElements();
-    if (elements.length > 0) updateHighlight();
+    // Positions are in document coordinates: an inner container's scroll
+    // or a resize moves elements, the window's own scroll (target is the
+    // document) only moves fixed-position ones
+    document.addEventListener('scroll', function(e) {
+        if (e.target !== document || fixedIndexed) dirty = true;
+    }, { capture: true, passive: true });
+    window.addEventListener('resize', markDirty, { passive: true });
+
+    nav.announce = function() {
+        console.log('__luna:' + JSON.stringify({ event: 'ready', count: tracked.size }));
+    };
+
+    function init() {
+        if (window.__lunaNav) return;
+        observer.observe(document.body || document.documentElement, {
+            childList: true, subtree: true, attributes: true,
+            attributeFilter: ['href', 'role', 'tabindex', 'onclick']
+        });
+
+        // Initial scan, the only full query of the document
+        eachMatch(document.body || document.documentElement, track);
+        current = firstElement();
+        if (current) updateHighlight();
 
-    window.__lunaNav = nav;
-    console.log('__luna:' + JSON.stringify({ event: 'ready', count: elements.length }));
+        window.__lunaNav = nav;
+        nav.announce();
+    }
+
+    // Registered scripts run before the document has any content; start
+    // as soon as it is parsed rather than waiting for images and the like
+    if (document.readyState === 'loading') {
+        document.addEventListener('DOMContentLoaded', init, { once: true });
+    } else {
+        init();
+    }
 })();
 )JS");
 }
@@ -6,13 +6,27 @@
 #include <QWebSocket>
 #include <QNetworkAccessManager>
 #include <QTimer>
-#include <QFile>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include "logger.h"
 
 // BrowserBridge — connects to a Chromium-based browser via the Chrome
 // DevTools Protocol (CDP) on localhost:9222.  It injects a JavaScript
 // navigation overlay that lets a game controller highlight & click
 // interactive elements, and detects text-field focus so Luna-UI can
 // show its VirtualKeyboard.
+//
+// Every CDP command is tracked until its response arrives: callers can
+// pass a callback, each command has a deadline, and the round trips feed
+// the diagnostics.  Navigation commands are serialised — while one is in
+// flight, further moves are collected and sent as a single evaluate.
+//
+// The script is registered once per session to run in every new
+// document and announces itself once the DOM is interactive; moves made
+// while a page loads are held until then.
 
 class BrowserBridge : public QObject {
     Q_OBJECT
@@ -24,6 +38,11 @@ class BrowserBridge : public QObject {
     Q_PROPERTY(int actionsDispatched READ actionsDispatched NOTIFY diagnosticsChanged)
     Q_PROPERTY(int cdpCommandsSent READ cdpCommandsSent NOTIFY diagnosticsChanged)
     Q_PROPERTY(int cdpErrors READ cdpErrors NOTIFY diagnosticsChanged)
+    Q_PROPERTY(int cdpPending READ cdpPending NOTIFY diagnosticsChanged)
+    Q_PROPERTY(double cdpRoundTripMs READ cdpRoundTripMs NOTIFY diagnosticsChanged)
+    Q_PROPERTY(double cdpRoundTripP95Ms READ cdpRoundTripP95Ms NOTIFY diagnosticsChanged)
+    Q_PROPERTY(int navElements READ navElements NOTIFY diagnosticsChanged)
+    Q_PROPERTY(double navMoveMs READ navMoveMs NOTIFY diagnosticsChanged)
 
 public:
     explicit BrowserBridge(QObject *parent = nullptr);
@@ -37,6 +56,14 @@ public:
     int actionsDispatched() const { return m_actionsDispatched; }
     int cdpCommandsSent() const { return m_cdpCommandsSent; }
     int cdpErrors() const { return m_cdpErrors; }
+    int cdpPending() const { return m_pending.size(); }
+    // Median / 95th percentile of the recent command round trips
+    double cdpRoundTripMs() const { return roundTripPercentile(0.50); }
+    double cdpRoundTripP95Ms() const { return roundTripPercentile(0.95); }
+    // As last reported by the page: interactive elements indexed and the
+    // average in-page time of a move
+    int navElements() const { return m_navElements; }
+    double navMoveMs() const { return m_navMoveMs; }
 
     // Start trying to connect to the browser's CDP endpoint
     Q_INVOKABLE void connectToBrowser();
@@ -92,7 +119,8 @@ private:
     bool m_connected = false;
     bool m_textFieldFocused = false;
     bool m_active = false;
-    bool m_injected = false;
+    bool m_scriptRegistered = false;   // runs in every new document
+    bool m_pageReady = false;          // __lunaNav is up in the current one
     QString m_wsUrl;          // ws://127.0.0.1:9222/devtools/page/<id>
 
     // Diagnostics
@@ -101,15 +129,53 @@ private:
     int m_actionsDispatched = 0;
     int m_cdpCommandsSent = 0;
     int m_cdpErrors = 0;
-    QFile m_diagLog;
-    void diag(const QString &msg);
+    int m_cdpTimeouts = 0;
+    int m_navElements = 0;
+    double m_navMoveMs = 0;
+    int m_logCategory = -1;
+    void diag(const QString &msg, LogLevel level = LogLevel::Info);
     void updateBrowserDiagOverlay();
 
     void discoverTarget();
-    void injectNavigationScript();
-    int sendCdpCommand(const QString &method, const QJsonObject &params = QJsonObject());
+    void registerNavigationScript();
+    void injectNavigationScript(int contextId = 0);
+
+    // ok is false for protocol errors, script exceptions, timeouts and a
+    // dropped connection; error then says which
+    using CdpCallback = std::function<void(bool ok, const QJsonObject &result,
+                                           const QString &error)>;
+    int sendCdpCommand(const QString &method, const QJsonObject &params = QJsonObject(),
+                       CdpCallback done = CdpCallback(), int timeoutMs = -1);
     void handleCdpEvent(const QJsonObject &msg);
-    void handleCdpResult(int id, const QJsonObject &result);
+    void handleCdpResult(const QJsonObject &msg);
+
+    // Commands awaiting a response, by CDP id
+    struct PendingCommand {
+        QString method;
+        qint64 sentNs;
+        qint64 deadlineMs;   // on m_clock
+        CdpCallback done;
+    };
+    QHash<int, PendingCommand> m_pending;
+    QElapsedTimer m_clock;
+    QTimer m_timeoutTimer;   // fires at the earliest deadline
+    void scheduleTimeouts();
+    void expireCommands();
+    void failPending(const QString &error);
+
+    // Round trips of the last RoundTripSamples responses, in microseconds
+    static constexpr int RoundTripSamples = 256;
+    QVector<qint64> m_roundTripsUs;
+    int m_roundTripNext = 0;
+    void recordRoundTrip(qint64 us);
+    double roundTripPercentile(double q) const;
+
+    // In-page navigation: one Runtime.evaluate in flight at a time, the
+    // calls made meanwhile go out together when it returns
+    bool m_navInFlight = false;
+    QStringList m_navQueue;
+    void queueNavCommand(const QString &call);
+    void flushNavQueue();
 
     // The JavaScript code injected into the browser page
     static QString navigationScript();
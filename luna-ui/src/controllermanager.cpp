@@ -1,52 +1,77 @@
 #include "controllermanager.h"
 #include "database.h"
 #include <QDebug>
-
-// ── Legacy signal dispatch table ─────────────────────────────────────
-
-QHash<QString, void(ControllerManager::*)()> ControllerManager::s_legacySignals = ControllerManager::initLegacySignals();
-
-QHash<QString, void(ControllerManager::*)()> ControllerManager::initLegacySignals() {
-    QHash<QString, void(ControllerManager::*)()> map;
-    map["confirm"]        = &ControllerManager::confirmPressed;
-    map["back"]           = &ControllerManager::backPressed;
-    map["quick_action"]   = &ControllerManager::quickActionPressed;
-    map["search"]         = &ControllerManager::searchPressed;
-    map["settings"]       = &ControllerManager::settingsPressed;
-    map["system_menu"]    = &ControllerManager::systemMenuPressed;
-    map["navigate_up"]    = &ControllerManager::navigateUp;
-    map["navigate_down"]  = &ControllerManager::navigateDown;
-    map["navigate_left"]  = &ControllerManager::navigateLeft;
-    map["navigate_right"] = &ControllerManager::navigateRight;
-    map["previous_tab"]   = &ControllerManager::previousTab;
-    map["next_tab"]       = &ControllerManager::nextTab;
-    map["filters"]        = &ControllerManager::filtersPressed;
-    map["sort"]           = &ControllerManager::sortPressed;
-    map["scroll_up"]      = &ControllerManager::scrollUp;
-    map["scroll_down"]    = &ControllerManager::scrollDown;
-    return map;
+#include <QVector>
+
+// ── Action dispatch table ────────────────────────────────────────────
+
+// Legacy signal and synthetic Qt key for each built-in action, indexed by
+// ProfileResolver::allActions() position (ResolvedInput::actionIndex).
+// The synthetic keys let existing QML Keys.onPressed handlers work.
+struct ActionBinding {
+    void (ControllerManager::*legacySignal)() = nullptr;
+    int qtKey = 0;
+};
+
+static const QVector<ActionBinding> &actionBindings() {
+    static const QVector<ActionBinding> table = []() {
+        const QHash<QString, ActionBinding> byName = {
+            {"confirm",        {&ControllerManager::confirmPressed,     Qt::Key_Return}},
+            {"back",           {&ControllerManager::backPressed,        Qt::Key_Escape}},
+            {"quick_action",   {&ControllerManager::quickActionPressed, Qt::Key_F2}},
+            {"search",         {&ControllerManager::searchPressed,      Qt::Key_F3}},
+            {"settings",       {&ControllerManager::settingsPressed,    Qt::Key_F10}},
+            {"system_menu",    {&ControllerManager::systemMenuPressed,  Qt::Key_F12}},
+            {"navigate_up",    {&ControllerManager::navigateUp,         Qt::Key_Up}},
+            {"navigate_down",  {&ControllerManager::navigateDown,       Qt::Key_Down}},
+            {"navigate_left",  {&ControllerManager::navigateLeft,       Qt::Key_Left}},
+            {"navigate_right", {&ControllerManager::navigateRight,      Qt::Key_Right}},
+            {"previous_tab",   {&ControllerManager::previousTab,        Qt::Key_BracketLeft}},
+            {"next_tab",       {&ControllerManager::nextTab,            Qt::Key_BracketRight}},
+            {"filters",        {&ControllerManager::filtersPressed,     Qt::Key_F5}},
+            {"sort",           {&ControllerManager::sortPressed,        Qt::Key_F6}},
+            {"scroll_up",      {&ControllerManager::scrollUp,           Qt::Key_PageUp}},
+            {"scroll_down",    {&ControllerManager::scrollDown,         Qt::Key_PageDown}},
+            {"jump_previous",  {nullptr,                                Qt::Key_F7}},
+            {"jump_next",      {nullptr,                                Qt::Key_F8}},
+        };
+        QVector<ActionBinding> bindings;
+        for (const QString &action : ProfileResolver::allActions())
+            bindings.append(byName.value(action));
+        return bindings;
+    }();
+    return table;
 }
 
 // ── Constructor / Destructor ─────────────────────────────────────────
 
 ControllerManager::ControllerManager(QObject *parent) : QObject(parent) {
-    m_axisNavCooldown.start();
-    m_triggerCooldown.start();
+    // Every pad holds its own compiled context; recompiles and profile
+    // edits hand each one the fresh table
+    connect(&m_profileResolver, &ProfileResolver::contextChanged,
+            this, &ControllerManager::refreshDeviceProfiles);
+    connect(&m_profileResolver, &ProfileResolver::profilesChanged,
+            this, &ControllerManager::refreshDeviceProfiles);
+
+    m_repeatTimer = new QTimer(this);
+    m_repeatTimer->setSingleShot(true);
+    m_repeatTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_repeatTimer, &QTimer::timeout, this, &ControllerManager::fireRepeats);
+    // Called on the SDL thread; the queue is drained on ours
+    m_input = new InputThread([this]() {
+        QMetaObject::invokeMethod(this, &ControllerManager::drainInput, Qt::QueuedConnection);
+    }, this);
 }
 
 ControllerManager::~ControllerManager() {
-    if (m_controller) {
-        SDL_GameControllerClose(m_controller);
-    }
-    SDL_Quit();
+    m_input->stop();
+    m_input->wait();
 }
 
 // ── Initialization ───────────────────────────────────────────────────
 
 void ControllerManager::initialize() {
-    SDL_Init(SDL_INIT_GAMECONTROLLER);
-    SDL_GameControllerAddMappingsFromFile("/usr/share/luna-ui/gamecontrollerdb.txt");
-    detectControllers();
+    m_input->start();
 }
 
 void ControllerManager::setDatabase(Database *db) {
@@ -59,248 +84,236 @@ void ControllerManager::setDatabase(Database *db) {
 
 // ── Controller Detection ─────────────────────────────────────────────
 
-void ControllerManager::detectControllers() {
-    for (int i = 0; i < SDL_NumJoysticks(); ++i) {
-        if (SDL_IsGameController(i)) {
-            m_controller = SDL_GameControllerOpen(i);
-            if (m_controller) {
-                qDebug() << "Controller connected:" << SDL_GameControllerName(m_controller);
-
-                // Detect controller family
-                ControllerFamily newFamily = detectFamily(m_controller);
-                if (newFamily != m_detectedFamily) {
-                    m_detectedFamily = newFamily;
-                    m_profileResolver.setControllerFamily(m_detectedFamily);
-                    emit controllerFamilyChanged();
-                }
-
-                emit controllerChanged();
-                break;
-            }
+void ControllerManager::applyControllerInfo(int deviceId) {
+    const ControllerInfo info = m_input->controllerInfo(deviceId);
+
+    if (!info.connected) {
+        if (!m_devices.remove(deviceId)) return;
+        // Its held sticks went with it
+        scheduleRepeat();
+        if (m_primaryDevice == deviceId) {
+            m_primaryDevice = -1;
+            if (!m_devices.isEmpty())
+                setPrimaryDevice(m_devices.constBegin().value());
         }
+        emit controllerChanged();
+        return;
     }
-}
-
-ControllerFamily ControllerManager::detectFamily(SDL_GameController *controller) {
-    SDL_GameControllerType type = SDL_GameControllerGetType(controller);
-    switch (type) {
-    case SDL_CONTROLLER_TYPE_XBOX360:
-    case SDL_CONTROLLER_TYPE_XBOXONE:
-        return ControllerFamily::Xbox;
-
-    case SDL_CONTROLLER_TYPE_PS3:
-    case SDL_CONTROLLER_TYPE_PS4:
-    case SDL_CONTROLLER_TYPE_PS5:
-        return ControllerFamily::PlayStation;
 
-    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_PRO:
-    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_LEFT:
-    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_PAIR:
-    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_RIGHT:
-        return ControllerFamily::Switch;
+    Device &device = m_devices[deviceId];
+    device.id = deviceId;
+    device.name = info.name;
+    device.family = info.family;
+    device.profile = m_profileResolver.contextFor(info.family);
+    device.triggerCooldown.start();
+    if (m_primaryDevice < 0 || m_primaryDevice == deviceId)
+        setPrimaryDevice(device);
+    emit controllerChanged();
+}
 
-    case SDL_CONTROLLER_TYPE_AMAZON_LUNA:
-        return ControllerFamily::Luna;
+void ControllerManager::setPrimaryDevice(const Device &device) {
+    const bool changed = device.id != m_primaryDevice;
+    m_primaryDevice = device.id;
 
-    default:
-        // Check name for additional hints
-        const char *name = SDL_GameControllerName(controller);
-        if (name) {
-            QString nameStr = QString::fromUtf8(name).toLower();
-            if (nameStr.contains("xbox") || nameStr.contains("xinput"))
-                return ControllerFamily::Xbox;
-            if (nameStr.contains("playstation") || nameStr.contains("dualshock") || nameStr.contains("dualsense"))
-                return ControllerFamily::PlayStation;
-            if (nameStr.contains("nintendo") || nameStr.contains("switch") || nameStr.contains("pro controller"))
-                return ControllerFamily::Switch;
-            if (nameStr.contains("luna"))
-                return ControllerFamily::Luna;
-        }
-        return ControllerFamily::Generic;
+    // Glyphs and the resolver's own context follow the pad in use
+    if (device.family != m_detectedFamily) {
+        m_detectedFamily = device.family;
+        m_profileResolver.setControllerFamily(m_detectedFamily);
+        emit controllerFamilyChanged();
     }
+    if (changed) emit controllerChanged();
 }
 
-// ── Event Polling ────────────────────────────────────────────────────
-
-void ControllerManager::pollEvents() {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-        case SDL_CONTROLLERBUTTONDOWN:
-            handleButtonPress((SDL_GameControllerButton)event.cbutton.button);
-            break;
-        case SDL_CONTROLLERAXISMOTION:
-            handleAxisMotion((SDL_GameControllerAxis)event.caxis.axis, event.caxis.value);
-            break;
-        case SDL_CONTROLLERDEVICEADDED:
-            detectControllers();
-            break;
-        case SDL_CONTROLLERDEVICEREMOVED:
-            if (m_controller) {
-                SDL_GameControllerClose(m_controller);
-                m_controller = nullptr;
-                emit controllerChanged();
-            }
-            break;
+void ControllerManager::refreshDeviceProfiles() {
+    for (Device &device : m_devices)
+        device.profile = m_profileResolver.contextFor(device.family);
+}
+
+// ── Event Queue ──────────────────────────────────────────────────────
+
+void ControllerManager::drainInput() {
+    m_input->drain([this](const InputEvent &event) {
+        if (event.type == InputEvent::DeviceChanged) {
+            applyControllerInfo(event.device);
+            return;
         }
-    }
+        // Events can still be queued for a pad that was just pulled
+        auto it = m_devices.find(event.device);
+        if (it == m_devices.end()) return;
+
+        m_latency.begin(event.timestampNs);
+        if (event.type == InputEvent::ButtonDown)
+            handleButtonPress(*it, (SDL_GameControllerButton)event.code);
+        else
+            handleAxisMotion(*it, (SDL_GameControllerAxis)event.code, event.value);
+    });
 }
 
 // ── Input Handling ───────────────────────────────────────────────────
 
-void ControllerManager::handleButtonPress(SDL_GameControllerButton button) {
-    QString physicalInput = ProfileResolver::sdlButtonToPositional(button);
-    if (physicalInput.isEmpty()) return;
+void ControllerManager::handleButtonPress(Device &device, SDL_GameControllerButton button) {
+    PhysicalInput input = ProfileResolver::sdlButtonToInput(button);
+    if (input == PhysicalInput::None) return;
+    if (device.id != m_primaryDevice) setPrimaryDevice(device);
 
     // Listening mode — capture the input for remapping UI
     if (m_listening) {
-        emit inputCaptured(physicalInput);
+        emit inputCaptured(ProfileResolver::inputName(input));
         return;
     }
 
-    // Normal mode — resolve through profile cascade
-    QString action = m_profileResolver.resolveAction(physicalInput);
-    if (!action.isEmpty()) {
-        dispatchAction(action);
-    } else if (physicalInput == "stick_left_click") {
+    // Normal mode — resolve through this pad's compiled profile cascade
+    const ResolvedInput &resolved = device.profile->inputs[int(input)];
+    if (!resolved.action.isEmpty()) {
+        dispatchAction(resolved);
+    } else if (input == PhysicalInput::StickLeftClick) {
         // L3 with no profile mapping → send CapsLock for virtual keyboard
         sendSyntheticKey(Qt::Key_CapsLock);
     }
 }
 
-void ControllerManager::handleAxisMotion(SDL_GameControllerAxis axis, int value) {
-    const int NAV_COOLDOWN_MS = 200;
-
-    // Get configurable deadzone from profile parameters
-    QString axisName = ProfileResolver::sdlAxisToPositional(axis);
-    QJsonObject params = m_profileResolver.resolveParameters(axisName);
-    int deadzone = params.value("deadzone").toInt(8000);
-    int threshold = params.value("threshold").toInt(8000);
-
-    // Left stick → directional inputs
-    if (axis == SDL_CONTROLLER_AXIS_LEFTY || axis == SDL_CONTROLLER_AXIS_LEFTX) {
-        if (m_axisNavCooldown.elapsed() < NAV_COOLDOWN_MS) return;
-
-        QString physicalInput;
-        if (axis == SDL_CONTROLLER_AXIS_LEFTY) {
-            if (value < -deadzone) physicalInput = "stick_left_up";
-            else if (value > deadzone) physicalInput = "stick_left_down";
-        } else {
-            if (value < -deadzone) physicalInput = "stick_left_left";
-            else if (value > deadzone) physicalInput = "stick_left_right";
-        }
+void ControllerManager::handleAxisMotion(Device &device, SDL_GameControllerAxis axis, int value) {
+    const int TRIGGER_COOLDOWN_MS = 200;
+
+    // Left stick → directional inputs, right stick → scroll (Y) and
+    // jump (X) inputs, triggers → their own inputs
+    PhysicalInput input;
+    switch (axis) {
+    case SDL_CONTROLLER_AXIS_LEFTY:
+        input = value < 0 ? PhysicalInput::StickLeftUp : PhysicalInput::StickLeftDown;
+        break;
+    case SDL_CONTROLLER_AXIS_LEFTX:
+        input = value < 0 ? PhysicalInput::StickLeftLeft : PhysicalInput::StickLeftRight;
+        break;
+    case SDL_CONTROLLER_AXIS_RIGHTY:
+        input = value < 0 ? PhysicalInput::StickRightUp : PhysicalInput::StickRightDown;
+        break;
+    case SDL_CONTROLLER_AXIS_RIGHTX:
+        input = value < 0 ? PhysicalInput::StickRightLeft : PhysicalInput::StickRightRight;
+        break;
+    case SDL_CONTROLLER_AXIS_TRIGGERLEFT:
+        input = PhysicalInput::TriggerLeft;
+        break;
+    case SDL_CONTROLLER_AXIS_TRIGGERRIGHT:
+        input = PhysicalInput::TriggerRight;
+        break;
+    default:
+        return;
+    }
 
-        if (!physicalInput.isEmpty()) {
-            if (m_listening) {
-                emit inputCaptured(physicalInput);
-                return;
-            }
-            QString action = m_profileResolver.resolveAction(physicalInput);
-            if (!action.isEmpty()) {
-                dispatchAction(action);
-                m_axisNavCooldown.restart();
-            }
+    // Deadzone/threshold come pre-decoded with the direction's mapping
+    // Held locally: becoming the primary pad can swap device.profile
+    const ProfileResolver::ContextPtr profile = device.profile;
+    const ResolvedInput &resolved = profile->inputs[int(input)];
+
+    // Triggers fire once per press, rate-limited
+    if (input == PhysicalInput::TriggerLeft || input == PhysicalInput::TriggerRight) {
+        if (value <= resolved.params.threshold) return;
+        if (device.triggerCooldown.elapsed() <= TRIGGER_COOLDOWN_MS) return;
+        if (device.id != m_primaryDevice) setPrimaryDevice(device);
+        if (m_listening) {
+            emit inputCaptured(ProfileResolver::inputName(input));
+            return;
         }
+        if (resolved.action.isEmpty()) return;
+        dispatchAction(resolved);
+        device.triggerCooldown.restart();
+        return;
     }
 
-    // Right stick → scroll inputs
-    if (axis == SDL_CONTROLLER_AXIS_RIGHTY) {
-        if (m_axisNavCooldown.elapsed() < NAV_COOLDOWN_MS) return;
-
-        QString physicalInput;
-        if (value < -deadzone) physicalInput = "stick_right_up";
-        else if (value > deadzone) physicalInput = "stick_right_down";
-
-        if (!physicalInput.isEmpty()) {
-            if (m_listening) {
-                emit inputCaptured(physicalInput);
-                return;
-            }
-            QString action = m_profileResolver.resolveAction(physicalInput);
-            if (!action.isEmpty()) {
-                dispatchAction(action);
-                m_axisNavCooldown.restart();
-            }
+    // Sticks: fire on entering a direction, then repeat while held.  A held
+    // direction is only released a quarter inside its deadzone, so jitter
+    // at the edge doesn't read as a stream of fresh presses.
+    StickRepeat &stick = device.sticks[axis];
+    const int magnitude = qAbs(value);
+    PhysicalInput held = magnitude > resolved.params.deadzone ? input : PhysicalInput::None;
+    if (held == PhysicalInput::None && input == stick.input
+            && magnitude > resolved.params.deadzone * 3 / 4)
+        held = input;
+
+    stick.value = value;
+    if (held == stick.input) return;   // same direction, only the deflection changed
+
+    stick.input = held;
+    stick.nextNs = 0;
+    if (held != PhysicalInput::None) {
+        if (device.id != m_primaryDevice) setPrimaryDevice(device);
+        if (m_listening) {
+            emit inputCaptured(ProfileResolver::inputName(held));
+        } else if (!resolved.action.isEmpty()) {
+            dispatchAction(resolved);
+            stick.heldSinceNs = InputThread::now();
+            stick.nextNs = stick.heldSinceNs + qint64(resolved.params.repeatDelayMs) * 1000000;
         }
     }
+    scheduleRepeat();
+}
 
-    // Triggers
-    if (axis == SDL_CONTROLLER_AXIS_TRIGGERLEFT && value > threshold) {
-        if (m_triggerCooldown.elapsed() > NAV_COOLDOWN_MS) {
-            QString physicalInput = "trigger_left";
-            if (m_listening) {
-                emit inputCaptured(physicalInput);
-                return;
-            }
-            QString action = m_profileResolver.resolveAction(physicalInput);
-            if (!action.isEmpty()) {
-                dispatchAction(action);
-                m_triggerCooldown.restart();
-            }
+// ── Stick Repeat ─────────────────────────────────────────────────────
+
+qint64 ControllerManager::repeatIntervalNs(const InputParameters &params, int value, qint64 heldNs) {
+    // How far past the deadzone the stick is pushed, 0..1
+    const double range = qMax(1, 32767 - params.deadzone);
+    const double deflection = qBound(0.0, (qAbs(value) - params.deadzone) / range, 1.0);
+    // Holding ramps the rate up from repeat_rate to repeat_max_rate
+    const double ramp = params.repeatAccelMs > 0
+        ? qMin(1.0, heldNs / (params.repeatAccelMs * 1e6)) : 1.0;
+    const double rate = (params.repeatRate + (params.repeatMaxRate - params.repeatRate) * ramp)
+                        * (0.25 + 0.75 * deflection);
+    return qint64(1e9 / qMax(rate, 0.5));
+}
+
+void ControllerManager::scheduleRepeat() {
+    qint64 next = 0;
+    for (const Device &device : std::as_const(m_devices)) {
+        for (const StickRepeat &stick : device.sticks) {
+            if (stick.nextNs && (!next || stick.nextNs < next))
+                next = stick.nextNs;
         }
     }
-    if (axis == SDL_CONTROLLER_AXIS_TRIGGERRIGHT && value > threshold) {
-        if (m_triggerCooldown.elapsed() > NAV_COOLDOWN_MS) {
-            QString physicalInput = "trigger_right";
-            if (m_listening) {
-                emit inputCaptured(physicalInput);
-                return;
-            }
-            QString action = m_profileResolver.resolveAction(physicalInput);
-            if (!action.isEmpty()) {
-                dispatchAction(action);
-                m_triggerCooldown.restart();
+    if (!next) {
+        m_repeatTimer->stop();
+        return;
+    }
+    const qint64 waitMs = (next - InputThread::now()) / 1000000;
+    m_repeatTimer->start(int(qMax<qint64>(0, waitMs)));
+}
+
+void ControllerManager::fireRepeats() {
+    const qint64 now = InputThread::now();
+    for (Device &device : m_devices) {
+        for (StickRepeat &stick : device.sticks) {
+            if (!stick.nextNs || stick.nextNs > now) continue;
+
+            const ProfileResolver::ContextPtr profile = device.profile;
+            const ResolvedInput &resolved = profile->inputs[int(stick.input)];
+            if (m_listening || resolved.action.isEmpty()) {
+                stick.nextNs = 0;
+                continue;
             }
+            // Repeats have no SDL event to measure latency from
+            m_latency.begin(0);
+            dispatchAction(resolved);
+            stick.nextNs = now + repeatIntervalNs(resolved.params, stick.value,
+                                                  now - stick.heldSinceNs);
         }
     }
+    scheduleRepeat();
 }
 
 // ── Action Dispatch ──────────────────────────────────────────────────
 
-void ControllerManager::dispatchAction(const QString &action) {
-    emit actionTriggered(action);
-    emitLegacySignal(action);
-    sendSyntheticKeyEvent(action);
-}
+void ControllerManager::dispatchAction(const ResolvedInput &resolved) {
+    m_latency.resolved();
+    emit actionTriggered(resolved.action);
 
-void ControllerManager::emitLegacySignal(const QString &action) {
-    auto it = s_legacySignals.find(action);
-    if (it != s_legacySignals.end()) {
-        (this->*(it.value()))();
+    const QVector<ActionBinding> &bindings = actionBindings();
+    if (resolved.actionIndex >= 0 && resolved.actionIndex < bindings.size()) {
+        const ActionBinding &binding = bindings[resolved.actionIndex];
+        if (binding.legacySignal) (this->*binding.legacySignal)();
+        if (binding.qtKey) sendSyntheticKey(binding.qtKey);
     }
-}
-
-void ControllerManager::sendSyntheticKeyEvent(const QString &action) {
-    // Map actions to Qt key events so existing QML Keys.onPressed handlers work
-    static const QHash<QString, int> actionToKey = {
-        {"confirm",        Qt::Key_Return},
-        {"back",           Qt::Key_Escape},
-        {"navigate_up",    Qt::Key_Up},
-        {"navigate_down",  Qt::Key_Down},
-        {"navigate_left",  Qt::Key_Left},
-        {"navigate_right", Qt::Key_Right},
-        {"previous_tab",   Qt::Key_BracketLeft},
-        {"next_tab",       Qt::Key_BracketRight},
-        {"search",         Qt::Key_F3},
-        {"settings",       Qt::Key_F10},
-        {"system_menu",    Qt::Key_F12},
-        {"quick_action",   Qt::Key_F2},
-        {"filters",        Qt::Key_F5},
-        {"sort",           Qt::Key_F6},
-        {"scroll_up",      Qt::Key_PageUp},
-        {"scroll_down",    Qt::Key_PageDown},
-    };
-
-    auto it = actionToKey.find(action);
-    if (it == actionToKey.end()) return;
-
-    QObject *focusObj = QGuiApplication::focusObject();
-    if (!focusObj) return;
-
-    QKeyEvent pressEvent(QEvent::KeyPress, it.value(), Qt::NoModifier);
-    QKeyEvent releaseEvent(QEvent::KeyRelease, it.value(), Qt::NoModifier);
-    QGuiApplication::sendEvent(focusObj, &pressEvent);
-    QGuiApplication::sendEvent(focusObj, &releaseEvent);
+    m_latency.dispatched();
 }
 
 void ControllerManager::sendSyntheticKey(int qtKey) {
@@ -334,6 +347,25 @@ void ControllerManager::stopListening() {
     emit listeningChanged();
 }
 
+// ── Record / Replay ──────────────────────────────────────────────────
+
+void ControllerManager::startRecording(const QString &filePath) {
+    m_input->startRecording(filePath);
+}
+
+void ControllerManager::stopRecording() {
+    m_input->stopRecording();
+}
+
+void ControllerManager::startReplay(const QString &filePath) {
+    // Runs on the SDL thread once the last event has played
+    m_input->startReplay(filePath, [this](bool ok) {
+        QMetaObject::invokeMethod(this, [this, ok]() {
+            emit replayFinished(ok);
+        }, Qt::QueuedConnection);
+    });
+}
+
 // ── Display Helpers ──────────────────────────────────────────────────
 
 QString ControllerManager::controllerFamilyName() const {
@@ -341,10 +373,8 @@ QString ControllerManager::controllerFamilyName() const {
 }
 
 QString ControllerManager::controllerName() const {
-    if (m_controller) {
-        return QString::fromUtf8(SDL_GameControllerName(m_controller));
-    }
-    return QString();
+    auto it = m_devices.constFind(m_primaryDevice);
+    return it != m_devices.constEnd() ? it->name : QString();
 }
 
 QString ControllerManager::getButtonDisplayName(const QString &physicalInput) const {
@@ -361,6 +391,7 @@ QString ControllerManager::getButtonDisplayName(const QString &physicalInput) co
             {"stick_left_up", "Left Stick Up"}, {"stick_left_down", "Left Stick Down"},
             {"stick_left_left", "Left Stick Left"}, {"stick_left_right", "Left Stick Right"},
             {"stick_right_up", "Right Stick Up"}, {"stick_right_down", "Right Stick Down"},
+            {"stick_right_left", "Right Stick Left"}, {"stick_right_right", "Right Stick Right"},
         }},
         {"playstation", {
             {"button_south", "\u2715"}, {"button_east", "\u25CB"},
@@ -373,6 +404,7 @@ QString ControllerManager::getButtonDisplayName(const QString &physicalInput) co
             {"stick_left_up", "Left Stick Up"}, {"stick_left_down", "Left Stick Down"},
             {"stick_left_left", "Left Stick Left"}, {"stick_left_right", "Left Stick Right"},
             {"stick_right_up", "Right Stick Up"}, {"stick_right_down", "Right Stick Down"},
+            {"stick_right_left", "Right Stick Left"}, {"stick_right_right", "Right Stick Right"},
         }},
         {"switch", {
             {"button_south", "B"}, {"button_east", "A"},
@@ -385,6 +417,7 @@ QString ControllerManager::getButtonDisplayName(const QString &physicalInput) co
             {"stick_left_up", "Left Stick Up"}, {"stick_left_down", "Left Stick Down"},
             {"stick_left_left", "Left Stick Left"}, {"stick_left_right", "Left Stick Right"},
             {"stick_right_up", "Right Stick Up"}, {"stick_right_down", "Right Stick Down"},
+            {"stick_right_left", "Right Stick Left"}, {"stick_right_right", "Right Stick Right"},
         }},
     };
 
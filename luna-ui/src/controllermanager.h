@@ -3,10 +3,14 @@
 
 #include <QObject>
 #include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
 #include <QGuiApplication>
 #include <QKeyEvent>
 #include <SDL2/SDL.h>
 #include "profileresolver.h"
+#include "inputthread.h"
+#include "inputlatency.h"
 
 class Database;
 
@@ -15,25 +19,29 @@ class ControllerManager : public QObject {
     Q_PROPERTY(QString controllerFamily READ controllerFamilyName NOTIFY controllerFamilyChanged)
     Q_PROPERTY(QString controllerName READ controllerName NOTIFY controllerChanged)
     Q_PROPERTY(bool controllerConnected READ isControllerConnected NOTIFY controllerChanged)
+    Q_PROPERTY(int controllerCount READ controllerCount NOTIFY controllerChanged)
     Q_PROPERTY(bool listeningForInput READ isListeningForInput NOTIFY listeningChanged)
 
 public:
     explicit ControllerManager(QObject *parent = nullptr);
     ~ControllerManager();
 
+    // Start the SDL input thread
     void initialize();
-    void pollEvents();
 
     // Set database for ProfileResolver
     void setDatabase(Database *db);
 
     // Profile resolver access (exposed to QML via context property)
     ProfileResolver* profileResolver() { return &m_profileResolver; }
+    // Input latency histograms (exposed to QML via context property)
+    InputLatency* inputLatency() { return &m_latency; }
 
-    // Controller info
+    // Controller info.  Name and family follow the pad that acted last.
     QString controllerFamilyName() const;
     QString controllerName() const;
-    bool isControllerConnected() const { return m_controller != nullptr; }
+    bool isControllerConnected() const { return !m_devices.isEmpty(); }
+    int controllerCount() const { return m_devices.size(); }
 
     // Context switching for game launch/exit
     Q_INVOKABLE void setGameContext(const QString &clientId, int gameId);
@@ -52,6 +60,12 @@ public:
     Q_INVOKABLE QString getInputForAction(const QString &action) const;
     Q_INVOKABLE QString getDisplayNameForAction(const QString &action) const;
 
+    // Raw controller event recording and replay (see InputThread).  Replay
+    // drives the UI through a virtual pad exactly like a physical one.
+    Q_INVOKABLE void startRecording(const QString &filePath);
+    Q_INVOKABLE void stopRecording();
+    Q_INVOKABLE void startReplay(const QString &filePath);
+
 signals:
     // New unified signal — the primary way to handle controller input
     void actionTriggered(const QString &action);
@@ -63,6 +77,7 @@ signals:
     void controllerChanged();
     void controllerFamilyChanged();
     void listeningChanged();
+    void replayFinished(bool ok);
 
     // Legacy signals — kept during transition, will be removed once QML is fully updated
     void confirmPressed();
@@ -83,26 +98,51 @@ signals:
     void scrollDown();
 
 private:
-    SDL_GameController *m_controller = nullptr;
-    QElapsedTimer m_axisNavCooldown;
-    QElapsedTimer m_triggerCooldown;
+    // SDL runs on m_input; the GUI thread only sees queued events and
+    // ControllerInfo snapshots
+    InputThread *m_input;
+
+    // Stick hold-to-repeat, one slot per stick axis (LEFTX … RIGHTY).
+    // Each axis repeats on its own curve; m_repeatTimer only runs while
+    // a stick is held.
+    struct StickRepeat {
+        PhysicalInput input = PhysicalInput::None;   // held direction
+        int value = 0;                               // latest deflection
+        qint64 heldSinceNs = 0;
+        qint64 nextNs = 0;                           // next repeat, 0 = none
+    };
+
+    // Everything that belongs to one connected pad, keyed by its SDL
+    // instance id.  Two pads of different families resolve through their
+    // own compiled cascade and never share a cooldown or a held stick.
+    struct Device {
+        int id = -1;
+        QString name;
+        ControllerFamily family = ControllerFamily::Generic;
+        ProfileResolver::ContextPtr profile;
+        QElapsedTimer triggerCooldown;
+        StickRepeat sticks[SDL_CONTROLLER_AXIS_TRIGGERLEFT];
+    };
+    QHash<int, Device> m_devices;
+    int m_primaryDevice = -1;   // pad that acted last
+    QTimer *m_repeatTimer;
+    void scheduleRepeat();
+    void fireRepeats();
+    static qint64 repeatIntervalNs(const InputParameters &params, int value, qint64 heldNs);
 
     ProfileResolver m_profileResolver;
+    InputLatency m_latency;
     ControllerFamily m_detectedFamily = ControllerFamily::Generic;
     bool m_listening = false;
 
-    void handleButtonPress(SDL_GameControllerButton button);
-    void handleAxisMotion(SDL_GameControllerAxis axis, int value);
-    void detectControllers();
-    ControllerFamily detectFamily(SDL_GameController *controller);
-    void dispatchAction(const QString &action);
-    void emitLegacySignal(const QString &action);
-    void sendSyntheticKeyEvent(const QString &action);
+    void handleButtonPress(Device &device, SDL_GameControllerButton button);
+    void handleAxisMotion(Device &device, SDL_GameControllerAxis axis, int value);
+    void drainInput();
+    void applyControllerInfo(int deviceId);
+    void setPrimaryDevice(const Device &device);
+    void refreshDeviceProfiles();
+    void dispatchAction(const ResolvedInput &resolved);
     void sendSyntheticKey(int qtKey);
-
-    // Action-to-legacy-signal dispatch table
-    static QHash<QString, void(ControllerManager::*)()> s_legacySignals;
-    static QHash<QString, void(ControllerManager::*)()> initLegacySignals();
 };
 
 #endif
@@ -4,9 +4,26 @@
 #include <QDir>
 #include <QFile>
 #include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTimer>
 #include <QDebug>
 
-Database::Database(QObject *parent) : QObject(parent) {}
+static const int PLACEHOLDER_FLUSH_MS = 500;
+
+Database::Database(QObject *parent)
+    : QObject(parent)
+    , m_placeholderTimer(new QTimer(this))
+{
+    m_placeholderTimer->setSingleShot(true);
+    m_placeholderTimer->setInterval(PLACEHOLDER_FLUSH_MS);
+    connect(m_placeholderTimer, &QTimer::timeout, this, &Database::flushArtworkPlaceholders);
+}
+
+Database::~Database() {
+    flushArtworkPlaceholders();
+}
 
 bool Database::initialize() {
     QString dbDir = QDir::homePath() + "/.local/share/luna-ui";
@@ -92,6 +109,37 @@ void Database::createTables() {
                "'steam -silent steam://rungameid/') "
                "WHERE launch_command LIKE '%nofriendsui%'");
 
+    // Migration: title logo artwork
+    query.exec("ALTER TABLE games ADD COLUMN logo_url TEXT");
+
+    // Migration: cover placeholder colour + low-res preview
+    query.exec("ALTER TABLE games ADD COLUMN dominant_color TEXT");
+    query.exec("ALTER TABLE games ADD COLUMN placeholder_preview TEXT");
+
+    // ProtonDB summaries for the library grid, refreshed in the background
+    query.exec("CREATE TABLE IF NOT EXISTS proton_ratings ("
+               "app_id TEXT PRIMARY KEY,"
+               "tier TEXT,"
+               "confidence TEXT,"
+               "fetched_at INTEGER NOT NULL"
+               ")");
+
+    // Cross-store title identity: lookup keys → canonical games.id
+    query.exec("ALTER TABLE games ADD COLUMN canonical_id INTEGER");
+    query.exec("CREATE TABLE IF NOT EXISTS title_identity ("
+               "key TEXT PRIMARY KEY,"
+               "canonical_id INTEGER NOT NULL"
+               ")");
+
+    // Store price snapshots behind the detail popup, refreshed in the background
+    query.exec("CREATE TABLE IF NOT EXISTS price_snapshots ("
+               "game_key TEXT NOT NULL,"
+               "source TEXT NOT NULL,"
+               "deal TEXT NOT NULL,"
+               "fetched_at INTEGER NOT NULL,"
+               "PRIMARY KEY (game_key, source)"
+               ")");
+
     // FIX #6 + #28: Create FTS sync triggers using proper SQLite syntax
     query.exec("DROP TRIGGER IF EXISTS games_fts_insert");
     query.exec("CREATE TRIGGER games_fts_insert AFTER INSERT ON games BEGIN "
@@ -104,7 +152,9 @@ void Database::createTables() {
                "VALUES('delete', old.id, old.title, old.tags, old.metadata); END;");
 
     query.exec("DROP TRIGGER IF EXISTS games_fts_update");
-    query.exec("CREATE TRIGGER games_fts_update AFTER UPDATE ON games BEGIN "
+    // Only indexed columns re-sync the FTS row; artwork placeholder and
+    // play-time writes leave it alone.
+    query.exec("CREATE TRIGGER games_fts_update AFTER UPDATE OF title, tags, metadata ON games BEGIN "
                "INSERT INTO games_fts(games_fts, rowid, title, tags, metadata) "
                "VALUES('delete', old.id, old.title, old.tags, old.metadata); "
                "INSERT INTO games_fts(rowid, title, tags, metadata) "
@@ -115,9 +165,9 @@ int Database::addGame(const Game& game) {
     QSqlQuery query;
     query.prepare("INSERT INTO games (title, store_source, app_id, install_path, "
                   "executable_path, launch_command, cover_art_url, background_art_url, "
-                  "icon_path, last_played, play_time_hours, is_favorite, is_installed, "
+                  "logo_url, icon_path, last_played, play_time_hours, is_favorite, is_installed, "
                   "is_hidden, tags, metadata) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
     query.addBindValue(game.title);
     query.addBindValue(game.storeSource);
     query.addBindValue(game.appId);
@@ -126,6 +176,7 @@ int Database::addGame(const Game& game) {
     query.addBindValue(game.launchCommand);
     query.addBindValue(game.coverArtUrl);
     query.addBindValue(game.backgroundArtUrl);
+    query.addBindValue(game.logoUrl);
     query.addBindValue(game.iconPath);
     query.addBindValue(game.lastPlayed);
     query.addBindValue(game.playTimeHours);
@@ -148,7 +199,7 @@ bool Database::updateGame(const Game& game) {
     QSqlQuery query;
     query.prepare("UPDATE games SET title=?, store_source=?, app_id=?, install_path=?, "
                   "executable_path=?, launch_command=?, cover_art_url=?, background_art_url=?, "
-                  "icon_path=?, last_played=?, play_time_hours=?, is_favorite=?, is_installed=?, "
+                  "logo_url=?, icon_path=?, last_played=?, play_time_hours=?, is_favorite=?, is_installed=?, "
                   "is_hidden=?, tags=?, metadata=? WHERE id=?");
     query.addBindValue(game.title);
     query.addBindValue(game.storeSource);
@@ -158,6 +209,7 @@ bool Database::updateGame(const Game& game) {
     query.addBindValue(game.launchCommand);
     query.addBindValue(game.coverArtUrl);
     query.addBindValue(game.backgroundArtUrl);
+    query.addBindValue(game.logoUrl);
     query.addBindValue(game.iconPath);
     query.addBindValue(game.lastPlayed);
     query.addBindValue(game.playTimeHours);
@@ -170,6 +222,255 @@ bool Database::updateGame(const Game& game) {
     return query.exec();
 }
 
+void Database::setArtworkPlaceholder(int gameId, const QString& dominantColor, const QString& preview) {
+    m_pendingPlaceholders.insert(gameId, { dominantColor, preview });
+    m_placeholderTimer->start();
+}
+
+bool Database::flushArtworkPlaceholders() {
+    m_placeholderTimer->stop();
+    if (m_pendingPlaceholders.isEmpty() || !m_db.isOpen()) return true;
+
+    m_db.transaction();
+    QSqlQuery query;
+    query.prepare("UPDATE games SET dominant_color = ?, placeholder_preview = ? WHERE id = ?");
+    bool ok = true;
+    for (auto it = m_pendingPlaceholders.cbegin(); it != m_pendingPlaceholders.cend(); ++it) {
+        query.addBindValue(it->dominantColor);
+        query.addBindValue(it->preview);
+        query.addBindValue(it.key());
+        ok = query.exec() && ok;
+    }
+    m_pendingPlaceholders.clear();
+
+    if (!ok) {
+        m_db.rollback();
+        return false;
+    }
+    return m_db.commit();
+}
+
+bool Database::setProtonRating(const QString& steamAppId, const QString& tier, const QString& confidence) {
+    QSqlQuery query;
+    query.prepare("INSERT OR REPLACE INTO proton_ratings (app_id, tier, confidence, fetched_at) "
+                  "VALUES (?, ?, ?, ?)");
+    query.addBindValue(steamAppId);
+    query.addBindValue(tier);
+    query.addBindValue(confidence);
+    query.addBindValue(QDateTime::currentSecsSinceEpoch());
+    return query.exec();
+}
+
+QHash<QString, QString> Database::getProtonTiers() {
+    QSqlQuery query("SELECT app_id, tier FROM proton_ratings WHERE tier != ''");
+    QHash<QString, QString> tiers;
+    while (query.next()) {
+        tiers.insert(query.value(0).toString(), query.value(1).toString());
+    }
+    return tiers;
+}
+
+QStringList Database::getSteamAppIdsNeedingProtonRating(qint64 maxAgeSecs) {
+    // Missing or expired ratings; installed and recently played games first
+    QSqlQuery query;
+    query.prepare("SELECT games.app_id FROM games "
+                  "LEFT JOIN proton_ratings ON proton_ratings.app_id = games.app_id "
+                  "WHERE games.store_source = 'steam' AND games.app_id != '' "
+                  "AND games.is_hidden = 0 "
+                  "AND (proton_ratings.app_id IS NULL OR proton_ratings.fetched_at < ?) "
+                  "ORDER BY games.is_installed DESC, games.last_played DESC");
+    query.addBindValue(QDateTime::currentSecsSinceEpoch() - maxAgeSecs);
+    query.exec();
+    QStringList appIds;
+    while (query.next()) {
+        appIds.append(query.value(0).toString());
+    }
+    return appIds;
+}
+
+bool Database::setPriceSnapshot(const QString& gameKey, const QVariantList& deals) {
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    m_db.transaction();
+
+    QSqlQuery query;
+    query.prepare("DELETE FROM price_snapshots WHERE game_key = ?");
+    query.addBindValue(gameKey);
+    bool ok = query.exec();
+
+    query.prepare("INSERT OR REPLACE INTO price_snapshots (game_key, source, deal, fetched_at) "
+                  "VALUES (?, ?, ?, ?)");
+    auto insert = [&](const QString& source, const QByteArray& deal) {
+        query.addBindValue(gameKey);
+        query.addBindValue(source);
+        query.addBindValue(QString::fromUtf8(deal));
+        query.addBindValue(now);
+        ok = query.exec() && ok;
+    };
+    insert(QString(), "{}");
+    for (const QVariant& deal : deals) {
+        const QVariantMap map = deal.toMap();
+        insert(map["source"].toString(),
+               QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact));
+    }
+
+    if (!ok) {
+        m_db.rollback();
+        return false;
+    }
+    return m_db.commit();
+}
+
+bool Database::getPriceSnapshot(const QString& gameKey, QVariantList *deals, qint64 *fetchedAt) {
+    QSqlQuery query;
+    query.prepare("SELECT source, deal, fetched_at FROM price_snapshots "
+                  "WHERE game_key = ? ORDER BY source");
+    query.addBindValue(gameKey);
+    query.exec();
+
+    bool found = false;
+    deals->clear();
+    while (query.next()) {
+        found = true;
+        if (query.value(0).toString().isEmpty()) {
+            *fetchedAt = query.value(2).toLongLong();
+            continue;
+        }
+        deals->append(QJsonDocument::fromJson(query.value(1).toString().toUtf8())
+                          .object().toVariantMap());
+    }
+    return found;
+}
+
+bool Database::setGameMetadata(int gameId, const QString& metadata, const QString& tags) {
+    QSqlQuery query;
+    query.prepare("UPDATE games SET metadata = ?, tags = ? WHERE id = ? OR canonical_id = ?");
+    query.addBindValue(metadata);
+    query.addBindValue(tags);
+    query.addBindValue(gameId);
+    query.addBindValue(gameId);
+    return query.exec();
+}
+
+QVector<Game> Database::getGamesNeedingMetadata() {
+    QSqlQuery query("SELECT * FROM games WHERE (metadata IS NULL OR metadata = '') "
+                    "AND (canonical_id IS NULL OR canonical_id = id) "
+                    "AND is_hidden = 0 ORDER BY is_installed DESC, last_played DESC, title ASC");
+    QVector<Game> games;
+    while (query.next()) {
+        games.append(gameFromQuery(query));
+    }
+    return games;
+}
+
+// ─── Title identity ───
+
+QString Database::normalizeTitle(const QString& title) {
+    QString norm = title.toLower().trimmed();
+    // Remove common suffixes/prefixes, punctuation
+    norm.remove(QRegularExpression("[^a-z0-9 ]"));
+    // Collapse whitespace
+    norm = norm.simplified();
+    return norm;
+}
+
+void Database::rebuildTitleIdentity() {
+    // Oldest row first, so a game keeps its canonical row when the same
+    // title later shows up from another store
+    QSqlQuery query("SELECT id, title, store_source, app_id, metadata, canonical_id "
+                    "FROM games ORDER BY id");
+    QHash<QString, int> index;
+    QHash<int, int> canonicalOf;
+    QHash<int, QHash<QString, QString>> groupIds;   // canonical → "steam"/"igdb" → key
+    QList<int> split;
+    while (query.next()) {
+        const int id = query.value(0).toInt();
+        // Steam and IGDB ids first: they identify the game outright
+        QStringList keys;
+        const QString appId = query.value(3).toString();
+        if (query.value(2).toString() == "steam" && !appId.isEmpty())
+            keys.append("steam:" + appId);
+        const int igdbId = QJsonDocument::fromJson(query.value(4).toString().toUtf8())
+                               .object()["igdbId"].toInt();
+        if (igdbId > 0)
+            keys.append("igdb:" + QString::number(igdbId));
+        const QString norm = normalizeTitle(query.value(1).toString());
+        if (!norm.isEmpty())
+            keys.append("title:" + norm);
+
+        // A group whose Steam/IGDB id differs from ours is another game,
+        // however its title or inherited metadata matches
+        auto conflicts = [&](int group) {
+            const QHash<QString, QString> ids = groupIds.value(group);
+            for (const QString& key : keys) {
+                const QString kind = key.section(':', 0, 0);
+                if (ids.contains(kind) && ids.value(kind) != key)
+                    return true;
+            }
+            return false;
+        };
+
+        int canonical = id;
+        for (const QString& key : keys) {
+            auto it = index.constFind(key);
+            if (it != index.constEnd() && !conflicts(it.value())) {
+                canonical = it.value();
+                break;
+            }
+        }
+        for (const QString& key : keys) {
+            if (!index.contains(key))
+                index.insert(key, canonical);
+            const QString kind = key.section(':', 0, 0);
+            if (kind != "title" && !groupIds[canonical].contains(kind))
+                groupIds[canonical].insert(kind, key);
+        }
+        canonicalOf.insert(id, canonical);
+
+        const int previous = query.value(5).toInt();
+        if (previous > 0 && previous != id && canonical == id)
+            split.append(id);
+    }
+
+    m_db.transaction();
+    QSqlQuery write;
+    write.exec("DELETE FROM title_identity");
+    write.prepare("INSERT INTO title_identity (key, canonical_id) VALUES (?, ?)");
+    for (auto it = index.cbegin(); it != index.cend(); ++it) {
+        write.addBindValue(it.key());
+        write.addBindValue(it.value());
+        write.exec();
+    }
+    write.prepare("UPDATE games SET canonical_id = ? WHERE id = ? AND canonical_id IS NOT ?");
+    for (auto it = canonicalOf.cbegin(); it != canonicalOf.cend(); ++it) {
+        write.addBindValue(it.value());
+        write.addBindValue(it.key());
+        write.addBindValue(it.value());
+        write.exec();
+    }
+    // Rows split off a merge lose the metadata they inherited, so
+    // enrichment looks them up on their own
+    write.prepare("UPDATE games SET metadata = '', tags = '' WHERE id = ?");
+    for (int id : split) {
+        write.addBindValue(id);
+        write.exec();
+    }
+    // Duplicates inherit metadata the canonical row already has
+    write.exec("UPDATE games SET "
+               "metadata = (SELECT c.metadata FROM games c WHERE c.id = games.canonical_id), "
+               "tags = (SELECT c.tags FROM games c WHERE c.id = games.canonical_id) "
+               "WHERE canonical_id != id AND (metadata IS NULL OR metadata = '')");
+    m_db.commit();
+}
+
+QHash<QString, int> Database::getTitleIdentityIndex() {
+    QSqlQuery query("SELECT key, canonical_id FROM title_identity");
+    QHash<QString, int> index;
+    while (query.next()) {
+        index.insert(query.value(0).toString(), query.value(1).toInt());
+    }
+    return index;
+}
+
 bool Database::removeGame(int gameId) {
     QSqlQuery query;
     query.prepare("DELETE FROM games WHERE id = ?");
@@ -225,6 +526,13 @@ int Database::addOrUpdateGame(const Game& game) {
         if (existing.playTimeHours > game.playTimeHours) {
             updated.playTimeHours = existing.playTimeHours;
         }
+        // Backends don't supply metadata/tags; keep what enrichment stored
+        if (game.metadata.isEmpty()) {
+            updated.metadata = existing.metadata;
+        }
+        if (game.tags.isEmpty()) {
+            updated.tags = existing.tags;
+        }
         updateGame(updated);
         return existing.id;
     }
@@ -232,6 +540,7 @@ int Database::addOrUpdateGame(const Game& game) {
 }
 
 QVector<Game> Database::getAllGames() {
+    flushArtworkPlaceholders();
     // Show all owned games: installed first, then uninstalled, alphabetical within each group
     QSqlQuery query("SELECT * FROM games WHERE is_hidden = 0 ORDER BY is_installed DESC, title ASC");
     QVector<Game> games;
@@ -286,6 +595,32 @@ QVector<Game> Database::searchGames(const QString& searchQuery) {
     return games;
 }
 
+QVector<Game> Database::searchGameTitles(const QString& text, int limit) {
+    // Each word becomes a quoted prefix term so user input can't break
+    // the FTS5 query syntax: cyber pun → title : "cyber"* AND title : "pun"*
+    QStringList terms;
+    for (QString word : text.split(' ', Qt::SkipEmptyParts)) {
+        word.remove('"');
+        if (!word.isEmpty())
+            terms.append("title : \"" + word + "\"*");
+    }
+    if (terms.isEmpty()) return {};
+
+    QSqlQuery query;
+    query.prepare("SELECT games.* FROM games "
+                  "JOIN games_fts ON games.id = games_fts.rowid "
+                  "WHERE games_fts MATCH ? AND games.is_hidden = 0 "
+                  "ORDER BY rank LIMIT ?");
+    query.addBindValue(terms.join(" AND "));
+    query.addBindValue(limit);
+    query.exec();
+    QVector<Game> games;
+    while (query.next()) {
+        games.append(gameFromQuery(query));
+    }
+    return games;
+}
+
 QVector<Game> Database::getGamesByStore(const QString& store) {
     QSqlQuery query;
     query.prepare("SELECT * FROM games WHERE store_source = ? AND is_hidden = 0 ORDER BY title ASC");
@@ -380,6 +715,7 @@ Game Database::gameFromQuery(const QSqlQuery& query) {
     g.launchCommand = query.value("launch_command").toString();
     g.coverArtUrl = query.value("cover_art_url").toString();
     g.backgroundArtUrl = query.value("background_art_url").toString();
+    g.logoUrl = query.value("logo_url").toString();
     g.iconPath = query.value("icon_path").toString();
     g.lastPlayed = query.value("last_played").toLongLong();
     g.playTimeHours = query.value("play_time_hours").toInt();
@@ -388,5 +724,8 @@ Game Database::gameFromQuery(const QSqlQuery& query) {
     g.isHidden = query.value("is_hidden").toBool();
     g.tags = query.value("tags").toString();
     g.metadata = query.value("metadata").toString();
+    g.dominantColor = query.value("dominant_color").toString();
+    g.placeholderPreview = query.value("placeholder_preview").toString();
+    g.canonicalId = query.value("canonical_id").toInt();
     return g;
 }
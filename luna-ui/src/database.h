@@ -5,6 +5,11 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>      // FIX #33: Include QSqlQuery in header
 #include <QVector>
+#include <QHash>
+#include <QStringList>
+#include <QVariantList>
+
+class QTimer;
 
 struct Game {
     int id = 0;
@@ -15,7 +20,8 @@ struct Game {
     QString executablePath;
     QString launchCommand;
     QString coverArtUrl;
-    QString backgroundArtUrl;
+    QString backgroundArtUrl;   // wide hero/backdrop art
+    QString logoUrl;            // transparent title logo
     QString iconPath;
     qint64 lastPlayed = 0;
     int playTimeHours = 0;
@@ -24,6 +30,9 @@ struct Game {
     bool isHidden = false;
     QString tags;       // JSON array string
     QString metadata;   // JSON object string
+    QString dominantColor;       // "#rrggbb" of the cover, empty until computed
+    QString placeholderPreview;  // base64url low-res cover preview
+    int canonicalId = 0;         // row metadata/artwork are shared from (same title, other store)
 };
 
 struct GameSession {
@@ -38,6 +47,7 @@ class Database : public QObject {
     Q_OBJECT
 public:
     explicit Database(QObject *parent = nullptr);
+    ~Database();
     bool initialize();
 
     // Game CRUD
@@ -52,8 +62,45 @@ public:
     QVector<Game> getFavoriteGames();
     QVector<Game> getRecentlyPlayed(int limit = 10);
     QVector<Game> searchGames(const QString& query);
+    // Prefix match on titles only; takes raw user input
+    QVector<Game> searchGameTitles(const QString& text, int limit);
     QVector<Game> getGamesByStore(const QString& store);
 
+    // Cover placeholders are derived data, written by the artwork pipeline
+    // rather than the store backends, so they stay out of updateGame().
+    // They arrive one per decoded cover, so they are buffered and written
+    // in one transaction shortly after the last one (or before the next
+    // getAllGames()).
+    void setArtworkPlaceholder(int gameId, const QString& dominantColor, const QString& preview);
+    bool flushArtworkPlaceholders();
+
+    // ProtonDB compatibility, cached per Steam appId.  An empty tier
+    // records "no reports yet" so the prefetch doesn't ask again until
+    // the entry expires.
+    bool setProtonRating(const QString& steamAppId, const QString& tier, const QString& confidence);
+    QHash<QString, QString> getProtonTiers();   // appId → tier
+    QStringList getSteamAppIdsNeedingProtonRating(qint64 maxAgeSecs);
+
+    // Scraped store prices (Steam, GOG, Epic, GMG, Itch) per game key and
+    // source.  A scrape replaces the game's rows as a whole; the row with
+    // an empty source records when it ran, even if no store had a price.
+    bool setPriceSnapshot(const QString& gameKey, const QVariantList& deals);
+    bool getPriceSnapshot(const QString& gameKey, QVariantList *deals, qint64 *fetchedAt);
+
+    // Cross-store title identity.  Each library row maps its normalized
+    // title, Steam appId and IGDB id to a canonical row (the oldest one
+    // sharing any of them), so the same game owned on several stores is
+    // enriched and downloaded once.  Rebuilt after each library change.
+    static QString normalizeTitle(const QString& title);
+    void rebuildTitleIdentity();
+    QHash<QString, int> getTitleIdentityIndex();   // "title:…"/"steam:…"/"igdb:…" → canonical id
+
+    // Library metadata enrichment (IGDB).  A row counts as done once its
+    // metadata is non-empty, which is what makes the job resumable.  Only
+    // canonical rows are returned; the metadata is copied to the others.
+    bool setGameMetadata(int gameId, const QString& metadata, const QString& tags);
+    QVector<Game> getGamesNeedingMetadata();
+
     // Session tracking
     int startGameSession(int gameId);
     void endGameSession(int sessionId);
@@ -64,6 +111,13 @@ public:
 
 private:
     QSqlDatabase m_db;
+
+    struct Placeholder {
+        QString dominantColor;
+        QString preview;
+    };
+    QHash<int, Placeholder> m_pendingPlaceholders;   // gameId → latest
+    QTimer *m_placeholderTimer;
     void createTables();
     Game gameFromQuery(const QSqlQuery& query);
 };
@@ -0,0 +1,250 @@
+#include "dealsmodel.h"
+#include "storeapimanager.h"
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cstdlib>
+
+// Keys of the CheapShark deal maps exposed as roles, in role order
+static const QList<QByteArray> DEAL_ROLES = {
+    "dealID", "title", "salePrice", "normalPrice", "savings",
+    "metacriticScore", "steamRatingText", "steamRatingPercent", "steamAppID",
+    "gameID", "storeID", "dealRating", "releaseDate", "thumb",
+    "headerImage", "heroImage", "capsuleImage", "owned", "libraryGameId"
+};
+static const int FIRST_DEAL_ROLE = Qt::UserRole + 1;
+// Whole map and "page is resident" flag come after the per-key roles
+static const int DEAL_ROLE   = FIRST_DEAL_ROLE + 100;
+static const int LOADED_ROLE = FIRST_DEAL_ROLE + 101;
+
+DealsModel::DealsModel(StoreApiManager *api, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_api(api)
+    , m_windowTimer(new QTimer(this))
+{
+    // data() only records which page the view is reading; the window
+    // is moved once per event loop pass, not once per row
+    m_windowTimer->setSingleShot(true);
+    m_windowTimer->setInterval(0);
+    connect(m_windowTimer, &QTimer::timeout, this, &DealsModel::updateWindow);
+
+    connect(m_api, &StoreApiManager::dealsPageReady, this, &DealsModel::onPageReady);
+    connect(m_api, &StoreApiManager::dealsPageError, this, &DealsModel::onPageError);
+}
+
+// ─── Model interface ───
+
+int DealsModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant DealsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount)
+        return QVariant();
+
+    const int page = pageForRow(index.row());
+    if (page != m_focusPage || index.row() >= m_rowCount - PageSize) {
+        m_focusPage = page;
+        m_windowTimer->start();
+    }
+
+    auto it = m_pages.constFind(page);
+    if (role == LOADED_ROLE)
+        return it != m_pages.constEnd();
+
+    const QVariantMap deal = dealAt(index.row());
+    if (role == DEAL_ROLE)
+        return deal;
+    const int key = role - FIRST_DEAL_ROLE;
+    if (key < 0 || key >= DEAL_ROLES.size())
+        return QVariant();
+    return deal.value(QString::fromLatin1(DEAL_ROLES[key]));
+}
+
+QHash<int, QByteArray> DealsModel::roleNames() const
+{
+    QHash<int, QByteArray> names;
+    for (int i = 0; i < DEAL_ROLES.size(); i++)
+        names.insert(FIRST_DEAL_ROLE + i, DEAL_ROLES[i]);
+    names.insert(DEAL_ROLE, "deal");
+    names.insert(LOADED_ROLE, "loaded");
+    return names;
+}
+
+bool DealsModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && !m_atEnd && !m_requested.contains(m_pageStart.size());
+}
+
+void DealsModel::fetchMore(const QModelIndex& parent)
+{
+    if (canFetchMore(parent))
+        requestPage(m_pageStart.size());
+}
+
+QVariantMap DealsModel::get(int row) const
+{
+    if (row < 0 || row >= m_rowCount) return QVariantMap();
+    return dealAt(row);
+}
+
+// ─── Paging ───
+
+void DealsModel::setSortBy(const QString& sortBy)
+{
+    if (m_sortBy == sortBy) return;
+    m_sortBy = sortBy;
+    emit sortByChanged();
+    reload();
+}
+
+void DealsModel::reload()
+{
+    const bool wasLoading = isLoading();
+    beginResetModel();
+    m_pageStart.clear();
+    m_pages.clear();
+    m_requested.clear();
+    m_rowCount = 0;
+    m_atEnd = false;
+    m_focusPage = 0;
+    endResetModel();
+    emit countChanged();
+    if (wasLoading) emit loadingChanged();
+
+    if (!m_error.isEmpty()) {
+        m_error.clear();
+        emit errorChanged();
+    }
+    requestPage(0);
+}
+
+int DealsModel::pageForRow(int row) const
+{
+    auto it = std::upper_bound(m_pageStart.cbegin(), m_pageStart.cend(), row);
+    return int(it - m_pageStart.cbegin()) - 1;
+}
+
+int DealsModel::pageRowCount(int page) const
+{
+    const int end = page + 1 < m_pageStart.size() ? m_pageStart[page + 1] : m_rowCount;
+    return end - m_pageStart[page];
+}
+
+QVariantMap DealsModel::dealAt(int row) const
+{
+    const int page = pageForRow(row);
+    const QVariantList deals = m_pages.value(page);
+    const int offset = row - m_pageStart[page];
+    return offset < deals.size() ? deals[offset].toMap() : QVariantMap();
+}
+
+void DealsModel::requestPage(int page)
+{
+    if (m_requested.contains(page)) return;
+    const bool wasLoading = isLoading();
+    m_requested.insert(page);
+    if (!wasLoading) emit loadingChanged();
+    m_api->fetchDeals(m_sortBy, page, PageSize);
+}
+
+void DealsModel::updateWindow()
+{
+    // Bring back dropped pages around the one being read
+    const int known = m_pageStart.size();
+    for (int page = qMax(0, m_focusPage - 1); page <= qMin(known - 1, m_focusPage + 1); page++) {
+        if (!m_pages.contains(page))
+            requestPage(page);
+    }
+
+    // Prefetch: the view is within a page of the end
+    if (!m_atEnd && m_focusPage >= known - 2)
+        requestPage(known);
+}
+
+void DealsModel::evictFarPages()
+{
+    while (m_pages.size() > MaxResidentPages) {
+        int farthest = -1;
+        for (auto it = m_pages.cbegin(); it != m_pages.cend(); ++it) {
+            if (it.key() == 0) continue;   // the hero banner features page 0
+            if (farthest < 0 || std::abs(it.key() - m_focusPage) > std::abs(farthest - m_focusPage))
+                farthest = it.key();
+        }
+        m_pages.remove(farthest);
+        const int first = m_pageStart[farthest];
+        emit dataChanged(index(first), index(first + pageRowCount(farthest) - 1));
+    }
+}
+
+void DealsModel::onPageReady(const QString& sortBy, int page, const QVariantList& deals)
+{
+    // Replies for another sort, or for a page nobody asked for (e.g. a
+    // fetchDeals() call from elsewhere), are not ours
+    if (sortBy != m_sortBy || !m_requested.remove(page))
+        return;
+
+    if (page == m_pageStart.size()) {
+        if (deals.isEmpty()) {
+            m_atEnd = true;
+        } else {
+            beginInsertRows(QModelIndex(), m_rowCount, m_rowCount + deals.size() - 1);
+            m_pageStart.append(m_rowCount);
+            m_rowCount += deals.size();
+            m_pages.insert(page, deals);
+            endInsertRows();
+            emit countChanged();
+        }
+    } else if (page < m_pageStart.size()) {
+        // A dropped page coming back keeps its rows; if the list moved on
+        // in the meantime, extra deals are cut and missing ones stay blank
+        const int rows = pageRowCount(page);
+        m_pages.insert(page, deals.mid(0, rows));
+        const int first = m_pageStart[page];
+        emit dataChanged(index(first), index(first + rows - 1));
+    }
+
+    if (!m_error.isEmpty()) {
+        m_error.clear();
+        emit errorChanged();
+    }
+    evictFarPages();
+    if (!isLoading()) emit loadingChanged();
+}
+
+void DealsModel::onPageError(const QString& sortBy, int page, const QString& error)
+{
+    if (sortBy != m_sortBy || !m_requested.remove(page))
+        return;
+
+    qWarning() << "DealsModel: page" << page << "failed:" << error;
+    m_error = error;
+    emit errorChanged();
+    if (!isLoading()) emit loadingChanged();
+}
+
+// ─── Grid view ───
+
+DealsGridModel::DealsGridModel(DealsModel *deals, QObject *parent)
+    : QSortFilterProxyModel(parent)
+    , m_deals(deals)
+{
+    // A new sort resets DealsModel, which re-runs the filter
+    setSourceModel(deals);
+    connect(this, &QAbstractItemModel::rowsInserted, this, &DealsGridModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &DealsGridModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &DealsGridModel::countChanged);
+}
+
+QVariantMap DealsGridModel::get(int row) const
+{
+    const QModelIndex source = mapToSource(index(row, 0));
+    return source.isValid() ? m_deals->get(source.row()) : QVariantMap();
+}
+
+bool DealsGridModel::filterAcceptsRow(int sourceRow, const QModelIndex&) const
+{
+    return sourceRow != 0 || m_deals->sortBy() != QLatin1String("Deal Rating");
+}
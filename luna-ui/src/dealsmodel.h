@@ -0,0 +1,106 @@
+#ifndef DEALSMODEL_H
+#define DEALSMODEL_H
+
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+class QTimer;
+class StoreApiManager;
+
+// CheapShark deals as one endless list for the store's deals grid.
+//
+// Rows are only indexes: a page's deals are held while it is near the
+// rows the view is reading and dropped once it scrolls far away, so
+// memory stays flat however far the user scrolls.  A dropped page that
+// comes back into view is requested again, which is normally a response
+// cache hit.  The next page is requested as soon as the view reads
+// within a page of the end, before it asks for fetchMore().
+class DealsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(QString sortBy READ sortBy WRITE setSortBy NOTIFY sortByChanged)
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+    Q_PROPERTY(QString error READ error NOTIFY errorChanged)
+public:
+    explicit DealsModel(StoreApiManager *api, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    QString sortBy() const { return m_sortBy; }
+    void setSortBy(const QString& sortBy);
+    bool isLoading() const { return !m_requested.isEmpty(); }
+    QString error() const { return m_error; }
+
+    // Whole deal map for the detail popup; empty while the row's page is
+    // not resident
+    Q_INVOKABLE QVariantMap get(int row) const;
+    // Drop everything and start again from the first page
+    Q_INVOKABLE void reload();
+
+signals:
+    void countChanged();
+    void sortByChanged();
+    void loadingChanged();
+    void errorChanged();
+
+private:
+    static constexpr int PageSize = 30;
+    // A screenful plus the view's cache buffer in both directions
+    static constexpr int MaxResidentPages = 6;
+
+    StoreApiManager *m_api;
+    QString m_sortBy = "Deal Rating";
+    QVector<int> m_pageStart;          // first row of each page seen so far
+    int m_rowCount = 0;
+    bool m_atEnd = false;
+    QHash<int, QVariantList> m_pages;  // resident pages
+    QSet<int> m_requested;             // pages in flight
+    QString m_error;
+
+    // Last page data() was asked for; the window follows it
+    mutable int m_focusPage = 0;
+    QTimer *m_windowTimer;
+
+    int pageForRow(int row) const;
+    int pageRowCount(int page) const;
+    QVariantMap dealAt(int row) const;
+    void requestPage(int page);
+    void updateWindow();
+    void evictFarPages();
+    void onPageReady(const QString& sortBy, int page, const QVariantList& deals);
+    void onPageError(const QString& sortBy, int page, const QString& error);
+};
+
+// The deals grid's rows.  Sorted by deal rating, the first deal is the
+// one the hero banner features, so the grid starts at the second; the
+// grid's keyboard focus and get() both index these rows.
+class DealsGridModel : public QSortFilterProxyModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+public:
+    explicit DealsGridModel(DealsModel *deals, QObject *parent = nullptr);
+
+    int count() const { return rowCount(); }
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+signals:
+    void countChanged();
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    DealsModel *m_deals;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "storebackends/epicbackend.h"
 #include "storebackends/lutrisbackend.h"
 #include "storebackends/custombackend.h"
+#include "logger.h"
 #include <QProcess>
 #include <QDebug>
 #include <QVariantMap>
@@ -25,6 +26,13 @@
 #include <memory>
 #include <unistd.h>
 
+// steamcmd-setup.log, shared by the setup login flow and its controls
+static int steamCmdLogCategory() {
+    static const int category = Logger::instance().registerCategory(
+        "steamcmd", QDir::homePath() + "/.config/luna-ui/steamcmd-setup.log");
+    return category;
+}
+
 GameManager::GameManager(Database *db, QObject *parent)
     : QObject(parent), m_db(db) {
     registerBackends();
@@ -103,6 +111,10 @@ void GameManager::launchGame(int gameId) {
     // Start session tracking
     m_activeSessionId = m_db->startGameSession(gameId);
     m_activeGameId = gameId;
+    m_activeGamePath = !game.installPath.isEmpty()
+        ? game.installPath : QFileInfo(game.executablePath).absolutePath();
+    m_activeGameSeen = false;
+    m_activeLaunchedAt = QDateTime::currentMSecsSinceEpoch();
 
     // Get appropriate backend and launch
     StoreBackend* backend = getBackendForGame(game);
@@ -122,14 +134,52 @@ void GameManager::launchGame(int gameId) {
     }
 }
 
+// Launchers (Steam, Heroic, Lutris, xdg-open) start the game themselves,
+// so there is no PID to follow.  Instead the game counts as running while
+// some process has its directory on the command line, which covers native
+// binaries, Proton/Wine and Steam's reaper.  It has exited once it was seen
+// and is gone again; a game that never shows up within
+// GAME_START_TIMEOUT_MS (no usable path, or a launcher that failed
+// quietly) is given up on.
+static const qint64 GAME_START_TIMEOUT_MS = 90 * 1000;
+
+bool GameManager::isPathInUse(const QString& path) {
+    if (path.length() <= 1) return false;
+    const QByteArray needle = QDir::cleanPath(path).toUtf8();
+    const QString self = QString::number(QCoreApplication::applicationPid());
+    const QStringList pids = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& pid : pids) {
+        if (pid == self || !pid.at(0).isDigit()) continue;
+        QFile cmdline("/proc/" + pid + "/cmdline");
+        if (cmdline.open(QIODevice::ReadOnly) && cmdline.readAll().contains(needle))
+            return true;
+    }
+    return false;
+}
+
 void GameManager::monitorGameProcess() {
-    // Check if game is still running
-    // In full implementation, track the PID from the launch.
-    // For now, this is a placeholder that runs on a timer.
-    // When game exit is detected:
-    if (m_activeSessionId >= 0) {
-        // TODO: Implement actual process monitoring via PID tracking
+    if (m_activeGameId < 0) {
+        m_processMonitor->stop();
+        return;
     }
+
+    if (isPathInUse(m_activeGamePath)) {
+        m_activeGameSeen = true;
+        return;
+    }
+    if (!m_activeGameSeen
+        && QDateTime::currentMSecsSinceEpoch() - m_activeLaunchedAt < GAME_START_TIMEOUT_MS)
+        return;
+
+    // Only a session that was actually observed has a meaningful length
+    if (m_activeGameSeen && m_activeSessionId >= 0)
+        m_db->endGameSession(m_activeSessionId);
+    const int gameId = m_activeGameId;
+    m_activeSessionId = -1;
+    m_activeGameId = -1;
+    m_activeGamePath.clear();
+    m_processMonitor->stop();
+    emit gameExited(gameId);
 }
 
 StoreBackend* GameManager::getBackendForGame(const Game& game) {
@@ -155,6 +205,8 @@ void GameManager::toggleFavorite(int gameId) {
 // FIX #12: Implement all Q_INVOKABLE methods
 
 QVariantList GameManager::gamesToVariantList(const QVector<Game>& games) {
+    // One lookup per list instead of a join in every games query
+    const QHash<QString, QString> protonTiers = m_db->getProtonTiers();
     QVariantList list;
     for (const Game& g : games) {
         QVariantMap map;
@@ -163,10 +215,16 @@ QVariantList GameManager::gamesToVariantList(const QVector<Game>& games) {
         map["storeSource"] = g.storeSource;
         map["appId"] = g.appId;
         map["coverArtUrl"] = g.coverArtUrl;
+        map["backgroundArtUrl"] = g.backgroundArtUrl;
+        map["logoUrl"] = g.logoUrl;
+        map["iconPath"] = g.iconPath;
         map["isFavorite"] = g.isFavorite;
         map["isInstalled"] = g.isInstalled;
         map["lastPlayed"] = g.lastPlayed;
         map["playTimeHours"] = g.playTimeHours;
+        map["dominantColor"] = g.dominantColor;
+        map["placeholderPreview"] = g.placeholderPreview;
+        map["protonTier"] = g.storeSource == "steam" ? protonTiers.value(g.appId) : QString();
         list.append(map);
     }
     return list;
@@ -1850,18 +1908,11 @@ void GameManager::loginSteamCmd() {
     }
 
     // ── Log file setup ──
-    // Writes a timestamped log to ~/.config/luna-ui/steamcmd-setup.log
-    // so users can inspect the full SteamCMD output after login attempts.
-    QString logDir = QDir::homePath() + "/.config/luna-ui";
-    QDir().mkpath(logDir);
-    auto logFile = std::make_shared<QFile>(logDir + "/steamcmd-setup.log");
-    logFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
-    auto writeLog = [logFile](const QString& msg) {
-        if (!logFile->isOpen()) return;
-        QString ts = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-        QTextStream out(logFile.get());
-        out << "[" << ts << "] " << msg << "\n";
-        out.flush();
+    // Timestamped log in ~/.config/luna-ui/steamcmd-setup.log so users can
+    // inspect the full SteamCMD output after login attempts.  Written by
+    // the shared Logger thread; stdout chatter never blocks the GUI.
+    auto writeLog = [](const QString& msg) {
+        Logger::instance().write(steamCmdLogCategory(), LogLevel::Info, msg);
     };
 
     writeLog("═══════════════════════════════════════════════════════");
@@ -2086,16 +2137,12 @@ void GameManager::loginSteamCmd() {
 }
 
 void GameManager::provideSteamCmdSetupCredential(const QString& credential) {
-    // Append to the same log file for a complete timeline.
-    QFile log(QDir::homePath() + "/.config/luna-ui/steamcmd-setup.log");
-    if (log.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        QString ts = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-        // Mask the credential — show type/length but not the value.
-        QString masked = (credential.length() <= 6)
-            ? "guard code (" + QString::number(credential.length()) + " chars)"
-            : "password (" + QString::number(credential.length()) + " chars)";
-        QTextStream(&log) << "[" << ts << "] Credential sent: " << masked << "\n";
-    }
+    // Append to the same log for a complete timeline.
+    // Mask the credential — show type/length but not the value.
+    QString masked = (credential.length() <= 6)
+        ? "guard code (" + QString::number(credential.length()) + " chars)"
+        : "password (" + QString::number(credential.length()) + " chars)";
+    Logger::instance().write(steamCmdLogCategory(), LogLevel::Info, "Credential sent: " + masked);
 
     if (m_steamCmdSetupProc && m_steamCmdSetupProc->state() == QProcess::Running) {
         m_steamCmdSetupProc->write((credential + "\n").toUtf8());
@@ -2103,12 +2150,9 @@ void GameManager::provideSteamCmdSetupCredential(const QString& credential) {
 }
 
 void GameManager::cancelSteamCmdSetup() {
-    QFile log(QDir::homePath() + "/.config/luna-ui/steamcmd-setup.log");
-    if (log.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        QString ts = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-        QTextStream(&log) << "[" << ts << "] Setup cancelled by user\n"
-                          << "[" << ts << "] ───────────────────────────────────────────────────────\n";
-    }
+    Logger::instance().write(steamCmdLogCategory(), LogLevel::Info, "Setup cancelled by user");
+    Logger::instance().write(steamCmdLogCategory(), LogLevel::Info,
+                             "───────────────────────────────────────────────────────");
 
     if (m_steamCmdSetupProc && m_steamCmdSetupProc->state() == QProcess::Running) {
         m_steamCmdSetupProc->terminate();
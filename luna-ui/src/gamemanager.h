@@ -153,6 +153,11 @@ private:
     QVector<StoreBackend*> m_backends;
     int m_activeSessionId = -1;
     int m_activeGameId = -1;
+    // Running-game detection: the launched game's directory, whether a
+    // process using it has shown up yet, and when it was launched
+    QString m_activeGamePath;
+    bool m_activeGameSeen = false;
+    qint64 m_activeLaunchedAt = 0;
     QTimer *m_processMonitor;
     QNetworkAccessManager *m_networkManager;
 
@@ -174,6 +179,7 @@ private:
 
     void registerBackends();
     void monitorGameProcess();
+    static bool isPathInUse(const QString& path);
     void checkDownloadProgress();
     void handleSteamCmdOutput(const QString& appId, QProcess *proc);
     void ensureSteamCmd(int gameId);
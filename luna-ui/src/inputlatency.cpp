@@ -0,0 +1,175 @@
+#include "inputlatency.h"
+#include "inputthread.h"
+#include <QQuickWindow>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+// Nearest-rank percentile of an ascending list
+static qint64 percentile(const QVector<qint64> &sorted, double q) {
+    if (sorted.isEmpty()) return 0;
+    const int rank = int(std::ceil(q * sorted.size()));
+    return sorted[qBound(0, rank - 1, int(sorted.size()) - 1)];
+}
+
+static double toMs(qint64 ns) {
+    return ns / 1e6;
+}
+
+InputLatency::InputLatency(QObject *parent)
+    : QObject(parent)
+    , m_enabled(qEnvironmentVariableIntValue("LUNA_INPUT_LATENCY") != 0)
+{
+    if (!m_enabled) return;
+    for (Samples &s : m_samples)
+        s.ns.reserve(MaxSamples);
+}
+
+void InputLatency::setEnabled(bool enabled) {
+    if (enabled == m_enabled) return;
+    m_enabled = enabled;
+    if (m_enabled) {
+        for (Samples &s : m_samples)
+            s.ns.reserve(MaxSamples);
+    }
+    setWindow(m_window);   // (dis)connect frameSwapped
+}
+
+void InputLatency::setWindow(QQuickWindow *window) {
+    if (m_window) disconnect(m_window, nullptr, this, nullptr);
+    m_window = window;
+    // frameSwapped comes from the render thread with the threaded render
+    // loop; taking the time there is what makes the frame stage honest.
+    // Disabled, it isn't connected at all.
+    if (m_window && m_enabled) {
+        connect(m_window, &QQuickWindow::frameSwapped,
+                this, &InputLatency::onFrameSwapped, Qt::DirectConnection);
+    }
+}
+
+const char *InputLatency::stageName(Stage stage) {
+    switch (stage) {
+    case Queue:    return "queue";
+    case Resolve:  return "resolve";
+    case Dispatch: return "dispatch";
+    case Frame:    return "frame";
+    default:       return "";
+    }
+}
+
+// ─── Recording ───
+// Disabled, every hook returns before touching the clock, the lock or
+// the window.
+
+void InputLatency::begin(qint64 eventNs) {
+    if (!m_enabled) return;
+    m_eventNs = eventNs;
+    m_dequeuedNs = InputThread::now();
+}
+
+void InputLatency::resolved() {
+    if (!m_enabled || !m_eventNs) return;
+    record(Queue, m_dequeuedNs - m_eventNs);
+    record(Resolve, InputThread::now() - m_eventNs);
+}
+
+void InputLatency::dispatched() {
+    if (!m_enabled || !m_eventNs) return;
+    record(Dispatch, InputThread::now() - m_eventNs);
+    m_framePending.store(m_eventNs);
+    m_eventNs = 0;
+    if (m_window) m_window->update();
+}
+
+void InputLatency::onFrameSwapped() {
+    if (!m_enabled) return;
+    const qint64 eventNs = m_framePending.exchange(0);
+    if (eventNs) record(Frame, InputThread::now() - eventNs);
+}
+
+void InputLatency::record(Stage stage, qint64 ns) {
+    QMutexLocker lock(&m_lock);
+    Samples &s = m_samples[stage];
+    if (s.ns.size() < MaxSamples)
+        s.ns.append(ns);
+    else
+        s.ns[s.next] = ns;
+    s.next = (s.next + 1) % MaxSamples;
+    s.total++;
+}
+
+void InputLatency::reset() {
+    QMutexLocker lock(&m_lock);
+    for (Samples &s : m_samples)
+        s = Samples();
+}
+
+// ─── Reporting ───
+
+QVariantList InputLatency::summary() const {
+    QVariantList out;
+    for (int i = 0; i < StageCount; i++) {
+        QVector<qint64> sorted;
+        qint64 total;
+        {
+            QMutexLocker lock(&m_lock);
+            sorted = m_samples[i].ns;
+            total = m_samples[i].total;
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        QVariantMap row;
+        row["stage"] = QString::fromLatin1(stageName(Stage(i)));
+        row["count"] = total;
+        row["p50"] = toMs(percentile(sorted, 0.50));
+        row["p95"] = toMs(percentile(sorted, 0.95));
+        row["p99"] = toMs(percentile(sorted, 0.99));
+        row["max"] = toMs(sorted.isEmpty() ? 0 : sorted.last());
+        out.append(row);
+    }
+    return out;
+}
+
+QString InputLatency::defaultReportPath() {
+    return QDir::homePath() + "/.local/share/luna-ui/input-latency.txt";
+}
+
+bool InputLatency::dumpToFile(const QString &path) const {
+    const QString target = path.isEmpty() ? defaultReportPath() : path;
+    QDir().mkpath(QFileInfo(target).absolutePath());
+    QFile file(target);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "InputLatency: cannot write" << target;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "# luna-ui input latency, " << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+    out << "# stage count p50_ms p95_ms p99_ms max_ms\n";
+    for (const QVariant &v : summary()) {
+        const QVariantMap row = v.toMap();
+        out << row["stage"].toString() << ' ' << row["count"].toLongLong()
+            << ' ' << QString::number(row["p50"].toDouble(), 'f', 3)
+            << ' ' << QString::number(row["p95"].toDouble(), 'f', 3)
+            << ' ' << QString::number(row["p99"].toDouble(), 'f', 3)
+            << ' ' << QString::number(row["max"].toDouble(), 'f', 3) << "\n";
+    }
+
+    // Raw samples, oldest first, so two builds can be compared offline
+    out << "# stage,us\n";
+    QMutexLocker lock(&m_lock);
+    for (int i = 0; i < StageCount; i++) {
+        const Samples &s = m_samples[i];
+        const int n = s.ns.size();
+        const int first = n < MaxSamples ? 0 : s.next;
+        for (int k = 0; k < n; k++)
+            out << stageName(Stage(i)) << ',' << s.ns[(first + k) % n] / 1000 << "\n";
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef INPUTLATENCY_H
+#define INPUTLATENCY_H
+
+#include <QObject>
+#include <QMutex>
+#include <QPointer>
+#include <QVariantList>
+#include <QVector>
+#include <atomic>
+
+class QQuickWindow;
+
+// Button-to-pixels latency of controller input.
+//
+// Every sample is measured from the moment SDL handed the event to the
+// input thread (InputEvent::timestampNs) to:
+//   queue     — the GUI thread picked it up
+//   resolve   — ProfileResolver turned it into an action
+//   dispatch  — actionTriggered, the legacy signal and the synthetic key
+//               event have all been delivered (QML focus has moved)
+//   frame     — the window swapped the next frame after that
+// Only events that resolve to an action are counted.  Each stage keeps
+// the most recent samples, so percentiles follow the current session.
+//
+// LUNA_INPUT_LATENCY=1 (or --replay-input, see main.cpp) shows the
+// overlay and writes the report to ~/.local/share/luna-ui/input-latency.txt
+// on exit.
+class InputLatency : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled CONSTANT)
+public:
+    enum Stage { Queue, Resolve, Dispatch, Frame, StageCount };
+
+    explicit InputLatency(QObject *parent = nullptr);
+
+    bool isEnabled() const { return m_enabled; }
+    // Overrides LUNA_INPUT_LATENCY; call before QML reads `enabled`
+    void setEnabled(bool enabled);
+
+    // Frame samples are taken from this window's frameSwapped
+    void setWindow(QQuickWindow *window);
+
+    // GUI thread, in event order: begin() when an event is taken off the
+    // queue, resolved() once it maps to an action, dispatched() after the
+    // action has been delivered
+    void begin(qint64 eventNs);
+    void resolved();
+    void dispatched();
+
+    // [{stage, count, p50, p95, p99, max}] with times in milliseconds
+    Q_INVOKABLE QVariantList summary() const;
+    Q_INVOKABLE void reset();
+    // Summary plus the raw samples; empty path writes the default report
+    Q_INVOKABLE bool dumpToFile(const QString &path = QString()) const;
+    static QString defaultReportPath();
+
+private:
+    static constexpr int MaxSamples = 1024;
+    struct Samples {
+        QVector<qint64> ns;   // ring of the last MaxSamples
+        int next = 0;
+        qint64 total = 0;     // samples ever recorded
+    };
+
+    bool m_enabled;
+    QPointer<QQuickWindow> m_window;
+
+    // Written on the GUI thread, Frame also from the render thread
+    mutable QMutex m_lock;
+    Samples m_samples[StageCount];
+
+    qint64 m_eventNs = 0;
+    qint64 m_dequeuedNs = 0;
+    // Event time of the last dispatched action, until a frame shows it
+    std::atomic<qint64> m_framePending{0};
+
+    void record(Stage stage, qint64 ns);
+    void onFrameSwapped();
+    static const char *stageName(Stage stage);
+};
+
+#endif
@@ -0,0 +1,527 @@
+#include "inputthread.h"
+#include <QMutexLocker>
+#include <QDebug>
+#include <chrono>
+
+// The loop polls SDL: every millisecond while the pad is in use, backing
+// off to IDLE_POLL_MS once it goes quiet and to DORMANT_POLL_MS once it
+// has been quiet for IDLE_GRACE_NS (or no pad is connected).  The grace
+// period keeps menu browsing at frame-rate latency; only the first press
+// after a long pause can wait up to DORMANT_POLL_MS.  SDL_WaitEventTimeout
+// would be no cheaper; with only the controller subsystem up, SDL
+// implements it as a pump + SDL_Delay(1) loop.  Posted commands and
+// stop() cut any sleep short.
+static const int ACTIVE_POLL_MS = 1;
+static const int IDLE_POLL_MS = 16;
+static const int DORMANT_POLL_MS = 200;
+static const qint64 IDLE_GRACE_NS = 3LL * 1000 * 1000 * 1000;
+// Stick or trigger travel past this counts as held
+static const int HELD_AXIS_THRESHOLD = 8000;
+
+// Recording file: magic, then one 9-byte little-endian record per event
+// (quint32 µs since the previous event, quint8 pad ordinal, quint8 kind,
+// quint8 code, qint16 value).  Ordinals number the pads in the order
+// they first sent an event.
+static const char RECORD_MAGIC[8] = {'L', 'U', 'N', 'A', 'R', 'E', 'C', '2'};
+// Keep the virtual pads attached this long after the last event so SDL
+// delivers it before the device goes away
+static const qint64 REPLAY_TAIL_NS = 200 * 1000 * 1000;
+
+// ── InputQueue ───────────────────────────────────────────────────────
+
+bool InputQueue::push(const InputEvent &event) {
+    const quint32 tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+        return false;
+    m_slots[tail & (Capacity - 1)] = event;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputQueue::pop(InputEvent *event) {
+    const quint32 head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+        return false;
+    *event = m_slots[head & (Capacity - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+// ── Constructor / Destructor ─────────────────────────────────────────
+
+InputThread::InputThread(std::function<void()> wake, QObject *parent)
+    : QThread(parent)
+    , m_wake(std::move(wake))
+{
+    setObjectName("SDL input");
+}
+
+InputThread::~InputThread() {
+    stop();
+    wait();
+}
+
+void InputThread::stop() {
+    m_stopping.store(true);
+    wakeLoop();
+}
+
+void InputThread::wakeLoop() {
+    QMutexLocker lock(&m_commandLock);
+    m_commandPosted.wakeOne();
+}
+
+void InputThread::sleepUntilDue(int ms) {
+    QMutexLocker lock(&m_commandLock);
+    if (m_commands.isEmpty() && !m_stopping.load())
+        m_commandPosted.wait(&m_commandLock, ms);
+}
+
+void InputThread::post(std::function<void()> command) {
+    {
+        QMutexLocker lock(&m_commandLock);
+        m_commands.append(std::move(command));
+    }
+    wakeLoop();
+}
+
+void InputThread::runCommands() {
+    QList<std::function<void()>> commands;
+    {
+        QMutexLocker lock(&m_commandLock);
+        commands.swap(m_commands);
+    }
+    for (const auto &command : commands)
+        command();
+}
+
+qint64 InputThread::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ── SDL thread ───────────────────────────────────────────────────────
+
+void InputThread::run() {
+    // SDL's joystick state belongs to the thread that initialised it, so
+    // everything that touches SDL stays on this thread
+    SDL_Init(SDL_INIT_GAMECONTROLLER);
+    SDL_GameControllerAddMappingsFromFile("/usr/share/luna-ui/gamecontrollerdb.txt");
+
+    // Pads already plugged in arrive as SDL_CONTROLLERDEVICEADDED
+    SDL_Event event;
+    int pollMs = ACTIVE_POLL_MS;
+    qint64 lastActiveNs = now();
+    while (!m_stopping.load()) {
+        runCommands();
+        stepReplay();
+        bool active = false;
+        while (!m_stopping.load() && SDL_PollEvent(&event)) {
+            handleSdlEvent(event, now());
+            active = true;
+        }
+        // Full rate while anything is pressed, so the release is seen
+        // promptly; otherwise double the interval up to the idle rate,
+        // then drop to the dormant rate once the grace period is over
+        const qint64 t = now();
+        if (active || padHeld()) {
+            lastActiveNs = t;
+            pollMs = ACTIVE_POLL_MS;
+        } else if (m_controllers.isEmpty() || t - lastActiveNs > IDLE_GRACE_NS) {
+            pollMs = DORMANT_POLL_MS;
+        } else {
+            pollMs = qMin(pollMs * 2, IDLE_POLL_MS);
+        }
+        sleepUntilDue(qMin(pollMs, replayWaitMs()));
+    }
+
+    if (!m_virtualPads.isEmpty()) finishReplay(false);
+    m_recordStream.setDevice(nullptr);
+    m_recordFile.close();
+    for (SDL_JoystickID id : m_controllers.keys())
+        closeController(id);
+    SDL_Quit();
+}
+
+bool InputThread::padHeld() const {
+    for (SDL_GameController *controller : m_controllers) {
+        for (int button = 0; button < SDL_CONTROLLER_BUTTON_MAX; ++button) {
+            if (SDL_GameControllerGetButton(controller, SDL_GameControllerButton(button)))
+                return true;
+        }
+        for (int axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; ++axis) {
+            if (qAbs(int(SDL_GameControllerGetAxis(controller, SDL_GameControllerAxis(axis))))
+                    > HELD_AXIS_THRESHOLD)
+                return true;
+        }
+    }
+    return false;
+}
+
+void InputThread::handleSdlEvent(const SDL_Event &event, qint64 timestampNs) {
+    if (m_recordFile.isOpen()) record(event, timestampNs);
+
+    InputEvent input;
+    input.timestampNs = timestampNs;
+
+    switch (event.type) {
+    case SDL_CONTROLLERBUTTONDOWN:
+        input.type = InputEvent::ButtonDown;
+        input.code = event.cbutton.button;
+        input.device = event.cbutton.which;
+        enqueue(input);
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        input.type = InputEvent::AxisMotion;
+        input.code = event.caxis.axis;
+        input.value = event.caxis.value;
+        input.device = event.caxis.which;
+        enqueue(input);
+        break;
+    case SDL_CONTROLLERDEVICEADDED:
+        // which is the device index here, the instance id everywhere else
+        openController(event.cdevice.which);
+        break;
+    case SDL_CONTROLLERDEVICEREMOVED:
+        closeController(event.cdevice.which);
+        break;
+    }
+}
+
+SDL_JoystickID InputThread::openController(int deviceIndex) {
+    // Opening an already open pad only bumps SDL's refcount; don't
+    const SDL_JoystickID id = SDL_JoystickGetDeviceInstanceID(deviceIndex);
+    if (id < 0 || m_controllers.contains(id)) return id;
+
+    SDL_GameController *controller = SDL_GameControllerOpen(deviceIndex);
+    if (!controller) return -1;
+    m_controllers.insert(id, controller);
+
+    ControllerInfo info;
+    info.id = id;
+    info.connected = true;
+    info.name = QString::fromUtf8(SDL_GameControllerName(controller));
+    info.family = detectFamily(controller);
+    qDebug() << "Controller connected:" << info.name << "id" << id;
+    {
+        QMutexLocker lock(&m_infoLock);
+        m_info.insert(id, info);
+    }
+
+    InputEvent changed;
+    changed.type = InputEvent::DeviceChanged;
+    changed.device = id;
+    changed.timestampNs = now();
+    enqueue(changed);
+    return id;
+}
+
+void InputThread::closeController(SDL_JoystickID id) {
+    SDL_GameController *controller = m_controllers.take(id);
+    if (!controller) return;
+    SDL_GameControllerClose(controller);
+    qDebug() << "Controller disconnected: id" << id;
+    {
+        QMutexLocker lock(&m_infoLock);
+        m_info.remove(id);
+    }
+
+    InputEvent changed;
+    changed.type = InputEvent::DeviceChanged;
+    changed.device = id;
+    changed.timestampNs = now();
+    enqueue(changed);
+}
+
+void InputThread::enqueue(const InputEvent &event) {
+    // A GUI thread stalled for 256 events drops the newest ones rather
+    // than blocking the SDL loop
+    if (!m_queue.push(event)) return;
+    if (!m_wakePending.exchange(true))
+        m_wake();
+}
+
+ControllerFamily InputThread::detectFamily(SDL_GameController *controller) {
+    SDL_GameControllerType type = SDL_GameControllerGetType(controller);
+    switch (type) {
+    case SDL_CONTROLLER_TYPE_XBOX360:
+    case SDL_CONTROLLER_TYPE_XBOXONE:
+        return ControllerFamily::Xbox;
+
+    case SDL_CONTROLLER_TYPE_PS3:
+    case SDL_CONTROLLER_TYPE_PS4:
+    case SDL_CONTROLLER_TYPE_PS5:
+        return ControllerFamily::PlayStation;
+
+    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_PRO:
+    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_LEFT:
+    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_PAIR:
+    case SDL_CONTROLLER_TYPE_NINTENDO_SWITCH_JOYCON_RIGHT:
+        return ControllerFamily::Switch;
+
+    case SDL_CONTROLLER_TYPE_AMAZON_LUNA:
+        return ControllerFamily::Luna;
+
+    default:
+        // Check name for additional hints
+        const char *name = SDL_GameControllerName(controller);
+        if (name) {
+            QString nameStr = QString::fromUtf8(name).toLower();
+            if (nameStr.contains("xbox") || nameStr.contains("xinput"))
+                return ControllerFamily::Xbox;
+            if (nameStr.contains("playstation") || nameStr.contains("dualshock") || nameStr.contains("dualsense"))
+                return ControllerFamily::PlayStation;
+            if (nameStr.contains("nintendo") || nameStr.contains("switch") || nameStr.contains("pro controller"))
+                return ControllerFamily::Switch;
+            if (nameStr.contains("luna"))
+                return ControllerFamily::Luna;
+        }
+        return ControllerFamily::Generic;
+    }
+}
+
+// ── Recording ────────────────────────────────────────────────────────
+
+void InputThread::startRecording(const QString &path) {
+    post([this, path]() {
+        m_recordStream.setDevice(nullptr);
+        m_recordFile.close();
+        m_recordFile.setFileName(path);
+        if (!m_recordFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "Input recording: cannot write" << path;
+            return;
+        }
+        m_recordFile.write(RECORD_MAGIC, sizeof(RECORD_MAGIC));
+        m_recordStream.setDevice(&m_recordFile);
+        m_recordStream.setByteOrder(QDataStream::LittleEndian);
+        m_recordLastNs = 0;
+        m_recordDevices.clear();
+        qDebug() << "Input recording started:" << path;
+    });
+}
+
+void InputThread::stopRecording() {
+    post([this]() {
+        if (!m_recordFile.isOpen()) return;
+        m_recordStream.setDevice(nullptr);
+        m_recordFile.close();
+        qDebug() << "Input recording saved:" << m_recordFile.fileName();
+    });
+}
+
+void InputThread::record(const SDL_Event &event, qint64 timestampNs) {
+    SDL_JoystickID which;
+    quint8 kind, code;
+    qint16 value = 0;
+    switch (event.type) {
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        which = event.cbutton.which;
+        kind = event.type == SDL_CONTROLLERBUTTONDOWN ? RecordButtonDown : RecordButtonUp;
+        code = event.cbutton.button;
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        which = event.caxis.which;
+        kind = RecordAxis;
+        code = event.caxis.axis;
+        value = event.caxis.value;
+        break;
+    default:
+        return;
+    }
+
+    auto device = m_recordDevices.constFind(which);
+    if (device == m_recordDevices.constEnd()) {
+        if (m_recordDevices.size() > 0xff) return;
+        device = m_recordDevices.insert(which, quint8(m_recordDevices.size()));
+    }
+
+    const qint64 deltaNs = m_recordLastNs ? timestampNs - m_recordLastNs : 0;
+    m_recordLastNs = timestampNs;
+    m_recordStream << quint32(qMin<qint64>(deltaNs / 1000, 0xffffffff))
+                   << device.value() << kind << code << value;
+}
+
+// ── Replay ───────────────────────────────────────────────────────────
+
+void InputThread::startReplay(const QString &path, std::function<void(bool)> done) {
+    post([this, path, done]() {
+        if (!m_virtualPads.isEmpty()) finishReplay(false);
+        m_replayDone = done;
+        if (!beginReplay(path)) {
+            auto callback = std::move(m_replayDone);
+            m_replayDone = nullptr;
+            if (callback) callback(false);
+        }
+    });
+}
+
+bool InputThread::beginReplay(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Input replay: cannot read" << path;
+        return false;
+    }
+    if (file.read(sizeof(RECORD_MAGIC)) != QByteArray(RECORD_MAGIC, sizeof(RECORD_MAGIC))) {
+        qWarning() << "Input replay: not a recording:" << path;
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    m_replay.clear();
+    qint64 atNs = 0;
+    int padCount = 0;
+    while (!in.atEnd()) {
+        quint32 deltaUs;
+        RecordedEvent event;
+        in >> deltaUs >> event.device >> event.kind >> event.code >> event.value;
+        if (in.status() != QDataStream::Ok) break;
+        atNs += qint64(deltaUs) * 1000;
+        event.atNs = atNs;
+        padCount = qMax(padCount, event.device + 1);
+        m_replay.append(event);
+    }
+    if (m_replay.isEmpty()) {
+        qWarning() << "Input replay: empty recording:" << path;
+        return false;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+    if (!attachVirtualPads(padCount)) {
+        m_replay.clear();
+        return false;
+    }
+    m_replayNext = 0;
+    m_replayStartNs = now();
+    qDebug() << "Input replay started:" << path << m_replay.size() << "events on"
+             << padCount << "pads";
+    return true;
+#else
+    Q_UNUSED(padCount);
+    qWarning() << "Input replay needs SDL 2.24 or newer (virtual joysticks)";
+    m_replay.clear();
+    return false;
+#endif
+}
+
+bool InputThread::attachVirtualPads(int count) {
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+    SDL_VirtualJoystickDesc desc;
+    SDL_zero(desc);
+    desc.version = SDL_VIRTUAL_JOYSTICK_DESC_VERSION;
+    desc.type = SDL_JOYSTICK_TYPE_GAMECONTROLLER;
+    desc.naxes = SDL_CONTROLLER_AXIS_MAX;
+    desc.nbuttons = SDL_CONTROLLER_BUTTON_MAX;
+    desc.name = "Luna UI replay";
+
+    for (int i = 0; i < count; ++i) {
+        VirtualPad pad;
+        pad.index = SDL_JoystickAttachVirtualEx(&desc);
+        if (pad.index < 0) {
+            qWarning() << "Input replay: no virtual joystick:" << SDL_GetError();
+            detachVirtualPads();
+            return false;
+        }
+        // Opened right away; its DEVICEADDED event finds it already tracked
+        pad.id = openController(pad.index);
+        m_virtualPads.append(pad);
+        if (!m_controllers.contains(pad.id)) {
+            detachVirtualPads();
+            return false;
+        }
+
+        // Triggers map the virtual axis' full range onto 0..32767, so rest
+        // them at the bottom instead of half pressed
+        SDL_Joystick *joystick = SDL_GameControllerGetJoystick(m_controllers.value(pad.id));
+        SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_TRIGGERLEFT, SDL_JOYSTICK_AXIS_MIN);
+        SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_TRIGGERRIGHT, SDL_JOYSTICK_AXIS_MIN);
+    }
+    return true;
+#else
+    Q_UNUSED(count);
+    return false;
+#endif
+}
+
+void InputThread::detachVirtualPads() {
+    // Last attached first: detaching shifts the device indexes after it
+    while (!m_virtualPads.isEmpty()) {
+        const VirtualPad pad = m_virtualPads.takeLast();
+        closeController(pad.id);
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+        if (pad.index >= 0) SDL_JoystickDetachVirtual(pad.index);
+#endif
+    }
+}
+
+void InputThread::stepReplay() {
+    if (m_virtualPads.isEmpty()) return;
+    for (const VirtualPad &pad : m_virtualPads) {
+        if (!m_controllers.contains(pad.id)) {
+            finishReplay(false);
+            return;
+        }
+    }
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+    const qint64 elapsed = now() - m_replayStartNs;
+    while (m_replayNext < m_replay.size() && m_replay[m_replayNext].atNs <= elapsed) {
+        const RecordedEvent &event = m_replay[m_replayNext++];
+        SDL_Joystick *joystick = SDL_GameControllerGetJoystick(
+            m_controllers.value(m_virtualPads[event.device].id));
+        switch (event.kind) {
+        case RecordButtonDown:
+        case RecordButtonUp:
+            SDL_JoystickSetVirtualButton(joystick, event.code,
+                                         event.kind == RecordButtonDown ? SDL_PRESSED : SDL_RELEASED);
+            break;
+        case RecordAxis: {
+            int value = event.value;
+            if (event.code == SDL_CONTROLLER_AXIS_TRIGGERLEFT || event.code == SDL_CONTROLLER_AXIS_TRIGGERRIGHT)
+                value = value * 2 + SDL_JOYSTICK_AXIS_MIN;
+            SDL_JoystickSetVirtualAxis(joystick, event.code, qint16(qBound(-32768, value, 32767)));
+            break;
+        }
+        }
+    }
+
+    if (m_replayNext >= m_replay.size() && elapsed >= m_replay.last().atNs + REPLAY_TAIL_NS)
+        finishReplay(true);
+#endif
+}
+
+void InputThread::finishReplay(bool ok) {
+    detachVirtualPads();
+    m_replay.clear();
+    qDebug() << "Input replay finished, ok:" << ok;
+
+    auto done = std::move(m_replayDone);
+    m_replayDone = nullptr;
+    if (done) done(ok);
+}
+
+int InputThread::replayWaitMs() const {
+    if (m_virtualPads.isEmpty() || m_replay.isEmpty()) return DORMANT_POLL_MS;
+    const qint64 dueNs = m_replayNext < m_replay.size()
+        ? m_replay[m_replayNext].atNs
+        : m_replay.last().atNs + REPLAY_TAIL_NS;
+    const qint64 waitMs = (m_replayStartNs + dueNs - now()) / 1000000;
+    return int(qBound<qint64>(1, waitMs, IDLE_POLL_MS));
+}
+
+// ── GUI thread ───────────────────────────────────────────────────────
+
+void InputThread::drain(const std::function<void(const InputEvent&)> &handle) {
+    // Re-arm before reading: anything pushed from here on schedules a
+    // fresh wakeup instead of being left in the queue
+    m_wakePending.store(false);
+    InputEvent event;
+    while (m_queue.pop(&event))
+        handle(event);
+}
+
+ControllerInfo InputThread::controllerInfo(int device) const {
+    QMutexLocker lock(&m_infoLock);
+    return m_info.value(device);
+}
@@ -0,0 +1,154 @@
+#ifndef INPUTTHREAD_H
+#define INPUTTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QDataStream>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <SDL2/SDL.h>
+#include "profileresolver.h"
+
+// One controller event on its way from the SDL thread to the GUI thread
+struct InputEvent {
+    enum Type : quint8 { ButtonDown, AxisMotion, DeviceChanged };
+    Type type = ButtonDown;
+    quint8 code = 0;          // SDL_GameControllerButton / SDL_GameControllerAxis
+    qint16 value = 0;         // axis position
+    qint32 device = -1;       // SDL joystick instance id
+    qint64 timestampNs = 0;   // InputThread::now() when SDL handed it over
+};
+
+// Fixed-size single-producer / single-consumer ring.  The SDL thread is
+// the only writer and the GUI thread the only reader, so two atomic
+// indexes are all the synchronisation it needs.
+class InputQueue {
+public:
+    bool push(const InputEvent &event);   // false when full
+    bool pop(InputEvent *event);
+
+private:
+    static constexpr quint32 Capacity = 256;   // power of two
+    InputEvent m_slots[Capacity];
+    std::atomic<quint32> m_head{0};   // next slot to read
+    std::atomic<quint32> m_tail{0};   // next slot to write
+};
+
+// What the GUI thread knows about one pad
+struct ControllerInfo {
+    int id = -1;              // SDL joystick instance id
+    bool connected = false;
+    QString name;
+    ControllerFamily family = ControllerFamily::Generic;
+};
+
+// Owns SDL: initialisation, every open SDL_GameController and the event
+// loop all live on this thread.  SDL is polled every millisecond while
+// the pad is in use, every 16 ms for a few seconds after it goes idle,
+// then every 200 ms (five wakeups a second) until the next input.  SDL
+// has no blocking wait for joystick input, so this is still polling;
+// posted commands and stop() wake the loop at once.  Button presses and
+// axis motion are queued with a timestamp; wake() runs (on this thread)
+// only when the queue goes from drained to non-empty, so a burst of axis
+// events costs the GUI thread one wakeup.
+//
+// Every game controller is opened and tracked by its instance id; a pad
+// being plugged in or pulled out touches only its own entry.
+//
+// The raw controller events can be recorded to a file and replayed
+// later through SDL virtual controllers, which go through the same SDL
+// event path as physical pads.  Each event records which pad sent it,
+// and replay attaches one virtual pad per recorded pad.
+class InputThread : public QThread {
+public:
+    explicit InputThread(std::function<void()> wake, QObject *parent = nullptr);
+    ~InputThread();
+
+    // Ask the loop to exit; wait() afterwards
+    void stop();
+
+    // Any thread.  Recording writes every button and axis event of the
+    // open pads to path until stopRecording().
+    void startRecording(const QString &path);
+    void stopRecording();
+    // Any thread.  Attaches a virtual pad per recorded pad and plays the
+    // recording back on them in real time; done(ok) runs on the SDL thread.
+    void startReplay(const QString &path, std::function<void(bool ok)> done);
+
+    // GUI thread: hand every queued event to handle, oldest first
+    void drain(const std::function<void(const InputEvent&)> &handle);
+    // Any thread; connected is false once the pad is gone
+    ControllerInfo controllerInfo(int device) const;
+
+    // Monotonic clock shared by both threads, in nanoseconds
+    static qint64 now();
+
+protected:
+    void run() override;
+
+private:
+    std::function<void()> m_wake;
+    InputQueue m_queue;
+    std::atomic<bool> m_wakePending{false};
+    std::atomic<bool> m_stopping{false};
+
+    mutable QMutex m_infoLock;
+    QHash<int, ControllerInfo> m_info;
+
+    QHash<SDL_JoystickID, SDL_GameController*> m_controllers;   // SDL thread only
+
+    // Work handed to the SDL thread by the methods above
+    QMutex m_commandLock;
+    QWaitCondition m_commandPosted;   // also signalled by stop()
+    QList<std::function<void()>> m_commands;
+    void post(std::function<void()> command);
+    void wakeLoop();
+    void runCommands();
+    // Sleep up to ms, returning early for a posted command or stop()
+    void sleepUntilDue(int ms);
+    bool padHeld() const;
+
+    // Recording / replay, SDL thread only
+    struct RecordedEvent {
+        qint64 atNs;       // since the first event
+        quint8 device;     // pad ordinal within the recording
+        quint8 kind;       // RecordKind
+        quint8 code;
+        qint16 value;
+    };
+    enum RecordKind : quint8 { RecordButtonDown, RecordButtonUp, RecordAxis };
+    QFile m_recordFile;
+    QDataStream m_recordStream;
+    qint64 m_recordLastNs = 0;
+    QHash<SDL_JoystickID, quint8> m_recordDevices;   // instance id → ordinal
+    QVector<RecordedEvent> m_replay;
+    int m_replayNext = 0;
+    qint64 m_replayStartNs = 0;
+    struct VirtualPad {
+        int index = -1;                       // device index, for detaching
+        SDL_JoystickID id = -1;
+    };
+    QVector<VirtualPad> m_virtualPads;        // by recorded ordinal
+    std::function<void(bool)> m_replayDone;
+    void record(const SDL_Event &event, qint64 timestampNs);
+    bool beginReplay(const QString &path);
+    bool attachVirtualPads(int count);
+    void detachVirtualPads();
+    void stepReplay();
+    void finishReplay(bool ok);
+    int replayWaitMs() const;   // until the next replay event is due
+
+    void handleSdlEvent(const SDL_Event &event, qint64 timestampNs);
+    SDL_JoystickID openController(int deviceIndex);
+    void closeController(SDL_JoystickID id);
+    void enqueue(const InputEvent &event);
+    static ControllerFamily detectFamily(SDL_GameController *controller);
+};
+
+#endif
@@ -0,0 +1,296 @@
+#include "logger.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <chrono>
+#include <cstdint>
+
+// Once woken by a record, the writer lets the batch build up for this
+// long (less for errors / a filling ring), so callers pay for at most one
+// wake-up per batch rather than one per line.
+static const auto WRITER_INTERVAL = std::chrono::milliseconds(50);
+
+struct Logger::Category {
+    QString name;
+    QString path;
+    qint64 maxBytes = 0;
+    int keepFiles = 0;
+    std::atomic<int> level{int(LogLevel::Info)};
+
+    // Writer thread only
+    QFile file;
+    bool dirty = false;
+};
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : m_ring(new Cell[RingCapacity])
+    , m_categories(new Category[MaxCategories])
+{
+    for (size_t i = 0; i < RingCapacity; ++i)
+        m_ring[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_writer = std::thread([this]() { run(); });
+}
+
+Logger::~Logger() {
+    m_stop.store(true);
+    wakeWriter();
+    if (m_writer.joinable()) m_writer.join();
+}
+
+// ── Categories & levels ──
+
+LogLevel Logger::levelFromEnv(const QString& name) {
+    static const QHash<QString, LogLevel> names = {
+        {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+        {"warning", LogLevel::Warning}, {"error", LogLevel::Error},
+        {"off", LogLevel::Off},
+    };
+
+    LogLevel result = LogLevel::Info;
+    const QString spec = qEnvironmentVariable("LUNA_LOG_LEVELS");
+    for (const QString& entry : spec.split(',', Qt::SkipEmptyParts)) {
+        QString key = entry.section('=', 0, 0).trimmed();
+        QString value = entry.section('=', 1).trimmed().toLower();
+        if (!names.contains(value)) continue;
+        // An exact match wins over the "*" default regardless of order
+        if (key == name) return names.value(value);
+        if (key == "*") result = names.value(value);
+    }
+    return result;
+}
+
+int Logger::registerCategory(const QString& name, const QString& filePath,
+                             qint64 maxBytes, int keepFiles) {
+    std::lock_guard<std::mutex> lock(m_registerMutex);
+    int count = m_categoryCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (m_categories[i].name == name) return i;
+    }
+    if (count >= MaxCategories) return -1;
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    Category& cat = m_categories[count];
+    cat.name = name;
+    cat.path = filePath;
+    cat.maxBytes = maxBytes;
+    cat.keepFiles = keepFiles;
+    cat.level.store(int(levelFromEnv(name)), std::memory_order_relaxed);
+
+    // Publishing the count makes the entry visible to the writer, which
+    // only looks categories up through records that reference them.
+    m_categoryCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void Logger::setLevel(int category, LogLevel level) {
+    if (category < 0 || category >= m_categoryCount.load(std::memory_order_acquire)) return;
+    m_categories[category].level.store(int(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::level(int category) const {
+    if (category < 0 || category >= m_categoryCount.load(std::memory_order_acquire))
+        return LogLevel::Off;
+    return LogLevel(m_categories[category].level.load(std::memory_order_relaxed));
+}
+
+bool Logger::isEnabled(int category, LogLevel level) const {
+    return level != LogLevel::Off && int(level) >= int(this->level(category));
+}
+
+// ── Producer side ──
+
+void Logger::write(int category, LogLevel level, const QString& msg) {
+    if (!isEnabled(category, level)) return;
+
+    Record record;
+    record.category = category;
+    record.level = level;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.message = msg;
+
+    if (!enqueue(std::move(record))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_urgent.store(true);
+        wakeWriter();
+        return;
+    }
+
+    // Errors go out promptly, as does a ring filling up faster than the
+    // writer's batches drain it
+    size_t queued = m_enqueuePos.load(std::memory_order_relaxed)
+                  - m_written.load(std::memory_order_relaxed);
+    const bool urgent = level >= LogLevel::Error || queued > RingCapacity / 2;
+    if (urgent) m_urgent.store(true);
+
+    // Pairs with the fence in run(): either the writer sees this record
+    // before going to sleep, or we see it asleep and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_idle.exchange(false) || urgent)
+        wakeWriter();
+}
+
+void Logger::wakeWriter() {
+    // Under the mutex so the notify can't fall between the writer's
+    // predicate check and its wait
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_one();
+}
+
+bool Logger::enqueue(Record&& record) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &m_ring[pos & (RingCapacity - 1)];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;   // full
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->record = std::move(record);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::dequeue(Record& record) {
+    Cell *cell = &m_ring[m_dequeuePos & (RingCapacity - 1)];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    if (seq != m_dequeuePos + 1) return false;   // empty (or slot still being filled)
+
+    record = std::move(cell->record);
+    cell->record = Record();
+    cell->sequence.store(m_dequeuePos + RingCapacity, std::memory_order_release);
+    m_dequeuePos++;
+    return true;
+}
+
+void Logger::flush() {
+    const quint64 target = m_enqueuePos.load(std::memory_order_acquire);
+    m_urgent.store(true);
+    wakeWriter();
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_drained.wait_for(lock, std::chrono::seconds(2), [&]() {
+        return m_written.load() >= target;
+    });
+}
+
+// ── Writer thread ──
+
+void Logger::run() {
+    for (;;) {
+        bool wrote = false;
+        Record record;
+        while (dequeue(record)) {
+            writeRecord(record);
+            m_written.fetch_add(1, std::memory_order_release);
+            wrote = true;
+        }
+
+        if (wrote) {
+            int count = m_categoryCount.load(std::memory_order_acquire);
+            for (int i = 0; i < count; ++i) {
+                Category& cat = m_categories[i];
+                if (!cat.dirty) continue;
+                cat.file.flush();
+                cat.dirty = false;
+                if (cat.maxBytes > 0 && cat.file.size() > cat.maxBytes)
+                    rotate(cat);
+            }
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_drained.notify_all();
+        }
+
+        if (m_stop.load()) {
+            // Producers may have raced the stop flag; take one last pass
+            if (!dequeue(record)) break;
+            writeRecord(record);
+            m_written.fetch_add(1, std::memory_order_release);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+        // Ring drained: sleep until write() sees it go non-empty
+        m_idle.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_enqueuePos.load() != m_dequeuePos) {
+            // A record raced the idle flag (or is still being filled in)
+            m_idle.store(false);
+        } else {
+            m_wake.wait(lock, [&]() { return !m_idle.load() || m_stop.load(); });
+        }
+        if (m_stop.load()) continue;
+
+        // Records are pending: give the batch a moment to fill up unless
+        // something needs it written now
+        m_wake.wait_for(lock, WRITER_INTERVAL, [&]() {
+            return m_urgent.load() || m_stop.load();
+        });
+        m_urgent.store(false);
+    }
+
+    int count = m_categoryCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i)
+        m_categories[i].file.close();
+}
+
+void Logger::writeRecord(const Record& record) {
+    if (record.category < 0 || record.category >= m_categoryCount.load(std::memory_order_acquire))
+        return;
+    Category& cat = m_categories[record.category];
+
+    if (!cat.file.isOpen()) {
+        cat.file.setFileName(cat.path);
+        if (!cat.file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            return;
+    }
+
+    static const char *const levelNames[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+    QString ts = QDateTime::fromMSecsSinceEpoch(record.timestamp)
+                     .toString("yyyy-MM-dd hh:mm:ss.zzz");
+
+    quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        cat.file.write(QString("%1  WARN   [logger] %2 records dropped (ring full)\n")
+                           .arg(ts).arg(dropped).toUtf8());
+    }
+
+    QByteArray line = ts.toUtf8();
+    line += "  ";
+    line += levelNames[qBound(0, int(record.level), 3)];
+    line += "  ";
+    line += record.message.toUtf8();
+    line += '\n';
+    cat.file.write(line);
+    cat.dirty = true;
+}
+
+void Logger::rotate(Category& cat) {
+    // name.log → name.log.1 → ... → name.log.<keepFiles>, oldest removed
+    cat.file.close();
+    QFile::remove(cat.path + "." + QString::number(cat.keepFiles));
+    for (int i = cat.keepFiles - 1; i >= 1; --i) {
+        QFile::rename(cat.path + "." + QString::number(i),
+                      cat.path + "." + QString::number(i + 1));
+    }
+    if (cat.keepFiles > 0)
+        QFile::rename(cat.path, cat.path + ".1");
+    else
+        QFile::remove(cat.path);
+    // Reopened lazily by the next record
+}
@@ -0,0 +1,98 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Shared asynchronous logging for the plain-text diagnostic files
+// (artwork-debug.log, the BrowserBridge CDP log, steamcmd-setup.log).
+//
+// Callers never touch the disk: write() timestamps the record and pushes
+// it onto a bounded lock-free ring (Vyukov MPMC, used here as MPSC).  A
+// single background thread drains the ring, formats the lines, writes
+// each category's file and rotates it once it grows past its size limit.
+// The writer sleeps without a timeout while the ring is empty; the first
+// record after that wakes it, and it then collects a short batch before
+// writing, so an idle session costs no wakeups at all.
+// When the ring is full the record is dropped and counted rather than
+// blocking the caller; the writer reports the gap in the next line.
+//
+// Levels are per category and can be changed at runtime or through the
+// environment, e.g.  LUNA_LOG_LEVELS="artwork=debug,browser=warning,*=info"
+
+enum class LogLevel { Debug = 0, Info, Warning, Error, Off };
+
+class Logger {
+public:
+    static Logger& instance();
+
+    // Register a category writing to filePath.  Registering an existing
+    // name returns its id.  Returns -1 once MaxCategories is reached.
+    int registerCategory(const QString& name, const QString& filePath,
+                         qint64 maxBytes = 2 * 1024 * 1024, int keepFiles = 3);
+
+    void setLevel(int category, LogLevel level);
+    LogLevel level(int category) const;
+    bool isEnabled(int category, LogLevel level) const;
+
+    // Non-blocking; safe from any thread
+    void write(int category, LogLevel level, const QString& msg);
+
+    // Block until everything queued so far is on disk
+    void flush();
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    struct Record {
+        int category = -1;
+        LogLevel level = LogLevel::Info;
+        qint64 timestamp = 0;       // ms since epoch, taken by the caller
+        QString message;
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    struct Category;
+
+    static constexpr size_t RingCapacity = 8192;   // power of two
+    static constexpr int MaxCategories = 16;
+
+    std::unique_ptr<Cell[]> m_ring;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;            // writer thread only
+    std::atomic<quint64> m_dropped{0};
+
+    std::unique_ptr<Category[]> m_categories;
+    std::atomic<int> m_categoryCount{0};
+    std::mutex m_registerMutex;
+
+    std::thread m_writer;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_drained;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_idle{false};      // writer asleep on an empty ring
+    std::atomic<bool> m_urgent{false};    // write the pending batch now
+    std::atomic<quint64> m_written{0};              // records taken off the ring
+
+    bool enqueue(Record&& record);
+    bool dequeue(Record& record);
+    void wakeWriter();
+    void run();
+    void writeRecord(const Record& record);
+    void rotate(Category& cat);
+    static LogLevel levelFromEnv(const QString& name);
+};
+
+#endif
@@ -1,17 +1,23 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QTimer>
 #include <QCursor>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
 #include <QStandardPaths>
 #include <QtWebEngineQuick>
 #include <QWebEngineProfile>
+#include <memory>
 #include "thememanager.h"
 #include "gamemanager.h"
 #include "database.h"
 #include "controllermanager.h"
 #include "artworkmanager.h"
+#include "artworkimageprovider.h"
 #include "storeapimanager.h"
+#include "dealsmodel.h"
 #include "browserbridge.h"
 
 // Hide the mouse cursor while the controller is in use.
@@ -39,6 +45,22 @@ int main(int argc, char *argv[]) {
     app.setApplicationName("Luna UI");
     app.setOrganizationName("Lyrah OS");
 
+    // ── Controller input record / replay harness ──
+    // Replay needs no pad and runs headless with QT_QPA_PLATFORM=offscreen:
+    //   luna-ui --replay-input nav.lrec --exit-after-replay
+    // parse() rather than process(): Chromium flags pass through argv too
+    QCommandLineParser parser;
+    QCommandLineOption recordInputOption("record-input",
+        "Record raw controller events to <file>.", "file");
+    QCommandLineOption replayInputOption("replay-input",
+        "Drive the UI from a recording made with --record-input.", "file");
+    QCommandLineOption exitAfterReplayOption("exit-after-replay",
+        "Log throughput and latency percentiles when the replay ends, then quit.");
+    parser.addOption(recordInputOption);
+    parser.addOption(replayInputOption);
+    parser.addOption(exitAfterReplayOption);
+    parser.parse(app.arguments());
+
     // ── WebEngine storage diagnostics (logged to luna-session.log) ──
     // Qt WebEngine stores persistent data under AppDataLocation, not ConfigLocation.
     {
@@ -58,10 +80,17 @@ int main(int argc, char *argv[]) {
     ThemeManager themeManager;
     GameManager gameManager(&db);
     ControllerManager controllerManager;
+    // A replay is a latency benchmark: measure it even without
+    // LUNA_INPUT_LATENCY
+    if (parser.isSet(replayInputOption))
+        controllerManager.inputLatency()->setEnabled(true);
     controllerManager.initialize();
     controllerManager.setDatabase(&db);
     ArtworkManager artworkManager;
     StoreApiManager storeApiManager;
+    storeApiManager.setDatabase(&db);
+    DealsModel dealsModel(&storeApiManager);
+    DealsGridModel dealsGridModel(&dealsModel);
     BrowserBridge browserBridge;
 
     // Connect GameManager browser signals to BrowserBridge
@@ -95,6 +124,58 @@ int main(int argc, char *argv[]) {
         gameManager.closeApiKeyBrowser();
     });
 
+    // Same game from several stores → one canonical row.  Connected
+    // before the jobs below so they see the fresh index.
+    auto rebuildTitleIdentity = [&]() {
+        db.rebuildTitleIdentity();
+        storeApiManager.refreshOwnedIndex();
+    };
+    QObject::connect(&gameManager, &GameManager::scanComplete, &storeApiManager, rebuildTitleIdentity);
+    QObject::connect(&gameManager, &GameManager::steamOwnedGamesFetched, &storeApiManager, rebuildTitleIdentity);
+    QObject::connect(&gameManager, &GameManager::epicLibraryFetched, &storeApiManager, rebuildTitleIdentity);
+    // IGDB ids can join titles that normalize differently
+    QObject::connect(&storeApiManager, &StoreApiManager::metadataEnrichmentFinished,
+                     &storeApiManager, rebuildTitleIdentity);
+
+    // Prefetch/revalidate library artwork in the background once a scan
+    // (or an owned-games fetch) has filled the database.
+    auto prefetchArtwork = [&]() {
+        artworkManager.prefetchLibrary(db.getAllGames());
+    };
+    QObject::connect(&gameManager, &GameManager::scanComplete, &artworkManager, prefetchArtwork);
+    QObject::connect(&gameManager, &GameManager::steamOwnedGamesFetched, &artworkManager, prefetchArtwork);
+    QObject::connect(&gameManager, &GameManager::epicLibraryFetched, &artworkManager, prefetchArtwork);
+
+    // Refresh ProtonDB tiers for the library grid once Steam games are known
+    auto prefetchProton = [&]() {
+        storeApiManager.prefetchProtonRatings();
+    };
+    QObject::connect(&gameManager, &GameManager::scanComplete, &storeApiManager, prefetchProton);
+    QObject::connect(&gameManager, &GameManager::steamOwnedGamesFetched, &storeApiManager, prefetchProton);
+
+    // Genres/summary/release date for games that have no metadata yet
+    auto enrichMetadata = [&]() {
+        storeApiManager.enrichLibraryMetadata();
+    };
+    QObject::connect(&gameManager, &GameManager::scanComplete, &storeApiManager, enrichMetadata);
+    QObject::connect(&gameManager, &GameManager::steamOwnedGamesFetched, &storeApiManager, enrichMetadata);
+    QObject::connect(&gameManager, &GameManager::epicLibraryFetched, &storeApiManager, enrichMetadata);
+
+    // Persist cover placeholder colours/previews next to the game row
+    QObject::connect(&artworkManager, &ArtworkManager::placeholderReady, &db,
+                     [&](int gameId, const QString& color, const QString& preview) {
+        db.setArtworkPlaceholder(gameId, color, preview);
+    });
+
+    // Back off while a game is running.  Only the game's exit ends it:
+    // Luna's window also gets focus mid-game (overlays, the keyboard).
+    QObject::connect(&gameManager, &GameManager::gameLaunched, &artworkManager, [&]() {
+        artworkManager.setGameRunning(true);
+    });
+    QObject::connect(&gameManager, &GameManager::gameExited, &artworkManager, [&]() {
+        artworkManager.setGameRunning(false);
+    });
+
     // Hide the mouse cursor while the controller is active.
     // Controller actions hide it; mouse movement restores it.
     CursorAutoHider cursorHider;
@@ -120,10 +201,15 @@ int main(int argc, char *argv[]) {
     engine.rootContext()->setContextProperty("GameManager", &gameManager);
     engine.rootContext()->setContextProperty("ControllerManager", &controllerManager);
     engine.rootContext()->setContextProperty("ProfileResolver", controllerManager.profileResolver());
+    engine.rootContext()->setContextProperty("InputLatency", controllerManager.inputLatency());
     engine.rootContext()->setContextProperty("ArtworkManager", &artworkManager);
     engine.rootContext()->setContextProperty("StoreApi", &storeApiManager);
+    engine.rootContext()->setContextProperty("DealsModel", &dealsModel);
+    engine.rootContext()->setContextProperty("DealsGridModel", &dealsGridModel);
     engine.rootContext()->setContextProperty("BrowserBridge", &browserBridge);
     engine.rootContext()->setContextProperty("SharedBrowserProfile", &sharedBrowserProfile);
+    // Engine takes ownership of the provider
+    engine.addImageProvider("artwork", new ArtworkImageProvider(artworkManager.decodedStore()));
 
     // RESOURCE_PREFIX / in CMakeLists.txt places QML files at :/LunaUI/...
     engine.load(QUrl(QStringLiteral("qrc:/LunaUI/qml/Main.qml")));
@@ -131,12 +217,43 @@ int main(int argc, char *argv[]) {
     if (engine.rootObjects().isEmpty())
         return -1;
 
-    // Poll controller input at 60Hz
-    QTimer controllerTimer;
-    QObject::connect(&controllerTimer, &QTimer::timeout, [&]() {
-        controllerManager.pollEvents();
-    });
-    controllerTimer.start(16); // ~60fps
+    // Frame stage of the input latency histograms
+    InputLatency *inputLatency = controllerManager.inputLatency();
+    inputLatency->setWindow(qobject_cast<QQuickWindow*>(engine.rootObjects().first()));
+    if (inputLatency->isEnabled()) {
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, [inputLatency]() {
+            inputLatency->dumpToFile();
+        });
+    }
+
+    if (parser.isSet(recordInputOption))
+        controllerManager.startRecording(parser.value(recordInputOption));
+
+    if (parser.isSet(replayInputOption)) {
+        const bool exitAfterReplay = parser.isSet(exitAfterReplayOption);
+        auto actions = std::make_shared<int>(0);
+        auto replayClock = std::make_shared<QElapsedTimer>();
+        QObject::connect(&controllerManager, &ControllerManager::actionTriggered, [actions]() {
+            ++*actions;
+        });
+        QObject::connect(&controllerManager, &ControllerManager::replayFinished,
+                         [&app, inputLatency, actions, replayClock, exitAfterReplay](bool ok) {
+            const double secs = replayClock->elapsed() / 1000.0;
+            qInfo() << "[input-replay]" << (ok ? "finished:" : "failed:") << *actions << "actions in"
+                    << secs << "s," << (secs > 0 ? *actions / secs : 0) << "actions/s";
+            for (const QVariant &v : inputLatency->summary()) {
+                const QVariantMap row = v.toMap();
+                qInfo().noquote() << "[input-replay]" << row["stage"].toString()
+                                  << "n=" << row["count"].toLongLong()
+                                  << "p50=" << row["p50"].toDouble() << "p95=" << row["p95"].toDouble()
+                                  << "p99=" << row["p99"].toDouble() << "ms";
+            }
+            inputLatency->dumpToFile();
+            if (exitAfterReplay) app.exit(ok ? 0 : 1);
+        });
+        replayClock->start();
+        controllerManager.startReplay(parser.value(replayInputOption));
+    }
 
     // Initial game library scan (background)
     QTimer::singleShot(500, [&]() {
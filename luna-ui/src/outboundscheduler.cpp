@@ -0,0 +1,231 @@
+#include "outboundscheduler.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <QDebug>
+#include <cmath>
+
+OutboundScheduler::OutboundScheduler(QNetworkAccessManager *nam, QObject *parent)
+    : QObject(parent)
+    , m_nam(nam)
+    , m_wakeTimer(new QTimer(this))
+{
+    m_wakeTimer->setSingleShot(true);
+    connect(m_wakeTimer, &QTimer::timeout, this, &OutboundScheduler::pump);
+}
+
+void OutboundScheduler::setHostPolicy(const QString& host, const HostPolicy& policy)
+{
+    m_policies.insert(host, policy);
+    auto it = m_hosts.find(host);
+    if (it != m_hosts.end()) {
+        it->policy = policy;
+        it->tokens = qMin(it->tokens, double(policy.burst));
+    }
+}
+
+OutboundScheduler::Host& OutboundScheduler::hostFor(const QString& name)
+{
+    auto it = m_hosts.find(name);
+    if (it == m_hosts.end()) {
+        Host host;
+        host.policy = m_policies.value(name, m_defaultPolicy);
+        host.tokens = host.policy.burst;
+        host.refilledAt = QDateTime::currentMSecsSinceEpoch();
+        it = m_hosts.insert(name, host);
+    }
+    return it.value();
+}
+
+quint64 OutboundScheduler::submit(const QNetworkRequest& req, const QByteArray& verb,
+                                  const QByteArray& body, Callback done)
+{
+    Job job;
+    job.id = m_nextId++;
+    job.req = req;
+    job.verb = verb;
+    job.body = body;
+    job.done = std::move(done);
+    hostFor(req.url().host()).queue.append(job);
+    pump();
+    return job.id;
+}
+
+void OutboundScheduler::cancel(quint64 ticket)
+{
+    for (Host& host : m_hosts) {
+        for (int i = 0; i < host.queue.size(); ++i) {
+            if (host.queue[i].id == ticket) {
+                host.queue.removeAt(i);
+                return;
+            }
+        }
+    }
+
+    if (QNetworkReply *reply = m_active.value(ticket)) {
+        m_cancelled.insert(ticket);
+        reply->abort();   // onFinished() sees the mark and drops it
+        return;
+    }
+
+    if (m_backingOff.remove(ticket))
+        m_cancelled.insert(ticket);
+}
+
+// ── Dispatch ──
+
+void OutboundScheduler::pump()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 nextWake = -1;
+
+    for (auto it = m_hosts.begin(); it != m_hosts.end(); ++it) {
+        Host& host = it.value();
+        host.tokens = qMin(double(host.policy.burst),
+                           host.tokens + (now - host.refilledAt) / 1000.0 * host.policy.ratePerSec);
+        host.refilledAt = now;
+
+        while (!host.queue.isEmpty()) {
+            qint64 waitMs = 0;
+            if (now < host.blockedUntil)
+                waitMs = host.blockedUntil - now;
+            else if (host.inFlight >= host.policy.maxConcurrent)
+                break;   // a finishing request pumps again
+            else if (host.tokens < 1.0)
+                waitMs = qint64(std::ceil((1.0 - host.tokens) / host.policy.ratePerSec * 1000.0));
+
+            if (waitMs > 0) {
+                nextWake = nextWake < 0 ? waitMs : qMin(nextWake, waitMs);
+                break;
+            }
+
+            host.tokens -= 1.0;
+            dispatch(it.key(), host, host.queue.takeFirst());
+        }
+    }
+
+    if (nextWake >= 0 && (!m_wakeTimer->isActive() || m_wakeTimer->remainingTime() > nextWake))
+        m_wakeTimer->start(int(nextWake));
+}
+
+void OutboundScheduler::dispatch(const QString& hostName, Host& host, const Job& job)
+{
+    host.inFlight++;
+
+    QNetworkRequest req = job.req;
+    req.setTransferTimeout(host.policy.timeoutMs);
+    QNetworkReply *reply = (job.verb == "POST") ? m_nam->post(req, job.body) : m_nam->get(req);
+    m_active.insert(job.id, reply);
+    connect(reply, &QNetworkReply::finished, this, [this, hostName, job, reply]() {
+        onFinished(hostName, job, reply);
+    });
+}
+
+void OutboundScheduler::onFinished(const QString& hostName, Job job, QNetworkReply *reply)
+{
+    reply->deleteLater();
+    m_active.remove(job.id);
+    Host& host = hostFor(hostName);
+    host.inFlight--;
+
+    if (m_cancelled.remove(job.id)) {
+        pump();
+        return;
+    }
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() != QNetworkReply::NoError && job.attempt < MaxRetries
+        && isRetryable(reply, status)) {
+        const int retryAfter = retryAfterMs(reply);
+        if (retryAfter <= MaxRetryAfterMs) {
+            job.attempt++;
+            if (retryAfter >= 0) {
+                // The server named its own pause: hold the whole host
+                qDebug() << "OutboundScheduler:" << hostName << "asked to wait" << retryAfter << "ms";
+                host.blockedUntil = qMax(host.blockedUntil,
+                                         QDateTime::currentMSecsSinceEpoch() + retryAfter);
+                host.queue.prepend(job);
+            } else {
+                // Jitter over the upper half of the window so a burst of
+                // failures doesn't come back in lockstep
+                const int backoff = qMin(MaxBackoffMs, BaseBackoffMs << (job.attempt - 1));
+                const int delay = backoff / 2 + int(QRandomGenerator::global()->bounded(backoff / 2));
+                qDebug() << "OutboundScheduler: retry" << job.attempt << "for" << hostName
+                         << "in" << delay << "ms (" << (status ? QString::number(status)
+                                                                : reply->errorString()) << ")";
+                retryLater(hostName, job, delay);
+            }
+            pump();
+            return;
+        }
+    }
+
+    Result result;
+    result.ok = reply->error() == QNetworkReply::NoError;
+    result.httpStatus = status;
+    if (result.ok)
+        result.body = reply->readAll();
+    else
+        result.error = reply->errorString();
+
+    // The callback may submit more work; pump afterwards either way
+    job.done(result);
+    pump();
+}
+
+void OutboundScheduler::retryLater(const QString& hostName, Job job, int delayMs)
+{
+    m_backingOff.insert(job.id);
+    QTimer::singleShot(delayMs, this, [this, hostName, job]() {
+        if (m_cancelled.remove(job.id)) return;
+        m_backingOff.remove(job.id);
+        hostFor(hostName).queue.prepend(job);
+        pump();
+    });
+}
+
+// ── Retry policy ──
+
+bool OutboundScheduler::isRetryable(QNetworkReply *reply, int httpStatus)
+{
+    if (httpStatus == 429 || httpStatus == 502 || httpStatus == 503 || httpStatus == 504)
+        return true;
+    if (httpStatus != 0)
+        return false;   // any other HTTP error is a real answer
+
+    switch (reply->error()) {
+    case QNetworkReply::OperationCanceledError:   // transfer timeout
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        // Host not found / connection refused mean offline; fail fast so
+        // the response cache can take over.
+        return false;
+    }
+}
+
+int OutboundScheduler::retryAfterMs(QNetworkReply *reply)
+{
+    const QByteArray value = reply->rawHeader("Retry-After").trimmed();
+    if (value.isEmpty()) return -1;
+
+    // Either delta-seconds or an HTTP-date
+    bool isNumber = false;
+    const qint64 secs = value.toLongLong(&isNumber);
+    qint64 ms;
+    if (isNumber) {
+        ms = secs * 1000;
+    } else {
+        QDateTime when = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+        if (!when.isValid()) return -1;
+        ms = QDateTime::currentDateTimeUtc().msecsTo(when);
+    }
+    return int(qBound<qint64>(0, ms, MaxRetryAfterMs + 1));
+}
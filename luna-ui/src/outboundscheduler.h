@@ -0,0 +1,99 @@
+#ifndef OUTBOUNDSCHEDULER_H
+#define OUTBOUNDSCHEDULER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QNetworkRequest>
+#include <QString>
+#include <functional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+// Single exit point for StoreApiManager's HTTP traffic.
+//
+// Requests are queued per host and only dispatched when that host's
+// token bucket has a token and it is below its concurrency cap.  429 and
+// 5xx answers, timeouts and transient network errors are retried with
+// jittered exponential backoff; a Retry-After header pauses the whole
+// host for the requested time instead.  Transfer timeouts come from the
+// host policy, so callers don't set their own.  A cancelled request is
+// dropped from its queue or aborted, and its callback never runs.
+class OutboundScheduler : public QObject {
+    Q_OBJECT
+public:
+    struct HostPolicy {
+        double ratePerSec = 4.0;   // token refill rate
+        int burst = 8;             // bucket size
+        int maxConcurrent = 4;
+        int timeoutMs = 15000;
+    };
+
+    struct Result {
+        bool ok = false;
+        QByteArray body;
+        QString error;
+        int httpStatus = 0;
+    };
+    using Callback = std::function<void(const Result&)>;
+
+    explicit OutboundScheduler(QNetworkAccessManager *nam, QObject *parent = nullptr);
+
+    void setHostPolicy(const QString& host, const HostPolicy& policy);
+    void setDefaultPolicy(const HostPolicy& policy) { m_defaultPolicy = policy; }
+
+    // Returns a ticket for cancel()
+    quint64 submit(const QNetworkRequest& req, const QByteArray& verb, const QByteArray& body,
+                   Callback done);
+    void cancel(quint64 ticket);
+
+private:
+    struct Job {
+        quint64 id = 0;
+        QNetworkRequest req;
+        QByteArray verb;
+        QByteArray body;
+        Callback done;
+        int attempt = 0;
+    };
+
+    struct Host {
+        HostPolicy policy;
+        double tokens = 0;
+        qint64 refilledAt = 0;      // ms since epoch
+        qint64 blockedUntil = 0;    // Retry-After, ms since epoch
+        int inFlight = 0;
+        QList<Job> queue;
+    };
+
+    static constexpr int MaxRetries = 3;
+    static constexpr int BaseBackoffMs = 1000;
+    static constexpr int MaxBackoffMs = 30000;
+    // A server asking for a longer pause than this gets an error instead
+    // of a request that silently hangs for minutes.
+    static constexpr int MaxRetryAfterMs = 120000;
+
+    QNetworkAccessManager *m_nam;
+    QTimer *m_wakeTimer;
+    HostPolicy m_defaultPolicy;
+    QHash<QString, HostPolicy> m_policies;
+    QHash<QString, Host> m_hosts;
+    quint64 m_nextId = 1;
+    QHash<quint64, QNetworkReply*> m_active;
+    QSet<quint64> m_backingOff;     // waiting on a retry timer
+    QSet<quint64> m_cancelled;      // aborted or cancelled mid-backoff
+
+    Host& hostFor(const QString& name);
+    void pump();
+    void dispatch(const QString& hostName, Host& host, const Job& job);
+    void onFinished(const QString& hostName, Job job, QNetworkReply *reply);
+    void retryLater(const QString& hostName, Job job, int delayMs);
+    static bool isRetryable(QNetworkReply *reply, int httpStatus);
+    static int retryAfterMs(QNetworkReply *reply);
+};
+
+#endif
@@ -8,20 +8,23 @@
 #include <QFile>
 #include <QDebug>
 
-ProfileResolver::ProfileResolver(QObject *parent) : QObject(parent) {}
+ProfileResolver::ProfileResolver(QObject *parent)
+    : QObject(parent)
+    , m_current(std::make_shared<CompiledContext>())
+{}
 
 // ── Core Resolution ──────────────────────────────────────────────────
 
 QString ProfileResolver::resolveAction(const QString &physicalInput) const {
-    return m_actionCache.value(physicalInput);
+    return resolve(inputFromName(physicalInput)).action;
 }
 
 QString ProfileResolver::resolveInput(const QString &action) const {
-    return m_inputCache.value(action);
+    return m_current->inputByAction.value(action);
 }
 
 QJsonObject ProfileResolver::resolveParameters(const QString &physicalInput) const {
-    return m_paramsCache.value(physicalInput);
+    return m_current->params.value(physicalInput);
 }
 
 // ── Context Management ───────────────────────────────────────────────
@@ -42,6 +45,7 @@ void ProfileResolver::setControllerFamily(ControllerFamily family) {
 }
 
 void ProfileResolver::reload() {
+    loadStore();
     loadProfiles();
     emit profilesChanged();
 }
@@ -81,13 +85,37 @@ void ProfileResolver::createTables() {
 
     query.exec("CREATE UNIQUE INDEX IF NOT EXISTS idx_mapping_input "
                "ON controller_mappings(profile_id, physical_input)");
+
+    // One row per profile migration that has run; a migration never
+    // reruns, so mappings the user removes stay removed
+    query.exec("CREATE TABLE IF NOT EXISTS controller_migrations ("
+               "name TEXT PRIMARY KEY"
+               ")");
 }
 
 void ProfileResolver::seedDefaults() {
     QSqlQuery check(m_db);
     check.exec("SELECT COUNT(*) FROM controller_profiles WHERE is_default = 1");
-    if (check.next() && check.value(0).toInt() > 0) {
-        return; // Already seeded
+    const bool seeded = check.next() && check.value(0).toInt() > 0;
+    QSqlQuery migrate(m_db);
+    if (seeded) {
+        // Already seeded — add the right stick jump mappings to defaults
+        // seeded before they existed, unless the input was remapped.
+        // Once only: a jump mapping already present means an earlier
+        // build ran this before the marker existed.
+        migrate.exec("SELECT 1 FROM controller_migrations WHERE name = 'right_stick_jump'");
+        if (migrate.next()) return;
+        migrate.exec("SELECT 1 FROM controller_mappings WHERE action IN ('jump_previous', 'jump_next') LIMIT 1");
+        if (!migrate.next()) {
+            migrate.exec("INSERT OR IGNORE INTO controller_mappings (profile_id, physical_input, action, parameters) "
+                         "SELECT id, 'stick_right_left', 'jump_previous', '{\"deadzone\":8000}' "
+                         "FROM controller_profiles WHERE is_default = 1");
+            migrate.exec("INSERT OR IGNORE INTO controller_mappings (profile_id, physical_input, action, parameters) "
+                         "SELECT id, 'stick_right_right', 'jump_next', '{\"deadzone\":8000}' "
+                         "FROM controller_profiles WHERE is_default = 1");
+        }
+        migrate.exec("INSERT OR IGNORE INTO controller_migrations (name) VALUES ('right_stick_jump')");
+        return;
     }
 
     // Shared base mappings (position-based, controller-agnostic)
@@ -112,6 +140,8 @@ void ProfileResolver::seedDefaults() {
             {"stick_left_right", "navigate_right"},
             {"stick_right_up",   "scroll_up"},
             {"stick_right_down", "scroll_down"},
+            {"stick_right_left", "jump_previous"},
+            {"stick_right_right", "jump_next"},
             {"button_start",     "settings"},
             {"button_back",      "system_menu"},
         };
@@ -180,111 +210,176 @@ void ProfileResolver::seedDefaults() {
     int genericId = createProfile("Generic Default", "family", "generic");
     if (genericId > 0) insertMappings(genericId);
 
+    // Fresh defaults already carry everything the migrations add
+    migrate.exec("INSERT OR IGNORE INTO controller_migrations (name) VALUES ('right_stick_jump')");
     qDebug() << "Seeded default controller profiles";
 }
 
-// ── Profile Loading & Cache ──────────────────────────────────────────
+// ── Profile Store ────────────────────────────────────────────────────
 
-void ProfileResolver::loadProfiles() {
-    m_globalProfile = loadProfileFromDb("global", "any", QString(), 0);
-    m_familyProfile = loadProfileFromDb("family", familyToString(m_family), QString(), 0);
-    m_clientProfile = ControllerProfile{};
-    m_gameProfile = ControllerProfile{};
-
-    if (!m_clientId.isEmpty()) {
-        m_clientProfile = loadProfileFromDb("client", familyToString(m_family), m_clientId, 0);
-        // Also try "any" family for client profiles
-        if (m_clientProfile.id == 0) {
-            m_clientProfile = loadProfileFromDb("client", "any", m_clientId, 0);
-        }
+QJsonObject ProfileResolver::parseParameters(const QString &json) {
+    if (json.isEmpty()) return QJsonObject();
+    return QJsonDocument::fromJson(json.toUtf8()).object();
+}
+
+void ProfileResolver::loadStore() {
+    m_profiles.clear();
+    m_contexts.clear();
+
+    QSqlQuery q(m_db);
+    q.exec("SELECT id, name, scope, controller_family, client_id, game_id, is_default "
+           "FROM controller_profiles");
+    while (q.next()) {
+        ControllerProfile profile;
+        profile.id = q.value("id").toInt();
+        profile.name = q.value("name").toString();
+        profile.scope = q.value("scope").toString();
+        profile.controllerFamily = q.value("controller_family").toString();
+        profile.clientId = q.value("client_id").toString();
+        profile.gameId = q.value("game_id").toInt();
+        profile.isDefault = q.value("is_default").toBool();
+        m_profiles.insert(profile.id, profile);
     }
-    if (m_gameId > 0) {
-        m_gameProfile = loadProfileFromDb("game", familyToString(m_family), m_clientId, m_gameId);
-        if (m_gameProfile.id == 0) {
-            m_gameProfile = loadProfileFromDb("game", "any", QString(), m_gameId);
-        }
+
+    // Mappings of deleted profiles may linger (no FK enforcement); skip them
+    QSqlQuery mq(m_db);
+    mq.exec("SELECT profile_id, physical_input, action, parameters FROM controller_mappings");
+    while (mq.next()) {
+        auto it = m_profiles.find(mq.value("profile_id").toInt());
+        if (it == m_profiles.end()) continue;
+        ControllerMapping mapping;
+        mapping.physicalInput = mq.value("physical_input").toString();
+        mapping.action = mq.value("action").toString();
+        mapping.parameters = parseParameters(mq.value("parameters").toString());
+        it->mappings[mapping.physicalInput] = mapping;
     }
 
-    buildMergedCache();
+    m_storeLoaded = true;
 }
 
-ControllerProfile ProfileResolver::loadProfileFromDb(const QString &scope, const QString &family,
-                                                       const QString &clientId, int gameId) {
-    ControllerProfile profile;
-    QSqlQuery q(m_db);
+// Same picks as the old per-layer SQL: the family-specific profile over
+// an "any" one, then the lowest id
+const ControllerProfile *ProfileResolver::findProfile(const QString &scope, const QString &family,
+                                                      const QString &clientId, int gameId) const {
+    const ControllerProfile *best = nullptr;
+    int bestRank = 0;
+    for (auto it = m_profiles.cbegin(); it != m_profiles.cend(); ++it) {
+        const ControllerProfile &p = it.value();
+        if (p.scope != scope) continue;
+
+        int rank = 0;
+        if (scope == "family") {
+            if (p.controllerFamily != family) continue;
+        } else if (scope == "client" || scope == "game") {
+            if (scope == "client" ? p.clientId != clientId : p.gameId != gameId) continue;
+            if (p.controllerFamily == family) rank = 0;
+            else if (p.controllerFamily == "any") rank = 1;
+            else continue;
+        }
 
-    if (scope == "global") {
-        q.prepare("SELECT * FROM controller_profiles WHERE scope = 'global' LIMIT 1");
-    } else if (scope == "family") {
-        q.prepare("SELECT * FROM controller_profiles WHERE scope = 'family' AND controller_family = ? LIMIT 1");
-        q.addBindValue(family);
-    } else if (scope == "client") {
-        q.prepare("SELECT * FROM controller_profiles WHERE scope = 'client' AND client_id = ? "
-                  "AND (controller_family = ? OR controller_family = 'any') "
-                  "ORDER BY CASE WHEN controller_family = ? THEN 0 ELSE 1 END LIMIT 1");
-        q.addBindValue(clientId);
-        q.addBindValue(family);
-        q.addBindValue(family);
-    } else if (scope == "game") {
-        q.prepare("SELECT * FROM controller_profiles WHERE scope = 'game' AND game_id = ? "
-                  "AND (controller_family = ? OR controller_family = 'any') "
-                  "ORDER BY CASE WHEN controller_family = ? THEN 0 ELSE 1 END LIMIT 1");
-        q.addBindValue(gameId);
-        q.addBindValue(family);
-        q.addBindValue(family);
+        if (!best || rank < bestRank || (rank == bestRank && p.id < best->id)) {
+            best = &p;
+            bestRank = rank;
+        }
     }
+    return best;
+}
 
-    if (!q.exec() || !q.next()) return profile;
+QString ProfileResolver::contextKey(ControllerFamily family, const QString &clientId, int gameId) {
+    return familyToString(family) + '|' + clientId + '|' + QString::number(gameId);
+}
 
-    profile.id = q.value("id").toInt();
-    profile.name = q.value("name").toString();
-    profile.scope = q.value("scope").toString();
-    profile.controllerFamily = q.value("controller_family").toString();
-    profile.clientId = q.value("client_id").toString();
-    profile.gameId = q.value("game_id").toInt();
-    profile.isDefault = q.value("is_default").toBool();
+void ProfileResolver::loadProfiles() {
+    m_current = contextFor(m_family);
+}
 
-    // Load mappings
-    QSqlQuery mq(m_db);
-    mq.prepare("SELECT * FROM controller_mappings WHERE profile_id = ?");
-    mq.addBindValue(profile.id);
-    if (mq.exec()) {
-        while (mq.next()) {
-            ControllerMapping mapping;
-            mapping.physicalInput = mq.value("physical_input").toString();
-            mapping.action = mq.value("action").toString();
-            QString paramsStr = mq.value("parameters").toString();
-            if (!paramsStr.isEmpty()) {
-                mapping.parameters = QJsonDocument::fromJson(paramsStr.toUtf8()).object();
-            }
-            profile.mappings[mapping.physicalInput] = mapping;
-        }
+ProfileResolver::ContextPtr ProfileResolver::contextFor(ControllerFamily family) {
+    if (!m_storeLoaded) {
+        if (!m_db.isOpen()) return m_current;   // no database yet
+        loadStore();
     }
 
-    return profile;
+    const QString key = contextKey(family, m_clientId, m_gameId);
+    auto it = m_contexts.constFind(key);
+    if (it == m_contexts.constEnd())
+        it = m_contexts.insert(key, compileContext(family, m_clientId, m_gameId));
+    return it.value();
 }
 
-void ProfileResolver::buildMergedCache() {
-    m_actionCache.clear();
-    m_inputCache.clear();
-    m_paramsCache.clear();
+ProfileResolver::ContextPtr ProfileResolver::compileContext(ControllerFamily family,
+                                                            const QString &clientId, int gameId) const {
+    auto context = std::make_shared<CompiledContext>();
+    context->family = family;
+    context->clientId = clientId;
+    context->gameId = gameId;
+
+    const QString familyName = familyToString(family);
+    QList<const ControllerProfile*> layers;
+    layers << findProfile("global", "any", QString(), 0);
+    layers << findProfile("family", familyName, QString(), 0);
+    if (!clientId.isEmpty())
+        layers << findProfile("client", familyName, clientId, 0);
+    if (gameId > 0)
+        layers << findProfile("game", familyName, QString(), gameId);
 
     // Merge in specificity order: global → family → client → game
     // Later layers override earlier ones
-    auto mergeProfile = [this](const ControllerProfile &profile) {
-        for (auto it = profile.mappings.begin(); it != profile.mappings.end(); ++it) {
-            m_actionCache[it.key()] = it.value().action;
-            m_inputCache[it.value().action] = it.key();
-            if (!it.value().parameters.isEmpty()) {
-                m_paramsCache[it.key()] = it.value().parameters;
+    for (const ControllerProfile *profile : layers) {
+        if (!profile) continue;
+        context->layers.append(profile->id);
+        for (auto it = profile->mappings.begin(); it != profile->mappings.end(); ++it) {
+            context->inputByAction[it.value().action] = it.key();
+            ResolvedInput &slot = context->inputs[int(inputFromName(it.key()))];
+            slot.action = it.value().action;
+            const QJsonObject &params = it.value().parameters;
+            if (!params.isEmpty()) {
+                context->params[it.key()] = params;
+                slot.params = InputParameters();
+                slot.params.deadzone = params.value("deadzone").toInt(slot.params.deadzone);
+                slot.params.threshold = params.value("threshold").toInt(slot.params.threshold);
+                slot.params.repeatDelayMs = params.value("repeat_delay_ms").toInt(slot.params.repeatDelayMs);
+                slot.params.repeatRate = params.value("repeat_rate").toDouble(slot.params.repeatRate);
+                slot.params.repeatMaxRate = params.value("repeat_max_rate").toDouble(slot.params.repeatMaxRate);
+                slot.params.repeatAccelMs = params.value("repeat_accel_ms").toInt(slot.params.repeatAccelMs);
             }
         }
-    };
+    }
+
+    // Names outside the enum land in the None slot; keep it empty
+    context->inputs[int(PhysicalInput::None)] = ResolvedInput();
+
+    const QStringList actions = allActions();
+    for (ResolvedInput &slot : context->inputs) {
+        if (!slot.action.isEmpty())
+            slot.actionIndex = actions.indexOf(slot.action);
+    }
+    return context;
+}
+
+// ── Invalidation ─────────────────────────────────────────────────────
 
-    mergeProfile(m_globalProfile);
-    if (m_familyProfile.id > 0) mergeProfile(m_familyProfile);
-    if (m_clientProfile.id > 0) mergeProfile(m_clientProfile);
-    if (m_gameProfile.id > 0) mergeProfile(m_gameProfile);
+bool ProfileResolver::couldSelect(const CompiledContext &context, const ControllerProfile &profile) {
+    const QString familyName = familyToString(context.family);
+    const bool familyOk = profile.controllerFamily == familyName || profile.controllerFamily == "any";
+    if (profile.scope == "global") return true;
+    if (profile.scope == "family") return profile.controllerFamily == familyName;
+    if (profile.scope == "client") return familyOk && profile.clientId == context.clientId;
+    if (profile.scope == "game")   return familyOk && profile.gameId == context.gameId;
+    return false;
+}
+
+void ProfileResolver::invalidateLayer(int profileId) {
+    for (auto it = m_contexts.begin(); it != m_contexts.end();) {
+        if (it.value()->layers.contains(profileId)) it = m_contexts.erase(it);
+        else ++it;
+    }
+}
+
+void ProfileResolver::invalidateCandidates(const ControllerProfile &profile) {
+    for (auto it = m_contexts.begin(); it != m_contexts.end();) {
+        if (couldSelect(*it.value(), profile)) it = m_contexts.erase(it);
+        else ++it;
+    }
 }
 
 // ── Profile CRUD ─────────────────────────────────────────────────────
@@ -368,6 +463,18 @@ int ProfileResolver::createProfile(const QString &name, const QString &scope,
 
     if (q.exec()) {
         int id = q.lastInsertId().toInt();
+        if (m_storeLoaded) {
+            ControllerProfile profile;
+            profile.id = id;
+            profile.name = name;
+            profile.scope = scope;
+            profile.controllerFamily = controllerFamily;
+            profile.clientId = clientId;
+            profile.gameId = gameId > 0 ? gameId : 0;
+            m_profiles.insert(id, profile);
+            invalidateCandidates(profile);
+            loadProfiles();
+        }
         emit profilesChanged();
         return id;
     }
@@ -376,11 +483,11 @@ int ProfileResolver::createProfile(const QString &name, const QString &scope,
 }
 
 bool ProfileResolver::deleteProfile(int profileId) {
+    if (!m_storeLoaded) loadStore();
+
     // Don't delete built-in defaults
-    QSqlQuery check(m_db);
-    check.prepare("SELECT is_default FROM controller_profiles WHERE id = ?");
-    check.addBindValue(profileId);
-    if (check.exec() && check.next() && check.value(0).toBool()) {
+    auto it = m_profiles.find(profileId);
+    if (it != m_profiles.end() && it->isDefault) {
         qWarning() << "Cannot delete built-in default profile";
         return false;
     }
@@ -389,7 +496,16 @@ bool ProfileResolver::deleteProfile(int profileId) {
     q.prepare("DELETE FROM controller_profiles WHERE id = ?");
     q.addBindValue(profileId);
     if (q.exec()) {
-        reload();
+        if (it != m_profiles.end()) {
+            // Contexts that merged it, and those that now fall back to
+            // another profile of the same scope
+            const ControllerProfile removed = it.value();
+            m_profiles.erase(it);
+            invalidateLayer(profileId);
+            invalidateCandidates(removed);
+            loadProfiles();
+        }
+        emit profilesChanged();
         return true;
     }
     return false;
@@ -412,7 +528,18 @@ bool ProfileResolver::setMapping(int profileId, const QString &physicalInput,
         ts.addBindValue(profileId);
         ts.exec();
 
-        reload();
+        if (!m_storeLoaded) loadStore();
+        auto it = m_profiles.find(profileId);
+        if (it != m_profiles.end()) {
+            ControllerMapping mapping;
+            mapping.physicalInput = physicalInput;
+            mapping.action = action;
+            mapping.parameters = parseParameters(parameters);
+            it->mappings[physicalInput] = mapping;
+            invalidateLayer(profileId);
+            loadProfiles();
+        }
+        emit profilesChanged();
         return true;
     }
     qWarning() << "Failed to set mapping:" << q.lastError().text();
@@ -425,7 +552,14 @@ bool ProfileResolver::removeMapping(int profileId, const QString &physicalInput)
     q.addBindValue(profileId);
     q.addBindValue(physicalInput);
     if (q.exec()) {
-        reload();
+        if (!m_storeLoaded) loadStore();
+        auto it = m_profiles.find(profileId);
+        if (it != m_profiles.end()) {
+            it->mappings.remove(physicalInput);
+            invalidateLayer(profileId);
+            loadProfiles();
+        }
+        emit profilesChanged();
         return true;
     }
     return false;
@@ -526,26 +660,60 @@ QString ProfileResolver::controllerFamilyName() const {
 }
 
 QString ProfileResolver::sdlButtonToPositional(int sdlButton) {
+    PhysicalInput input = sdlButtonToInput(sdlButton);
+    return input == PhysicalInput::None ? QString() : inputName(input);
+}
+
+PhysicalInput ProfileResolver::sdlButtonToInput(int sdlButton) {
     switch (sdlButton) {
-    case SDL_CONTROLLER_BUTTON_A:             return "button_south";
-    case SDL_CONTROLLER_BUTTON_B:             return "button_east";
-    case SDL_CONTROLLER_BUTTON_X:             return "button_west";
-    case SDL_CONTROLLER_BUTTON_Y:             return "button_north";
-    case SDL_CONTROLLER_BUTTON_DPAD_UP:       return "dpad_up";
-    case SDL_CONTROLLER_BUTTON_DPAD_DOWN:     return "dpad_down";
-    case SDL_CONTROLLER_BUTTON_DPAD_LEFT:     return "dpad_left";
-    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT:    return "dpad_right";
-    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:  return "shoulder_left";
-    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER: return "shoulder_right";
-    case SDL_CONTROLLER_BUTTON_START:         return "button_start";
-    case SDL_CONTROLLER_BUTTON_BACK:          return "button_back";
-    case SDL_CONTROLLER_BUTTON_GUIDE:         return "button_guide";
-    case SDL_CONTROLLER_BUTTON_LEFTSTICK:     return "stick_left_click";
-    case SDL_CONTROLLER_BUTTON_RIGHTSTICK:    return "stick_right_click";
-    default: return QString();
+    case SDL_CONTROLLER_BUTTON_A:             return PhysicalInput::ButtonSouth;
+    case SDL_CONTROLLER_BUTTON_B:             return PhysicalInput::ButtonEast;
+    case SDL_CONTROLLER_BUTTON_X:             return PhysicalInput::ButtonWest;
+    case SDL_CONTROLLER_BUTTON_Y:             return PhysicalInput::ButtonNorth;
+    case SDL_CONTROLLER_BUTTON_DPAD_UP:       return PhysicalInput::DpadUp;
+    case SDL_CONTROLLER_BUTTON_DPAD_DOWN:     return PhysicalInput::DpadDown;
+    case SDL_CONTROLLER_BUTTON_DPAD_LEFT:     return PhysicalInput::DpadLeft;
+    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT:    return PhysicalInput::DpadRight;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:  return PhysicalInput::ShoulderLeft;
+    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER: return PhysicalInput::ShoulderRight;
+    case SDL_CONTROLLER_BUTTON_START:         return PhysicalInput::ButtonStart;
+    case SDL_CONTROLLER_BUTTON_BACK:          return PhysicalInput::ButtonBack;
+    case SDL_CONTROLLER_BUTTON_GUIDE:         return PhysicalInput::ButtonGuide;
+    case SDL_CONTROLLER_BUTTON_LEFTSTICK:     return PhysicalInput::StickLeftClick;
+    case SDL_CONTROLLER_BUTTON_RIGHTSTICK:    return PhysicalInput::StickRightClick;
+    default: return PhysicalInput::None;
     }
 }
 
+// Indexed by PhysicalInput
+static const char *const INPUT_NAMES[] = {
+    "button_south", "button_east", "button_west", "button_north",
+    "dpad_up", "dpad_down", "dpad_left", "dpad_right",
+    "shoulder_left", "shoulder_right",
+    "button_start", "button_back", "button_guide",
+    "stick_left_click", "stick_right_click",
+    "stick_left_up", "stick_left_down", "stick_left_left", "stick_left_right",
+    "stick_right_up", "stick_right_down", "stick_right_left", "stick_right_right",
+    "trigger_left", "trigger_right",
+};
+static_assert(sizeof(INPUT_NAMES) / sizeof(INPUT_NAMES[0]) == int(PhysicalInput::Count),
+              "INPUT_NAMES must list every PhysicalInput");
+
+QString ProfileResolver::inputName(PhysicalInput input) {
+    if (input >= PhysicalInput::Count) return QString();
+    return QString::fromLatin1(INPUT_NAMES[int(input)]);
+}
+
+PhysicalInput ProfileResolver::inputFromName(const QString &name) {
+    static const QHash<QString, PhysicalInput> byName = []() {
+        QHash<QString, PhysicalInput> map;
+        for (int i = 0; i < int(PhysicalInput::Count); i++)
+            map.insert(QString::fromLatin1(INPUT_NAMES[i]), PhysicalInput(i));
+        return map;
+    }();
+    return byName.value(name, PhysicalInput::None);
+}
+
 QString ProfileResolver::sdlAxisToPositional(int sdlAxis) {
     switch (sdlAxis) {
     case SDL_CONTROLLER_AXIS_LEFTX:       return "axis_leftx";
@@ -565,7 +733,8 @@ QStringList ProfileResolver::allActions() {
         "navigate_up", "navigate_down", "navigate_left", "navigate_right",
         "previous_tab", "next_tab",
         "filters", "sort",
-        "scroll_up", "scroll_down"
+        "scroll_up", "scroll_down",
+        "jump_previous", "jump_next"
     };
 }
 
@@ -587,6 +756,8 @@ QString ProfileResolver::actionDisplayName(const QString &action) {
         {"sort",           "Sort"},
         {"scroll_up",      "Scroll Up"},
         {"scroll_down",    "Scroll Down"},
+        {"jump_previous",  "Jump to Previous Letter"},
+        {"jump_next",      "Jump to Next Letter"},
     };
     return names.value(action, action);
 }
@@ -6,6 +6,7 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QJsonObject>
+#include <memory>
 
 // Controller family classification
 enum class ControllerFamily {
@@ -16,6 +17,41 @@ enum class ControllerFamily {
     Generic
 };
 
+// Physical inputs in positional naming; inputName() gives the string
+// used in profiles ("button_south", "stick_left_up", ...)
+enum class PhysicalInput : quint8 {
+    ButtonSouth, ButtonEast, ButtonWest, ButtonNorth,
+    DpadUp, DpadDown, DpadLeft, DpadRight,
+    ShoulderLeft, ShoulderRight,
+    ButtonStart, ButtonBack, ButtonGuide,
+    StickLeftClick, StickRightClick,
+    StickLeftUp, StickLeftDown, StickLeftLeft, StickLeftRight,
+    StickRightUp, StickRightDown, StickRightLeft, StickRightRight,
+    TriggerLeft, TriggerRight,
+    Count,
+    None = Count
+};
+
+// Mapping parameters, decoded from the JSON once per cascade build
+struct InputParameters {
+    int deadzone = 8000;
+    int threshold = 8000;
+    // Stick hold-to-repeat curve: first repeat after repeat_delay_ms, then
+    // repeat_rate per second rising to repeat_max_rate over repeat_accel_ms
+    // of holding, all scaled by how far the stick is pushed
+    int repeatDelayMs = 250;
+    double repeatRate = 5.0;
+    double repeatMaxRate = 25.0;
+    int repeatAccelMs = 2000;
+};
+
+// One slot of the compiled cascade
+struct ResolvedInput {
+    QString action;          // empty when the input is unmapped
+    int actionIndex = -1;    // position in allActions(), -1 if not a built-in action
+    InputParameters params;
+};
+
 // A single mapping entry: physical input → action + optional parameters
 struct ControllerMapping {
     QString physicalInput;  // e.g. "button_south", "axis_lefty", "trigger_left"
@@ -42,8 +78,31 @@ class ProfileResolver : public QObject {
     Q_PROPERTY(int currentGameId READ currentGameId NOTIFY contextChanged)
 
 public:
+    // One context's merged global → family → client → game cascade
+    struct CompiledContext {
+        ControllerFamily family = ControllerFamily::Generic;
+        QString clientId;
+        int gameId = 0;
+        QList<int> layers;   // ids of the merged profiles, global first
+        // One slot per PhysicalInput (+1 for None, always empty)
+        ResolvedInput inputs[int(PhysicalInput::Count) + 1];
+        // Reverse cache: action → physicalInput
+        QHash<QString, QString> inputByAction;
+        // Parameters cache: physicalInput → parameters (string API only)
+        QHash<QString, QJsonObject> params;
+    };
+    using ContextPtr = std::shared_ptr<const CompiledContext>;
+
     explicit ProfileResolver(QObject *parent = nullptr);
 
+    // Hot path: the merged cascade compiled into a table indexed by input
+    const ResolvedInput &resolve(PhysicalInput input) const { return m_current->inputs[int(input)]; }
+
+    // The table for another controller family in the current client/game
+    // context, for pads other than the one the context was set for.
+    // Stale after contextChanged/profilesChanged; fetch it again then.
+    ContextPtr contextFor(ControllerFamily family);
+
     // Core resolution: physical input → action ID
     QString resolveAction(const QString &physicalInput) const;
 
@@ -53,13 +112,14 @@ public:
     // Get parameters for a physical input (deadzone, threshold, etc.)
     QJsonObject resolveParameters(const QString &physicalInput) const;
 
-    // Set the current context — loads appropriate profiles from DB
+    // Set the current context — picks the memoised merged table for it,
+    // compiling it from the in-memory profile store on first use
     void setContext(const QString &clientId, int gameId, ControllerFamily family);
 
     // Set just the controller family (on controller connect)
     void setControllerFamily(ControllerFamily family);
 
-    // Reload profiles from database (after user edits a profile)
+    // Re-read every profile from the database and drop all merged tables
     void reload();
 
     // Database initialization
@@ -96,6 +156,9 @@ public:
     static ControllerFamily stringToFamily(const QString &str);
     static QString sdlButtonToPositional(int sdlButton);
     static QString sdlAxisToPositional(int sdlAxis);
+    static PhysicalInput sdlButtonToInput(int sdlButton);
+    static QString inputName(PhysicalInput input);
+    static PhysicalInput inputFromName(const QString &name);
 
     // All defined action IDs
     static QStringList allActions();
@@ -107,27 +170,30 @@ signals:
 
 private:
     void loadProfiles();
-    void buildMergedCache();
-    ControllerProfile loadProfileFromDb(const QString &scope, const QString &family,
-                                         const QString &clientId, int gameId);
+    void loadStore();
+    ContextPtr compileContext(ControllerFamily family, const QString &clientId, int gameId) const;
+    const ControllerProfile *findProfile(const QString &scope, const QString &family,
+                                         const QString &clientId, int gameId) const;
+    static bool couldSelect(const CompiledContext &context, const ControllerProfile &profile);
+    static QString contextKey(ControllerFamily family, const QString &clientId, int gameId);
+    // Drop merged tables that used profileId / that profile could now be picked for
+    void invalidateLayer(int profileId);
+    void invalidateCandidates(const ControllerProfile &profile);
+    static QJsonObject parseParameters(const QString &json);
 
     QSqlDatabase m_db;
     ControllerFamily m_family = ControllerFamily::Generic;
     QString m_clientId;
     int m_gameId = 0;
 
-    // Loaded profiles per layer
-    ControllerProfile m_globalProfile;
-    ControllerProfile m_familyProfile;
-    ControllerProfile m_clientProfile;
-    ControllerProfile m_gameProfile;
-
-    // Merged cache: physicalInput → action (O(1) lookup)
-    QHash<QString, QString> m_actionCache;
-    // Reverse cache: action → physicalInput
-    QHash<QString, QString> m_inputCache;
-    // Parameters cache: physicalInput → parameters
-    QHash<QString, QJsonObject> m_paramsCache;
+    // Every controller_profiles row with its mappings, read once and kept
+    // in step by the CRUD methods
+    QHash<int, ControllerProfile> m_profiles;
+    bool m_storeLoaded = false;
+
+    // Merged tables per (family, client, game), built on first use
+    QHash<QString, ContextPtr> m_contexts;
+    ContextPtr m_current;
 };
 
 #endif
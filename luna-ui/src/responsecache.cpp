@@ -0,0 +1,132 @@
+#include "responsecache.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+#include <algorithm>
+
+// Bump when the on-disk record layout changes; older files are ignored
+static const quint32 CACHE_FORMAT = 1;
+
+ResponseCache::ResponseCache() {
+    // Cost is body size in KiB; deal pages are ~50 KiB each
+    m_memory.setMaxCost(8 * 1024);
+    m_dir = QDir::homePath() + "/.local/share/luna-ui/http-cache";
+    QDir().mkpath(m_dir);
+    // One thread: writes and evictions never race each other
+    m_writer.setMaxThreadCount(1);
+}
+
+ResponseCache::~ResponseCache() {
+    // Let pending writes land; they are the freshest data we have
+    m_writer.waitForDone();
+}
+
+QString ResponseCache::pathFor(const QString& key) const {
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_dir + "/" + QString::fromLatin1(hash);
+}
+
+bool ResponseCache::lookup(const QString& key, Entry *out) {
+    if (Entry *e = m_memory.object(key)) {
+        *out = *e;
+        return true;
+    }
+
+    QFile file(pathFor(key));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    quint32 format = 0;
+    QString storedKey;
+    Entry entry;
+    in >> format >> storedKey >> entry.storedAt >> entry.body;
+    if (in.status() != QDataStream::Ok || format != CACHE_FORMAT || storedKey != key)
+        return false;
+
+    m_memory.insert(key, new Entry(entry), qMax<qsizetype>(1, entry.body.size() / 1024));
+    *out = entry;
+    return true;
+}
+
+bool ResponseCache::contains(const QString& key) {
+    return m_memory.contains(key) || QFile::exists(pathFor(key));
+}
+
+void ResponseCache::store(const QString& key, const QByteArray& body) {
+    Entry *entry = new Entry;
+    entry->body = body;
+    entry->storedAt = QDateTime::currentSecsSinceEpoch();
+    const qint64 storedAt = entry->storedAt;
+
+    // Memory is updated now, so lookups never wait for the file
+    m_memory.insert(key, entry, qMax<qsizetype>(1, body.size() / 1024));
+
+    const QString path = pathFor(key);
+    m_writer.start([this, key, body, storedAt, path]() {
+        scanDisk();
+        // QSaveFile renames into place, so a concurrent disk lookup sees
+        // either the old record or the new one, never half of it
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) return;
+        QDataStream out(&file);
+        out << CACHE_FORMAT << key << storedAt << body;
+        const qint64 size = file.pos();
+        if (!file.commit()) return;
+
+        noteDiskFile(QFileInfo(path).fileName(), size, QDateTime::currentMSecsSinceEpoch());
+        if (m_diskBytes > DiskCapBytes)
+            evictDisk();
+    });
+}
+
+void ResponseCache::clear() {
+    m_memory.clear();
+    m_writer.start([this]() {
+        QDir dir(m_dir);
+        for (const QString& name : dir.entryList(QDir::Files))
+            dir.remove(name);
+        m_diskFiles.clear();
+        m_diskBytes = 0;
+        m_diskScanned = true;
+    });
+}
+
+// ─── Disk bound (writer thread) ───
+
+void ResponseCache::scanDisk() {
+    if (m_diskScanned) return;
+    m_diskScanned = true;
+    const QFileInfoList files = QDir(m_dir).entryInfoList(QDir::Files);
+    for (const QFileInfo& info : files)
+        noteDiskFile(info.fileName(), info.size(), info.lastModified().toMSecsSinceEpoch());
+}
+
+void ResponseCache::noteDiskFile(const QString& name, qint64 size, qint64 storedAt) {
+    DiskFile& f = m_diskFiles[name];
+    m_diskBytes += size - f.size;
+    f.size = size;
+    f.storedAt = storedAt;
+}
+
+void ResponseCache::evictDisk() {
+    // Oldest first, down to 3/4 of the cap so the next few stores don't
+    // each trigger another pass
+    QVector<QPair<qint64, QString>> byAge;
+    byAge.reserve(m_diskFiles.size());
+    for (auto it = m_diskFiles.cbegin(); it != m_diskFiles.cend(); ++it)
+        byAge.append({it->storedAt, it.key()});
+    std::sort(byAge.begin(), byAge.end());
+
+    const qint64 target = DiskCapBytes / 4 * 3;
+    QDir dir(m_dir);
+    for (const auto& entry : byAge) {
+        if (m_diskBytes <= target) break;
+        dir.remove(entry.second);
+        m_diskBytes -= m_diskFiles.take(entry.second).size;
+    }
+}
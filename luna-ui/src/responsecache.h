@@ -0,0 +1,59 @@
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+
+// Two-tier cache of raw API response bodies for StoreApiManager.
+//
+// Entries live in a size-bounded in-memory QCache and are mirrored to
+// ~/.local/share/luna-ui/http-cache/ (one file per key, named by the
+// SHA-1 of the key) so the store renders from the last good data after
+// a restart or with no network.  The cache only stores bodies and their
+// age; freshness policy is up to the caller.
+//
+// Disk writes and eviction run on a private single-thread pool, so the
+// GUI thread never waits on the disk when storing.  The directory is
+// capped at DiskCapBytes; past that the oldest files are removed first.
+class ResponseCache {
+public:
+    struct Entry {
+        QByteArray body;
+        qint64 storedAt = 0;   // epoch secs
+    };
+
+    ResponseCache();
+    ~ResponseCache();
+
+    // Memory first, then disk (promoting the hit back into memory)
+    bool lookup(const QString& key, Entry *out);
+    void store(const QString& key, const QByteArray& body);
+    bool contains(const QString& key);
+    void clear();
+
+private:
+    static constexpr qint64 DiskCapBytes = 64 * 1024 * 1024;
+
+    QCache<QString, Entry> m_memory;
+    QString m_dir;
+
+    // Writer thread only
+    QThreadPool m_writer;
+    struct DiskFile {
+        qint64 size = 0;
+        qint64 storedAt = 0;   // mtime, epoch msecs
+    };
+    QHash<QString, DiskFile> m_diskFiles;   // file name → size / age
+    qint64 m_diskBytes = 0;
+    bool m_diskScanned = false;
+    void scanDisk();
+    void noteDiskFile(const QString& name, qint64 size, qint64 storedAt);
+    void evictDisk();
+
+    QString pathFor(const QString& key) const;
+};
+
+#endif
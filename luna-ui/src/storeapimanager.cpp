@@ -1,7 +1,8 @@
 #include "storeapimanager.h"
 #include "credentialstore.h"
+#include "responsecache.h"
+#include "database.h"
 #include <QNetworkAccessManager>
-#include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -12,9 +13,11 @@
 #include <QDir>
 #include <QFile>
 #include <QDateTime>
+#include <QTimer>
 #include <QDebug>
 #include <memory>
 #include <cmath>
+#include <utility>
 
 static const QString CHEAPSHARK_BASE = "https://www.cheapshark.com/api/1.0";
 static const QString PROTONDB_BASE   = "https://www.protondb.com/api/v1/reports/summaries";
@@ -23,20 +26,720 @@ static const QString TWITCH_TOKEN    = "https://id.twitch.tv/oauth2/token";
 static const QString STEAM_CDN       = "https://cdn.akamai.steamstatic.com/steam/apps";
 static const QString STEAM_STORE_API = "https://store.steampowered.com/api";
 
-// Normalize a game title for fuzzy matching
+// Response cache policy per endpoint: served straight from cache while
+// fresh, served and refreshed in the background while stale, and served
+// regardless of age when the network fails.
+static const StoreApiManager::CachePolicy STORES_CACHE      { 7 * 86400, 30 * 86400 };
+static const StoreApiManager::CachePolicy DEALS_CACHE       { 10 * 60,   86400 };
+static const StoreApiManager::CachePolicy RECENT_CACHE      { 5 * 60,    86400 };
+static const StoreApiManager::CachePolicy GAME_DEALS_CACHE  { 15 * 60,   86400 };
+static const StoreApiManager::CachePolicy IGDB_INFO_CACHE   { 7 * 86400, 30 * 86400 };
+static const StoreApiManager::CachePolicy PROTON_CACHE      { 86400,     7 * 86400 };
+
+// Library-wide ProtonDB prefetch: ratings older than this are refetched,
+// at most one request per interval so a large library never bursts.
+static const qint64 PROTON_RATING_TTL = 7 * 86400;
+static const int PROTON_PREFETCH_INTERVAL_MS = 1000;
+
+// Scraped store prices are served from games.db; older snapshots are
+// refreshed in the background, one game per interval
+static const qint64 PRICE_SNAPSHOT_TTL = 6 * 3600;
+static const int PRICE_REFRESH_INTERVAL_MS = 2000;
+
+// Network search waits for this long a pause in typing
+static const int SEARCH_DEBOUNCE_MS = 350;
+static const int LOCAL_SEARCH_LIMIT = 8;
+
+// Normalize a game title for fuzzy matching; the same keys as the
+// library's title identity index
 static QString normalizeTitle(const QString& title) {
-    QString norm = title.toLower().trimmed();
-    // Remove common suffixes/prefixes, punctuation
-    norm.remove(QRegularExpression("[^a-z0-9 ]"));
-    // Collapse whitespace
-    norm = norm.simplified();
-    return norm;
+    return Database::normalizeTitle(title);
+}
+
+// ── Response decoding ──
+// Everything below runs on the decode pool, so it touches no members.
+
+static QString steamHeaderUrl(const QString& appId) {
+    return STEAM_CDN + "/" + appId + "/header.jpg";
+}
+
+static QString steamHeroUrl(const QString& appId) {
+    return STEAM_CDN + "/" + appId + "/library_hero.jpg";
+}
+
+static QString steamCapsuleUrl(const QString& appId) {
+    return STEAM_CDN + "/" + appId + "/library_600x900_2x.jpg";
+}
+
+// Library game owning this store item (by Steam appId, then title), or 0
+static int ownedGameId(const QHash<QString, int>& owned, const QString& steamAppId,
+                       const QString& title) {
+    if (owned.isEmpty()) return 0;
+    if (!steamAppId.isEmpty() && steamAppId != "null" && steamAppId != "0") {
+        if (int id = owned.value("steam:" + steamAppId))
+            return id;
+    }
+    return owned.value("title:" + normalizeTitle(title));
+}
+
+static void tagOwned(const QHash<QString, int>& owned, QVariantMap& item) {
+    if (int id = ownedGameId(owned, item["steamAppID"].toString(), item["title"].toString())) {
+        item["owned"] = true;
+        item["libraryGameId"] = id;
+    }
+}
+
+// CheapShark /deals, deduplicated to the first (best) deal per game
+static QVariantList parseDealList(const QByteArray& body, const QHash<QString, int>& owned) {
+    QJsonArray arr = QJsonDocument::fromJson(body).array();
+    QVariantList deals;
+    QSet<QString> seenGameIDs;
+    for (const auto& val : arr) {
+        QJsonObject obj = val.toObject();
+        QString gameId = obj["gameID"].toString();
+
+        // Deduplicate: keep only the first (best) deal per game
+        if (seenGameIDs.contains(gameId))
+            continue;
+        seenGameIDs.insert(gameId);
+
+        QVariantMap deal;
+        deal["dealID"]       = obj["dealID"].toString();
+        deal["title"]        = obj["title"].toString();
+        deal["salePrice"]    = obj["salePrice"].toString();
+        deal["normalPrice"]  = obj["normalPrice"].toString();
+        deal["savings"]      = obj["savings"].toString();
+        deal["metacriticScore"]    = obj["metacriticScore"].toString();
+        deal["steamRatingText"]    = obj["steamRatingText"].toString();
+        deal["steamRatingPercent"] = obj["steamRatingPercent"].toString();
+        deal["steamAppID"]   = obj["steamAppID"].toString();
+        deal["gameID"]       = gameId;
+        deal["storeID"]      = obj["storeID"].toString();
+        deal["dealRating"]   = obj["dealRating"].toString();
+        deal["releaseDate"]  = obj["releaseDate"].toInteger();
+        deal["thumb"]        = obj["thumb"].toString();
+        deal["isOnSale"]     = obj["isOnSale"].toString();
+
+        // Construct higher-quality image URLs from steamAppID
+        QString appId = obj["steamAppID"].toString();
+        if (!appId.isEmpty() && appId != "null" && appId != "0") {
+            deal["headerImage"] = steamHeaderUrl(appId);
+            deal["heroImage"]   = steamHeroUrl(appId);
+            deal["capsuleImage"] = steamCapsuleUrl(appId);
+        } else {
+            deal["headerImage"] = obj["thumb"].toString();
+            deal["heroImage"]   = obj["thumb"].toString();
+            deal["capsuleImage"] = obj["thumb"].toString();
+        }
+        tagOwned(owned, deal);
+
+        deals.append(deal);
+    }
+
+    return deals;
+}
+
+// IGDB /games search, platform-filtered to Windows + Linux by the query
+static QVariantList parseIgdbSearch(const QByteArray& body) {
+    QVariantList results;
+    QJsonArray arr = QJsonDocument::fromJson(body).array();
+    for (const auto& val : arr) {
+        QJsonObject obj = val.toObject();
+        QVariantMap game;
+        game["igdbId"] = obj["id"].toInt();
+        game["title"]  = obj["name"].toString();
+        game["summary"] = obj["summary"].toString();
+        game["rating"]  = obj["total_rating"].toDouble();
+        game["aggregatedRating"] = obj["aggregated_rating"].toDouble();
+
+        // Release date
+        if (obj.contains("first_release_date")) {
+            qint64 ts = obj["first_release_date"].toInteger();
+            game["releaseDate"] = QDateTime::fromSecsSinceEpoch(ts).toString("MMM d, yyyy");
+        }
+
+        // Cover URL
+        if (obj.contains("cover")) {
+            QString coverUrl = obj["cover"].toObject()["url"].toString();
+            if (coverUrl.startsWith("//"))
+                coverUrl = "https:" + coverUrl;
+            coverUrl.replace("t_thumb", "t_cover_big");
+            game["coverUrl"] = coverUrl;
+            // Also use as header image fallback
+            QString headerUrl = coverUrl;
+            headerUrl.replace("t_cover_big", "t_screenshot_big");
+            game["igdbHeaderUrl"] = headerUrl;
+        }
+
+        // Screenshots
+        QVariantList screenshots;
+        QJsonArray ssArr = obj["screenshots"].toArray();
+        for (const auto& ss : ssArr) {
+            QString ssUrl = ss.toObject()["url"].toString();
+            if (ssUrl.startsWith("//"))
+                ssUrl = "https:" + ssUrl;
+            ssUrl.replace("t_thumb", "t_screenshot_big");
+            screenshots.append(ssUrl);
+        }
+        game["screenshots"] = screenshots;
+
+        // Genres
+        QStringList genres;
+        QJsonArray genreArr = obj["genres"].toArray();
+        for (const auto& g : genreArr)
+            genres.append(g.toObject()["name"].toString());
+        game["genres"] = genres.join(", ");
+
+        // Platforms
+        QStringList platforms;
+        QJsonArray platArr = obj["platforms"].toArray();
+        for (const auto& p : platArr)
+            platforms.append(p.toObject()["name"].toString());
+        game["platforms"] = platforms.join(", ");
+
+        // Extract Steam App ID from external_games (category 1 = Steam)
+        QJsonArray extArr = obj["external_games"].toArray();
+        for (const auto& ext : extArr) {
+            QJsonObject extObj = ext.toObject();
+            if (extObj["category"].toInt() == 1) {
+                game["steamAppID"] = extObj["uid"].toString();
+                break;
+            }
+        }
+
+        // Extract purchase URLs from websites
+        // Categories: 13=Steam, 15=Itch.io, 16=Epic Games, 17=GOG
+        QVariantList purchaseUrls;
+        QJsonArray webArr = obj["websites"].toArray();
+        for (const auto& web : webArr) {
+            QJsonObject webObj = web.toObject();
+            int cat = webObj["category"].toInt();
+            QString webUrl = webObj["url"].toString();
+            if (webUrl.isEmpty()) continue;
+
+            QString storeName;
+            switch (cat) {
+                case 13: storeName = "Steam"; break;
+                case 15: storeName = "Itch.io"; break;
+                case 16: storeName = "Epic Games"; break;
+                case 17: storeName = "GOG"; break;
+                default: continue;
+            }
+            QVariantMap link;
+            link["storeName"] = storeName;
+            link["url"] = webUrl;
+            link["category"] = cat;
+            purchaseUrls.append(link);
+        }
+        game["purchaseUrls"] = purchaseUrls;
+
+        // Build image URLs from Steam App ID if available
+        QString appId = game["steamAppID"].toString();
+        if (!appId.isEmpty() && appId != "0") {
+            game["headerImage"] = steamHeaderUrl(appId);
+            game["heroImage"]   = steamHeroUrl(appId);
+            game["capsuleImage"] = steamCapsuleUrl(appId);
+        } else if (game.contains("coverUrl")) {
+            game["headerImage"] = game["igdbHeaderUrl"];
+            game["heroImage"]   = game["igdbHeaderUrl"];
+            game["capsuleImage"] = game["coverUrl"];
+        }
+
+        results.append(game);
+    }
+
+    return results;
+}
+
+static QVariantList parseCheapSharkSearch(const QByteArray& body) {
+    QVariantList results;
+    QJsonArray arr = QJsonDocument::fromJson(body).array();
+    for (const auto& val : arr) {
+        QJsonObject obj = val.toObject();
+        QVariantMap game;
+        game["gameID"]     = obj["gameID"].toString();
+        game["title"]      = obj["external"].toString();
+        game["cheapest"]   = obj["cheapest"].toString();
+        game["steamAppID"] = obj["steamAppID"].toString();
+        game["thumb"]      = obj["thumb"].toString();
+        results.append(game);
+    }
+
+    return results;
+}
+
+// IGDB results carry the metadata, CheapShark the prices; match them by
+// Steam ID, then by normalized title.  Owned titles are tagged from the
+// identity index, and local results the network didn't return are kept
+// at the front.
+static QVariantList mergeSearchLists(const QVariantList& local, const QVariantList& igdb,
+                                     const QVariantList& cheapShark,
+                                     const QHash<QString, int>& owned) {
+    // Build lookup maps for CheapShark by normalized title and Steam ID
+    QHash<QString, int> csByTitle;  // normalized title → index
+    QHash<QString, int> csBySteam;  // steam app ID → index
+    for (int i = 0; i < cheapShark.size(); i++) {
+        QVariantMap cs = cheapShark[i].toMap();
+        QString norm = normalizeTitle(cs["title"].toString());
+        if (!norm.isEmpty())
+            csByTitle.insert(norm, i);
+        QString steamId = cs["steamAppID"].toString();
+        if (!steamId.isEmpty() && steamId != "null" && steamId != "0")
+            csBySteam.insert(steamId, i);
+    }
+
+    QVariantList results;
+
+    for (const auto& igdbVar : igdb) {
+        QVariantMap game = igdbVar.toMap();
+        QString norm = normalizeTitle(game["title"].toString());
+        QString steamId = game["steamAppID"].toString();
+
+        // Try to match CheapShark by Steam ID first, then by title
+        int csIdx = -1;
+        if (!steamId.isEmpty() && csBySteam.contains(steamId))
+            csIdx = csBySteam[steamId];
+        else if (csByTitle.contains(norm))
+            csIdx = csByTitle[norm];
+
+        QString cheapestPrice;
+        QString savings;
+
+        if (csIdx >= 0) {
+            QVariantMap cs = cheapShark[csIdx].toMap();
+            game["cheapSharkGameID"] = cs["gameID"];
+            QString csPrice = cs["cheapest"].toString();
+            if (!csPrice.isEmpty()) {
+                cheapestPrice = csPrice;
+            }
+            // Propagate Steam App ID from CheapShark if we didn't have one
+            if (steamId.isEmpty() || steamId == "0") {
+                QString csAppId = cs["steamAppID"].toString();
+                if (!csAppId.isEmpty() && csAppId != "null" && csAppId != "0") {
+                    game["steamAppID"] = csAppId;
+                    game["headerImage"] = steamHeaderUrl(csAppId);
+                    game["heroImage"]   = steamHeroUrl(csAppId);
+                    game["capsuleImage"] = steamCapsuleUrl(csAppId);
+                }
+            }
+        }
+
+        // Set price fields if we have a CheapShark price
+        if (!cheapestPrice.isEmpty()) {
+            game["cheapestPrice"] = cheapestPrice;
+            game["salePrice"]     = cheapestPrice;
+            game["hasPrice"]      = true;
+        } else {
+            // No CheapShark price — will be scraped below
+            game["hasPrice"] = false;
+        }
+        if (!savings.isEmpty())
+            game["savings"] = savings;
+
+        results.append(game);
+    }
+
+    // If no IGDB results came through but CheapShark has results, show those
+    // (graceful fallback if IGDB is down or has no credentials)
+    if (igdb.isEmpty() && !cheapShark.isEmpty()) {
+        for (const auto& csVar : cheapShark) {
+            QVariantMap cs = csVar.toMap();
+            QVariantMap game;
+            game["title"]     = cs["title"];
+            game["steamAppID"] = cs["steamAppID"];
+            game["cheapSharkGameID"] = cs["gameID"];
+            game["cheapestPrice"] = cs["cheapest"];
+            game["salePrice"]     = cs["cheapest"];
+            game["hasPrice"]      = true;
+
+            QString appId = cs["steamAppID"].toString();
+            if (!appId.isEmpty() && appId != "null" && appId != "0") {
+                game["headerImage"] = steamHeaderUrl(appId);
+                game["heroImage"]   = steamHeroUrl(appId);
+                game["capsuleImage"] = steamCapsuleUrl(appId);
+            } else {
+                game["headerImage"] = cs["thumb"];
+                game["capsuleImage"] = cs["thumb"];
+            }
+
+            results.append(game);
+        }
+    }
+
+    for (int i = 0; i < results.size(); i++) {
+        QVariantMap game = results[i].toMap();
+        tagOwned(owned, game);
+        results[i] = game;
+    }
+
+    // Local FTS hits: tag the network results that match, and keep the
+    // local-only ones at the front
+    if (!local.isEmpty()) {
+        QHash<QString, int> ownedByTitle;
+        QHash<QString, int> ownedBySteam;
+        for (int i = 0; i < local.size(); i++) {
+            QVariantMap owned = local[i].toMap();
+            ownedByTitle.insert(normalizeTitle(owned["title"].toString()), i);
+            QString steamId = owned["steamAppID"].toString();
+            if (!steamId.isEmpty())
+                ownedBySteam.insert(steamId, i);
+        }
+
+        QSet<int> matched;
+        for (int i = 0; i < results.size(); i++) {
+            QVariantMap game = results[i].toMap();
+            int idx = ownedBySteam.value(game["steamAppID"].toString(),
+                                         ownedByTitle.value(normalizeTitle(game["title"].toString()), -1));
+            if (idx < 0) continue;
+            game["owned"] = true;
+            game["libraryGameId"] = local[idx].toMap()["libraryGameId"];
+            results[i] = game;
+            matched.insert(idx);
+        }
+
+        for (int i = local.size() - 1; i >= 0; i--) {
+            if (!matched.contains(i))
+                results.prepend(local[i]);
+        }
+    }
+
+    return results;
+}
+
+// CheapShark /games?id=: the game plus every store's current deal.  Store
+// names come from a copy of the /stores table taken on the GUI thread.
+static QVariantMap parseGameDeals(const QByteArray& body, const QHash<int, QString>& storeNames,
+                                  const QHash<int, QString>& storeIcons) {
+    QJsonObject root = QJsonDocument::fromJson(body).object();
+    QVariantMap details;
+
+    // Game info
+    QJsonObject info = root["info"].toObject();
+    details["title"]      = info["title"].toString();
+    details["steamAppID"] = info["steamAppID"].toString();
+    details["thumb"]      = info["thumb"].toString();
+
+    QString appId = info["steamAppID"].toString();
+    if (!appId.isEmpty() && appId != "null" && appId != "0") {
+        details["headerImage"] = steamHeaderUrl(appId);
+        details["heroImage"]   = steamHeroUrl(appId);
+    } else {
+        details["headerImage"] = info["thumb"].toString();
+        details["heroImage"]   = info["thumb"].toString();
+    }
+
+    // Cheapest price ever
+    QJsonObject cheapest = root["cheapestPriceEver"].toObject();
+    details["cheapestEverPrice"] = cheapest["price"].toString();
+    details["cheapestEverDate"]  = cheapest["date"].toInteger();
+
+    // All current deals across stores
+    QJsonArray dealsArr = root["deals"].toArray();
+    QVariantList deals;
+    for (const auto& val : dealsArr) {
+        QJsonObject obj = val.toObject();
+        QVariantMap deal;
+        deal["storeID"]     = obj["storeID"].toString();
+        deal["dealID"]      = obj["dealID"].toString();
+        deal["price"]       = obj["price"].toString();
+        deal["retailPrice"] = obj["retailPrice"].toString();
+        deal["savings"]     = obj["savings"].toString();
+
+        int storeId = obj["storeID"].toString().toInt();
+        deal["storeName"] = storeNames.value(storeId, "Store #" + QString::number(storeId));
+        deal["storeIcon"] = storeIcons.value(storeId);
+        deal["dealLink"]  = QStringLiteral("https://www.cheapshark.com/redirect?dealID=")
+                            + obj["dealID"].toString();
+        deal["source"]    = QStringLiteral("CheapShark");
+
+        deals.append(deal);
+    }
+    details["deals"] = deals;
+    return details;
+}
+
+// CheapShark /stores
+static QVariantList parseStoreList(const QByteArray& body) {
+    QJsonArray arr = QJsonDocument::fromJson(body).array();
+    QVariantList stores;
+    for (const auto& val : arr) {
+        QJsonObject obj = val.toObject();
+        QJsonObject images = obj["images"].toObject();
+
+        QVariantMap store;
+        store["storeID"]   = obj["storeID"].toString().toInt();
+        store["storeName"] = obj["storeName"].toString();
+        store["icon"]      = "https://www.cheapshark.com" + images["icon"].toString();
+        store["isActive"]  = obj["isActive"].toInt();
+        stores.append(store);
+    }
+    return stores;
+}
+
+// IGDB /games for the info popup; empty if IGDB found nothing
+static QVariantMap parseIgdbGameInfo(const QByteArray& body) {
+    QJsonArray arr = QJsonDocument::fromJson(body).array();
+    if (arr.isEmpty())
+        return QVariantMap();
+
+    QJsonObject obj = arr.first().toObject();
+    QVariantMap info;
+    info["name"]        = obj["name"].toString();
+    info["summary"]     = obj["summary"].toString();
+    info["storyline"]   = obj["storyline"].toString();
+    info["rating"]      = obj["rating"].toDouble();
+    info["totalRating"] = obj["total_rating"].toDouble();
+    info["aggregatedRating"] = obj["aggregated_rating"].toDouble();
+
+    // Release date
+    if (obj.contains("first_release_date")) {
+        qint64 ts = obj["first_release_date"].toInteger();
+        info["releaseDate"] = QDateTime::fromSecsSinceEpoch(ts).toString("MMM d, yyyy");
+    }
+
+    // Cover URL (IGDB returns //images.igdb.com/... — prepend https:)
+    if (obj.contains("cover")) {
+        QString coverUrl = obj["cover"].toObject()["url"].toString();
+        if (coverUrl.startsWith("//"))
+            coverUrl = "https:" + coverUrl;
+        // Get higher resolution: replace t_thumb with t_cover_big
+        coverUrl.replace("t_thumb", "t_cover_big");
+        info["coverUrl"] = coverUrl;
+    }
+
+    // Screenshots
+    QVariantList screenshots;
+    QJsonArray ssArr = obj["screenshots"].toArray();
+    for (const auto& ss : ssArr) {
+        QString ssUrl = ss.toObject()["url"].toString();
+        if (ssUrl.startsWith("//"))
+            ssUrl = "https:" + ssUrl;
+        ssUrl.replace("t_thumb", "t_screenshot_big");
+        screenshots.append(ssUrl);
+    }
+    info["screenshots"] = screenshots;
+
+    // Genres
+    QStringList genres;
+    QJsonArray genreArr = obj["genres"].toArray();
+    for (const auto& g : genreArr)
+        genres.append(g.toObject()["name"].toString());
+    info["genres"] = genres.join(", ");
+
+    // Platforms
+    QStringList platforms;
+    QJsonArray platArr = obj["platforms"].toArray();
+    for (const auto& p : platArr)
+        platforms.append(p.toObject()["name"].toString());
+    info["platforms"] = platforms.join(", ");
+
+    return info;
+}
+
+// IGDB /multiquery for one enrichment batch: per batch index, the
+// games.metadata and games.tags JSON to store and whether IGDB matched.
+// Misses are stored too (igdbChecked only) so they aren't searched again
+// on every run.
+static QVariantList parseIgdbEnrichment(const QByteArray& body, int batchSize) {
+    QHash<int, QJsonObject> found;
+    const QJsonArray sections = QJsonDocument::fromJson(body).array();
+    for (const auto& val : sections) {
+        QJsonObject section = val.toObject();
+        QJsonArray rows = section["result"].toArray();
+        if (!rows.isEmpty())
+            found.insert(section["name"].toString().toInt(), rows.first().toObject());
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QVariantList rows;
+    for (int i = 0; i < batchSize; ++i) {
+        QJsonObject metadata;
+        metadata["igdbChecked"] = now;
+        QJsonArray tags;
+
+        auto it = found.constFind(i);
+        if (it != found.constEnd()) {
+            const QJsonObject& obj = it.value();
+            metadata["igdbId"] = obj["id"].toInt();
+            metadata["igdbName"] = obj["name"].toString();
+            metadata["summary"] = obj["summary"].toString();
+            for (const auto& g : obj["genres"].toArray())
+                tags.append(g.toObject()["name"].toString());
+            metadata["genres"] = tags;
+            if (obj.contains("first_release_date")) {
+                qint64 ts = obj["first_release_date"].toInteger();
+                metadata["releaseDate"] = QDateTime::fromSecsSinceEpoch(ts).toString("yyyy-MM-dd");
+            }
+            double rating = obj.contains("total_rating") ? obj["total_rating"].toDouble()
+                                                         : obj["aggregated_rating"].toDouble();
+            if (rating > 0)
+                metadata["rating"] = qRound(rating);
+        }
+
+        QVariantMap row;
+        row["matched"] = it != found.constEnd();
+        row["metadata"] = QString::fromUtf8(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
+        row["tags"] = QString::fromUtf8(QJsonDocument(tags).toJson(QJsonDocument::Compact));
+        rows.append(row);
+    }
+    return rows;
+}
+
+// ── Store price scraping ──
+// One parser per store: its answer becomes a deal for the price list
+// (storeName, price, retailPrice, savings, dealLink, source), or an
+// empty map when the store has no price for the game.
+
+// Stores append edition names; a prefix match either way is close enough
+static bool storeTitleMatches(const QString& found, const QString& wanted) {
+    const QString normFound = normalizeTitle(found);
+    const QString normWanted = normalizeTitle(wanted);
+    return normFound == normWanted
+        || normFound.startsWith(normWanted)
+        || normWanted.startsWith(normFound);
+}
+
+static QVariantMap parseSteamPrice(const QByteArray& body, const QString& appId) {
+    QJsonObject appData = QJsonDocument::fromJson(body).object()[appId].toObject();
+    if (!appData["success"].toBool())
+        return QVariantMap();
+
+    QJsonObject data = appData["data"].toObject();
+    QJsonObject po = data["price_overview"].toObject();
+    QVariantMap deal;
+    if (!po.isEmpty()) {
+        deal["price"] = QString::number(po["final"].toInt() / 100.0, 'f', 2);
+        deal["retailPrice"] = QString::number(po["initial"].toInt() / 100.0, 'f', 2);
+        deal["savings"] = QString::number(po["discount_percent"].toInt());
+    } else if (data["is_free"].toBool()) {
+        deal["price"] = QStringLiteral("0.00");
+        deal["retailPrice"] = QStringLiteral("0.00");
+        deal["savings"] = QStringLiteral("0");
+    } else {
+        return QVariantMap();
+    }
+    deal["storeName"] = QStringLiteral("Steam");
+    deal["storeIcon"] = QStringLiteral("https://www.cheapshark.com/img/stores/icons/0.png");
+    deal["dealLink"] = QStringLiteral("https://store.steampowered.com/app/") + appId;
+    deal["source"] = QStringLiteral("Steam");
+    return deal;
+}
+
+static QVariantMap parseGogPrice(const QByteArray& body, const QString& storeUrl) {
+    QJsonArray products = QJsonDocument::fromJson(body).object()["products"].toArray();
+    if (products.isEmpty())
+        return QVariantMap();
+
+    QJsonObject price = products.first().toObject()["price"].toObject();
+    QString finalStr = price["finalMoney"].toObject()["amount"].toString();
+    if (finalStr.isEmpty())
+        return QVariantMap();
+
+    QVariantMap deal;
+    deal["storeName"] = QStringLiteral("GOG");
+    deal["price"] = finalStr;
+    deal["retailPrice"] = price["baseMoney"].toObject()["amount"].toString();
+    deal["savings"] = QString::number(price["discount"].toInt());
+    deal["dealLink"] = storeUrl;
+    deal["source"] = QStringLiteral("GOG");
+    return deal;
+}
+
+static QVariantMap parseEpicPrice(const QByteArray& body, const QString& gameTitle) {
+    QJsonArray elements = QJsonDocument::fromJson(body).object()
+        ["data"].toObject()["Catalog"].toObject()
+        ["searchStore"].toObject()["elements"].toArray();
+    if (elements.isEmpty())
+        return QVariantMap();
+
+    QJsonObject element = elements.first().toObject();
+    if (!storeTitleMatches(element["title"].toString(), gameTitle)) {
+        qDebug() << "Epic scrape: title mismatch for" << gameTitle
+                 << "- Epic returned:" << element["title"].toString();
+        return QVariantMap();
+    }
+
+    QJsonObject tp = element["price"].toObject()["totalPrice"].toObject();
+    int decimals = tp["currencyInfo"].toObject()["decimals"].toInt(2);
+    double divisor = std::pow(10.0, decimals);
+    double finalPrice = tp["discountPrice"].toInt() / divisor;
+    double origPrice = tp["originalPrice"].toInt() / divisor;
+    int discountAmt = tp["discount"].toInt();
+    int discountPct = (origPrice > 0) ? qRound(discountAmt / divisor / origPrice * 100.0) : 0;
+    if (finalPrice < 0)
+        return QVariantMap();
+
+    QVariantMap deal;
+    deal["storeName"] = QStringLiteral("Epic Games");
+    deal["price"] = QString::number(finalPrice, 'f', 2);
+    deal["retailPrice"] = QString::number(origPrice, 'f', 2);
+    deal["savings"] = QString::number(discountPct);
+    deal["dealLink"] = QStringLiteral("https://store.epicgames.com/en-US/browse?q=")
+        + QUrl::toPercentEncoding(gameTitle);
+    deal["source"] = QStringLiteral("Epic Games");
+    return deal;
+}
+
+static QVariantMap parseGmgPrice(const QByteArray& body, const QString& gameTitle) {
+    QJsonDocument doc = QJsonDocument::fromJson(body);
+    // GMG autocomplete returns an array of products, or { products: [...] }
+    QJsonArray arr = doc.isArray() ? doc.array() : QJsonArray();
+    if (arr.isEmpty() && doc.isObject())
+        arr = doc.object()["products"].toArray();
+
+    for (const auto& val : arr) {
+        QJsonObject product = val.toObject();
+        QString title = product["name"].toString();
+        if (title.isEmpty())
+            title = product["title"].toString();
+        if (!storeTitleMatches(title, gameTitle))
+            continue;
+
+        // Try multiple price field patterns GMG has used
+        double price = -1, basePrice = -1;
+        if (product.contains("currentPrice")) {
+            price = product["currentPrice"].toDouble(-1);
+            basePrice = product["basePrice"].toDouble(price);
+        } else if (product.contains("price")) {
+            QJsonObject po = product["price"].toObject();
+            price = po["current"].toDouble(-1);
+            if (price < 0) price = po["amount"].toDouble(-1);
+            basePrice = po["base"].toDouble(price);
+        }
+        if (price < 0)
+            return QVariantMap();
+
+        int discountPct = (basePrice > 0 && basePrice > price)
+            ? qRound((1.0 - price / basePrice) * 100.0) : 0;
+        QVariantMap deal;
+        deal["storeName"] = QStringLiteral("Green Man Gaming");
+        deal["price"] = QString::number(price, 'f', 2);
+        deal["retailPrice"] = QString::number(basePrice, 'f', 2);
+        deal["savings"] = QString::number(discountPct);
+        deal["dealLink"] = product["url"].toString();
+        deal["source"] = QStringLiteral("GMG");
+        return deal;
+    }
+    return QVariantMap();
 }
 
 StoreApiManager::StoreApiManager(QObject *parent)
     : QObject(parent)
     , m_nam(new QNetworkAccessManager(this))
+    , m_responseCache(std::make_unique<ResponseCache>())
+    , m_scheduler(new OutboundScheduler(m_nam, this))
 {
+    // Per-host limits, kept under each API's published or observed quota:
+    // {requests/s, burst, max concurrent, transfer timeout ms}
+    m_scheduler->setHostPolicy("www.cheapshark.com",     {1.0, 3, 2, 15000});
+    m_scheduler->setHostPolicy("api.igdb.com",           {4.0, 4, 4, 20000});
+    m_scheduler->setHostPolicy("id.twitch.tv",           {1.0, 2, 1, 10000});
+    m_scheduler->setHostPolicy("store.steampowered.com", {0.6, 5, 2, 15000});
+    m_scheduler->setHostPolicy("catalog.gog.com",        {2.0, 4, 2, 15000});
+    m_scheduler->setHostPolicy("graphql.epicgames.com",  {2.0, 4, 2, 15000});
+    m_scheduler->setHostPolicy("www.greenmangaming.com", {1.0, 2, 1, 15000});
+    m_scheduler->setHostPolicy("www.protondb.com",       {2.0, 4, 2, 10000});
+
     // Use build-time IGDB credentials as defaults (injected from GitHub Secrets)
 #ifdef IGDB_CLIENT_ID
     m_igdbClientId = QStringLiteral(IGDB_CLIENT_ID);
@@ -49,18 +752,180 @@ StoreApiManager::StoreApiManager(QObject *parent)
     // User-saved credentials (encrypted) override built-in defaults
     loadIGDBCredentials();
 
+    m_protonTimer = new QTimer(this);
+    m_protonTimer->setInterval(PROTON_PREFETCH_INTERVAL_MS);
+    connect(m_protonTimer, &QTimer::timeout, this, &StoreApiManager::prefetchNextProtonRating);
+
+    m_priceTimer = new QTimer(this);
+    m_priceTimer->setSingleShot(true);
+    m_priceTimer->setInterval(PRICE_REFRESH_INTERVAL_MS);
+    connect(m_priceTimer, &QTimer::timeout, this, &StoreApiManager::refreshNextPriceSnapshot);
+
+    m_searchDebounce = new QTimer(this);
+    m_searchDebounce->setSingleShot(true);
+    m_searchDebounce->setInterval(SEARCH_DEBOUNCE_MS);
+    connect(m_searchDebounce, &QTimer::timeout, this, [this]() {
+        // Typing already cancelled older searches and emitted the local
+        // matches; only the network half is left
+        runNetworkSearch(m_pendingSearch, std::exchange(m_pendingLocal, QVariantList()));
+    });
+
+    // One thread keeps decodes, and so deliveries, in request order:
+    // deal pages must not overtake each other
+    m_decodePool.setMaxThreadCount(1);
+
     // Pre-fetch store list on construction
     fetchStores();
 }
 
-// ─── CheapShark: Fetch Deals ───
+StoreApiManager::~StoreApiManager()
+{
+    // Queued deliveries to a destroyed object are dropped; just make sure
+    // no decode is still running
+    m_decodePool.clear();
+    m_decodePool.waitForDone();
+}
 
-void StoreApiManager::fetchDeals(const QString& sortBy, int pageNumber, int pageSize)
+void StoreApiManager::setDatabase(Database *db)
 {
-    // Ensure store metadata is loaded (retries if initial fetch failed)
-    if (!m_storesLoaded)
-        fetchStores();
+    m_db = db;
+    refreshOwnedIndex();
+}
+
+void StoreApiManager::refreshOwnedIndex()
+{
+    if (m_db)
+        m_ownedIndex = m_db->getTitleIdentityIndex();
+}
+
+// ─── Response cache ───
+
+QString StoreApiManager::cacheKey(const QByteArray& verb, const QUrl& url, const QByteArray& body)
+{
+    QString key = QString::fromLatin1(verb) + " " + url.toString(QUrl::FullyEncoded);
+    if (!body.isEmpty())
+        key += "\n" + QString::fromUtf8(body);
+    return key;
+}
+
+bool StoreApiManager::lookupFresh(const QByteArray& verb, const QUrl& url, const QByteArray& body,
+                                  const CachePolicy& policy, QByteArray *out)
+{
+    ResponseCache::Entry entry;
+    if (!m_responseCache->lookup(cacheKey(verb, url, body), &entry))
+        return false;
+    if (QDateTime::currentSecsSinceEpoch() - entry.storedAt >= policy.freshSecs)
+        return false;
+    *out = entry.body;
+    return true;
+}
+
+void StoreApiManager::fetchCached(const QNetworkRequest& req, const QByteArray& verb,
+                                  const QByteArray& body, const CachePolicy& policy,
+                                  BodyHandler onBody, ErrorHandler onError)
+{
+    const QString key = cacheKey(verb, req.url(), body);
+    ResponseCache::Entry cached;
+    const bool hasCached = m_responseCache->lookup(key, &cached);
+    const qint64 age = hasCached ? QDateTime::currentSecsSinceEpoch() - cached.storedAt : 0;
+
+    if (hasCached && age < policy.freshSecs) {
+        onBody(cached.body);
+        return;
+    }
+
+    // Stale-while-revalidate: answer with the stale copy now and only
+    // refresh the cache; the next caller gets the new data.
+    const bool servedStale = hasCached && age < policy.freshSecs + policy.staleSecs;
+    if (servedStale)
+        onBody(cached.body);
+
+    sendRequest(req, verb, body,
+                [this, key, cached, hasCached, servedStale, onBody, onError](const NetResult& result) {
+        if (!result.ok) {
+            if (servedStale) return;
+            // Offline mode: the last good data beats an error, however old
+            if (hasCached) {
+                setOffline(true);
+                onBody(cached.body);
+                return;
+            }
+            onError(result.error);
+            return;
+        }
+
+        // Coalesced waiters all land here with the same body; storing it
+        // again is a cheap overwrite of an identical entry.
+        setOffline(false);
+        m_responseCache->store(key, result.body);
+        if (!servedStale)
+            onBody(result.body);
+    });
+}
+
+// ─── Request coalescing ───
+
+void StoreApiManager::sendRequest(const QNetworkRequest& req, const QByteArray& verb,
+                                  const QByteArray& body, ResultHandler onDone, int group)
+{
+    // Headers are not part of the key; the only header that varies
+    // between otherwise identical requests is the IGDB bearer token,
+    // and a reply fetched with the previous token is just as valid.
+    const QString key = cacheKey(verb, req.url(), body);
+    auto it = m_inFlight.find(key);
+    if (it != m_inFlight.end()) {
+        it->waiters.append({std::move(onDone), group});
+        return;
+    }
+    m_inFlight[key].waiters.append({std::move(onDone), group});
+
+    const quint64 ticket = m_scheduler->submit(req, verb, body, [this, key](const NetResult& result) {
+        // Detach the waiters first so a handler that re-issues the same
+        // request starts a fresh reply instead of joining this one.
+        const QList<Waiter> waiters = m_inFlight.take(key).waiters;
+        for (const Waiter& waiter : waiters)
+            waiter.handler(result);
+    });
+    m_inFlight[key].ticket = ticket;
+}
+
+void StoreApiManager::cancelRequests(int group)
+{
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ) {
+        it->waiters.removeIf([group](const Waiter& w) { return w.group == group; });
+        if (it->waiters.isEmpty()) {
+            m_scheduler->cancel(it->ticket);
+            it = m_inFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void StoreApiManager::runDecoder(Decoder decode, ListHandler deliver)
+{
+    m_decodePool.start([this, decode, deliver]() {
+        QVariantList list = decode();
+        QMetaObject::invokeMethod(this, [deliver, list]() {
+            deliver(list);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void StoreApiManager::setOffline(bool offline)
+{
+    if (m_offline == offline) return;
+    m_offline = offline;
+    emit offlineChanged();
+}
+
+bool StoreApiManager::hasOfflineDeals(const QString& sortBy, int pageSize)
+{
+    return m_responseCache->contains(cacheKey("GET", dealsUrl(sortBy, 0, pageSize), QByteArray()));
+}
 
+QUrl StoreApiManager::dealsUrl(const QString& sortBy, int pageNumber, int pageSize)
+{
     QUrl url(CHEAPSHARK_BASE + "/deals");
     QUrlQuery query;
     query.addQueryItem("sortBy", sortBy);
@@ -68,63 +933,28 @@ void StoreApiManager::fetchDeals(const QString& sortBy, int pageNumber, int page
     query.addQueryItem("pageSize", QString::number(pageSize));
     query.addQueryItem("onSale", "1");
     url.setQuery(query);
+    return url;
+}
 
-    QNetworkRequest req(url);
-    req.setTransferTimeout(15000);
-    QNetworkReply *reply = m_nam->get(req);
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            emit dealsError(reply->errorString());
-            return;
-        }
+// ─── CheapShark: Fetch Deals ───
 
-        QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-        QVariantList deals;
-        QSet<QString> seenGameIDs;
-        for (const auto& val : arr) {
-            QJsonObject obj = val.toObject();
-            QString gameId = obj["gameID"].toString();
-
-            // Deduplicate: keep only the first (best) deal per game
-            if (seenGameIDs.contains(gameId))
-                continue;
-            seenGameIDs.insert(gameId);
-
-            QVariantMap deal;
-            deal["dealID"]       = obj["dealID"].toString();
-            deal["title"]        = obj["title"].toString();
-            deal["salePrice"]    = obj["salePrice"].toString();
-            deal["normalPrice"]  = obj["normalPrice"].toString();
-            deal["savings"]      = obj["savings"].toString();
-            deal["metacriticScore"]    = obj["metacriticScore"].toString();
-            deal["steamRatingText"]    = obj["steamRatingText"].toString();
-            deal["steamRatingPercent"] = obj["steamRatingPercent"].toString();
-            deal["steamAppID"]   = obj["steamAppID"].toString();
-            deal["gameID"]       = gameId;
-            deal["storeID"]      = obj["storeID"].toString();
-            deal["dealRating"]   = obj["dealRating"].toString();
-            deal["releaseDate"]  = obj["releaseDate"].toInteger();
-            deal["thumb"]        = obj["thumb"].toString();
-            deal["isOnSale"]     = obj["isOnSale"].toString();
-
-            // Construct higher-quality image URLs from steamAppID
-            QString appId = obj["steamAppID"].toString();
-            if (!appId.isEmpty() && appId != "null" && appId != "0") {
-                deal["headerImage"] = getSteamHeaderUrl(appId);
-                deal["heroImage"]   = getSteamHeroUrl(appId);
-                deal["capsuleImage"] = getSteamCapsuleUrl(appId);
-            } else {
-                deal["headerImage"] = obj["thumb"].toString();
-                deal["heroImage"]   = obj["thumb"].toString();
-                deal["capsuleImage"] = obj["thumb"].toString();
-            }
+void StoreApiManager::fetchDeals(const QString& sortBy, int pageNumber, int pageSize)
+{
+    // Ensure store metadata is loaded (retries if initial fetch failed)
+    if (!m_storesLoaded)
+        fetchStores();
 
-            deals.append(deal);
-        }
+    QNetworkRequest req(dealsUrl(sortBy, pageNumber, pageSize));
 
-        emit dealsReady(deals);
+    fetchCached(req, "GET", QByteArray(), DEALS_CACHE, [this, sortBy, pageNumber](const QByteArray& body) {
+        runDecoder([body, owned = m_ownedIndex]() { return parseDealList(body, owned); },
+                   [this, sortBy, pageNumber](const QVariantList& deals) {
+            emit dealsReady(deals);
+            emit dealsPageReady(sortBy, pageNumber, deals);
+        });
+    }, [this, sortBy, pageNumber](const QString& error) {
+        emit dealsError(error);
+        emit dealsPageError(sortBy, pageNumber, error);
     });
 }
 
@@ -138,73 +968,92 @@ void StoreApiManager::fetchRecentDeals(int pageSize)
     url.setQuery(query);
 
     QNetworkRequest req(url);
-    req.setTransferTimeout(15000);
-    QNetworkReply *reply = m_nam->get(req);
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            emit recentDealsError(reply->errorString());
-            return;
-        }
+    fetchCached(req, "GET", QByteArray(), RECENT_CACHE, [this](const QByteArray& body) {
+        runDecoder([body, owned = m_ownedIndex]() { return parseDealList(body, owned); },
+                   [this](const QVariantList& deals) { emit recentDealsReady(deals); });
+    }, [this](const QString& error) {
+        emit recentDealsError(error);
+    });
+}
 
-        QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-        QVariantList deals;
-        QSet<QString> seenGameIDs;
-        for (const auto& val : arr) {
-            QJsonObject obj = val.toObject();
-            QString gameId = obj["gameID"].toString();
-
-            // Deduplicate: keep only the first deal per game
-            if (seenGameIDs.contains(gameId))
-                continue;
-            seenGameIDs.insert(gameId);
-
-            QVariantMap deal;
-            deal["dealID"]       = obj["dealID"].toString();
-            deal["title"]        = obj["title"].toString();
-            deal["salePrice"]    = obj["salePrice"].toString();
-            deal["normalPrice"]  = obj["normalPrice"].toString();
-            deal["savings"]      = obj["savings"].toString();
-            deal["metacriticScore"]    = obj["metacriticScore"].toString();
-            deal["steamRatingText"]    = obj["steamRatingText"].toString();
-            deal["steamRatingPercent"] = obj["steamRatingPercent"].toString();
-            deal["steamAppID"]   = obj["steamAppID"].toString();
-            deal["gameID"]       = gameId;
-            deal["storeID"]      = obj["storeID"].toString();
-            deal["dealRating"]   = obj["dealRating"].toString();
-            deal["releaseDate"]  = obj["releaseDate"].toInteger();
-            deal["thumb"]        = obj["thumb"].toString();
-
-            QString appId = obj["steamAppID"].toString();
-            if (!appId.isEmpty() && appId != "null" && appId != "0") {
-                deal["headerImage"] = getSteamHeaderUrl(appId);
-                deal["heroImage"]   = getSteamHeroUrl(appId);
-                deal["capsuleImage"] = getSteamCapsuleUrl(appId);
-            } else {
-                deal["headerImage"] = obj["thumb"].toString();
-                deal["heroImage"]   = obj["thumb"].toString();
-                deal["capsuleImage"] = obj["thumb"].toString();
-            }
+// ─── Search: IGDB + CheapShark (parallel) ───
 
-            deals.append(deal);
-        }
+void StoreApiManager::searchGamesAsYouType(const QString& title)
+{
+    cancelSearch();
+    if (title.trimmed().isEmpty()) {
+        emit searchResultsReady(QVariantList());
+        return;
+    }
 
-        emit recentDealsReady(deals);
-    });
+    QVariantList local = localSearchResults(title);
+    if (!local.isEmpty())
+        emit searchResultsReady(local);
+
+    m_pendingSearch = title;
+    m_pendingLocal = local;
+    m_searchDebounce->start();
 }
 
-// ─── Search: IGDB + CheapShark (parallel) ───
+void StoreApiManager::cancelSearch()
+{
+    m_searchDebounce->stop();
+    // Bumping the generation also drops replies that already arrived but
+    // whose follow-up (merge, price scrape) hasn't run yet
+    ++m_searchGeneration;
+    cancelRequests(SearchGroup);
+}
+
+QVariantList StoreApiManager::localSearchResults(const QString& title)
+{
+    QVariantList results;
+    if (!m_db) return results;
+
+    for (const Game& g : m_db->searchGameTitles(title.trimmed(), LOCAL_SEARCH_LIMIT)) {
+        QVariantMap game;
+        game["title"] = g.title;
+        game["owned"] = true;
+        game["libraryGameId"] = g.id;
+        game["storeSource"] = g.storeSource;
+        game["hasPrice"] = true;   // already owned; nothing to price
+        if (g.storeSource == "steam" && !g.appId.isEmpty()) {
+            game["steamAppID"]   = g.appId;
+            game["headerImage"]  = getSteamHeaderUrl(g.appId);
+            game["heroImage"]    = getSteamHeroUrl(g.appId);
+            game["capsuleImage"] = getSteamCapsuleUrl(g.appId);
+        } else {
+            QString header = g.backgroundArtUrl.isEmpty() ? g.coverArtUrl : g.backgroundArtUrl;
+            game["headerImage"]  = header;
+            game["heroImage"]    = header;
+            game["capsuleImage"] = g.coverArtUrl;
+            game["coverUrl"]     = g.coverArtUrl;
+        }
+        results.append(game);
+    }
+    return results;
+}
 
 void StoreApiManager::searchGames(const QString& title)
 {
+    cancelSearch();
     if (title.trimmed().isEmpty()) {
         emit searchResultsReady(QVariantList());
         return;
     }
 
-    int generation = ++m_searchGeneration;
+    // Owned titles from the local FTS index go out before any network reply
+    QVariantList local = localSearchResults(title);
+    if (!local.isEmpty())
+        emit searchResultsReady(local);
+    runNetworkSearch(title, local);
+}
+
+void StoreApiManager::runNetworkSearch(const QString& title, const QVariantList& local)
+{
+    int generation = m_searchGeneration;
     auto state = std::make_shared<SearchMergeState>();
+    state->localResults = local;
 
     // Lambda to check if both searches are done, then merge
     auto checkMerge = [this, state, generation]() {
@@ -226,7 +1075,6 @@ void StoreApiManager::searchGames(const QString& title)
             req.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
             req.setRawHeader("Client-ID", m_igdbClientId.toUtf8());
             req.setRawHeader("Authorization", ("Bearer " + m_igdbAccessToken).toUtf8());
-            req.setTransferTimeout(15000);
 
             // Search IGDB filtered to Windows (6) and Linux (3) platforms
             // Include websites for purchase links (13=Steam, 15=Itch, 16=Epic, 17=GOG)
@@ -241,268 +1089,76 @@ void StoreApiManager::searchGames(const QString& title)
                 "limit 30;"
             ).arg(title);
 
-            QNetworkReply *reply = m_nam->post(req, body.toUtf8());
-
-            connect(reply, &QNetworkReply::finished, this, [this, reply, state, generation, checkMerge]() {
-                reply->deleteLater();
+            sendRequest(req, "POST", body.toUtf8(),
+                        [this, state, generation, checkMerge](const NetResult& result) {
                 if (generation != m_searchGeneration) return;
 
-                if (reply->error() != QNetworkReply::NoError) {
-                    qWarning() << "IGDB search failed:" << reply->errorString();
-                    state->completedCount++;
-                    checkMerge();
-                    return;
-                }
-
-                QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-                for (const auto& val : arr) {
-                    QJsonObject obj = val.toObject();
-                    QVariantMap game;
-                    game["igdbId"] = obj["id"].toInt();
-                    game["title"]  = obj["name"].toString();
-                    game["summary"] = obj["summary"].toString();
-                    game["rating"]  = obj["total_rating"].toDouble();
-                    game["aggregatedRating"] = obj["aggregated_rating"].toDouble();
-
-                    // Release date
-                    if (obj.contains("first_release_date")) {
-                        qint64 ts = obj["first_release_date"].toInteger();
-                        game["releaseDate"] = QDateTime::fromSecsSinceEpoch(ts).toString("MMM d, yyyy");
-                    }
-
-                    // Cover URL
-                    if (obj.contains("cover")) {
-                        QString coverUrl = obj["cover"].toObject()["url"].toString();
-                        if (coverUrl.startsWith("//"))
-                            coverUrl = "https:" + coverUrl;
-                        coverUrl.replace("t_thumb", "t_cover_big");
-                        game["coverUrl"] = coverUrl;
-                        // Also use as header image fallback
-                        QString headerUrl = coverUrl;
-                        headerUrl.replace("t_cover_big", "t_screenshot_big");
-                        game["igdbHeaderUrl"] = headerUrl;
-                    }
-
-                    // Screenshots
-                    QVariantList screenshots;
-                    QJsonArray ssArr = obj["screenshots"].toArray();
-                    for (const auto& ss : ssArr) {
-                        QString ssUrl = ss.toObject()["url"].toString();
-                        if (ssUrl.startsWith("//"))
-                            ssUrl = "https:" + ssUrl;
-                        ssUrl.replace("t_thumb", "t_screenshot_big");
-                        screenshots.append(ssUrl);
-                    }
-                    game["screenshots"] = screenshots;
-
-                    // Genres
-                    QStringList genres;
-                    QJsonArray genreArr = obj["genres"].toArray();
-                    for (const auto& g : genreArr)
-                        genres.append(g.toObject()["name"].toString());
-                    game["genres"] = genres.join(", ");
-
-                    // Platforms
-                    QStringList platforms;
-                    QJsonArray platArr = obj["platforms"].toArray();
-                    for (const auto& p : platArr)
-                        platforms.append(p.toObject()["name"].toString());
-                    game["platforms"] = platforms.join(", ");
-
-                    // Extract Steam App ID from external_games (category 1 = Steam)
-                    QJsonArray extArr = obj["external_games"].toArray();
-                    for (const auto& ext : extArr) {
-                        QJsonObject extObj = ext.toObject();
-                        if (extObj["category"].toInt() == 1) {
-                            game["steamAppID"] = extObj["uid"].toString();
-                            break;
-                        }
-                    }
-
-                    // Extract purchase URLs from websites
-                    // Categories: 13=Steam, 15=Itch.io, 16=Epic Games, 17=GOG
-                    QVariantList purchaseUrls;
-                    QJsonArray webArr = obj["websites"].toArray();
-                    for (const auto& web : webArr) {
-                        QJsonObject webObj = web.toObject();
-                        int cat = webObj["category"].toInt();
-                        QString webUrl = webObj["url"].toString();
-                        if (webUrl.isEmpty()) continue;
-
-                        QString storeName;
-                        switch (cat) {
-                            case 13: storeName = "Steam"; break;
-                            case 15: storeName = "Itch.io"; break;
-                            case 16: storeName = "Epic Games"; break;
-                            case 17: storeName = "GOG"; break;
-                            default: continue;
-                        }
-                        QVariantMap link;
-                        link["storeName"] = storeName;
-                        link["url"] = webUrl;
-                        link["category"] = cat;
-                        purchaseUrls.append(link);
-                    }
-                    game["purchaseUrls"] = purchaseUrls;
-
-                    // Build image URLs from Steam App ID if available
-                    QString appId = game["steamAppID"].toString();
-                    if (!appId.isEmpty() && appId != "0") {
-                        game["headerImage"] = getSteamHeaderUrl(appId);
-                        game["heroImage"]   = getSteamHeroUrl(appId);
-                        game["capsuleImage"] = getSteamCapsuleUrl(appId);
-                    } else if (game.contains("coverUrl")) {
-                        game["headerImage"] = game["igdbHeaderUrl"];
-                        game["heroImage"]   = game["igdbHeaderUrl"];
-                        game["capsuleImage"] = game["coverUrl"];
-                    }
-
-                    state->igdbResults.append(game);
-                }
-
-                state->completedCount++;
-                checkMerge();
-            });
-        });
-    }
-
-    // ── 2. CheapShark search (for price data + CheapShark game IDs) ──
-    {
-        QUrl url(CHEAPSHARK_BASE + "/games");
-        QUrlQuery query;
-        query.addQueryItem("title", title);
-        query.addQueryItem("limit", "60");
-        url.setQuery(query);
-
-        QNetworkRequest req(url);
-        req.setTransferTimeout(15000);
-        QNetworkReply *reply = m_nam->get(req);
-
-        connect(reply, &QNetworkReply::finished, this, [this, reply, state, generation, checkMerge]() {
-            reply->deleteLater();
-            if (generation != m_searchGeneration) return;
-
-            if (reply->error() != QNetworkReply::NoError) {
-                qWarning() << "CheapShark search failed:" << reply->errorString();
-                state->completedCount++;
-                checkMerge();
-                return;
-            }
-
-            QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-            for (const auto& val : arr) {
-                QJsonObject obj = val.toObject();
-                QVariantMap game;
-                game["gameID"]     = obj["gameID"].toString();
-                game["title"]      = obj["external"].toString();
-                game["cheapest"]   = obj["cheapest"].toString();
-                game["steamAppID"] = obj["steamAppID"].toString();
-                game["thumb"]      = obj["thumb"].toString();
-                state->cheapSharkResults.append(game);
-            }
-
-            state->completedCount++;
-            checkMerge();
-        });
-    }
-}
-
-void StoreApiManager::mergeSearchResults(std::shared_ptr<SearchMergeState> state, int generation)
-{
-    if (generation != m_searchGeneration)
-        return;
-
-    // Build lookup maps for CheapShark by normalized title and Steam ID
-    QHash<QString, int> csByTitle;  // normalized title → index
-    QHash<QString, int> csBySteam;  // steam app ID → index
-    for (int i = 0; i < state->cheapSharkResults.size(); i++) {
-        QVariantMap cs = state->cheapSharkResults[i].toMap();
-        QString norm = normalizeTitle(cs["title"].toString());
-        if (!norm.isEmpty())
-            csByTitle.insert(norm, i);
-        QString steamId = cs["steamAppID"].toString();
-        if (!steamId.isEmpty() && steamId != "null" && steamId != "0")
-            csBySteam.insert(steamId, i);
-    }
-
-    auto results = std::make_shared<QVariantList>();
-
-    for (const auto& igdbVar : state->igdbResults) {
-        QVariantMap game = igdbVar.toMap();
-        QString norm = normalizeTitle(game["title"].toString());
-        QString steamId = game["steamAppID"].toString();
-
-        // Try to match CheapShark by Steam ID first, then by title
-        int csIdx = -1;
-        if (!steamId.isEmpty() && csBySteam.contains(steamId))
-            csIdx = csBySteam[steamId];
-        else if (csByTitle.contains(norm))
-            csIdx = csByTitle[norm];
-
-        QString cheapestPrice;
-        QString savings;
-
-        if (csIdx >= 0) {
-            QVariantMap cs = state->cheapSharkResults[csIdx].toMap();
-            game["cheapSharkGameID"] = cs["gameID"];
-            QString csPrice = cs["cheapest"].toString();
-            if (!csPrice.isEmpty()) {
-                cheapestPrice = csPrice;
-            }
-            // Propagate Steam App ID from CheapShark if we didn't have one
-            if (steamId.isEmpty() || steamId == "0") {
-                QString csAppId = cs["steamAppID"].toString();
-                if (!csAppId.isEmpty() && csAppId != "null" && csAppId != "0") {
-                    game["steamAppID"] = csAppId;
-                    game["headerImage"] = getSteamHeaderUrl(csAppId);
-                    game["heroImage"]   = getSteamHeroUrl(csAppId);
-                    game["capsuleImage"] = getSteamCapsuleUrl(csAppId);
-                }
-            }
-        }
-
-        // Set price fields if we have a CheapShark price
-        if (!cheapestPrice.isEmpty()) {
-            game["cheapestPrice"] = cheapestPrice;
-            game["salePrice"]     = cheapestPrice;
-            game["hasPrice"]      = true;
-        } else {
-            // No CheapShark price — will be scraped below
-            game["hasPrice"] = false;
-        }
-        if (!savings.isEmpty())
-            game["savings"] = savings;
+                if (!result.ok) {
+                    qWarning() << "IGDB search failed:" << result.error;
+                    state->completedCount++;
+                    checkMerge();
+                    return;
+                }
 
-        results->append(game);
+                runDecoder([body = result.body]() { return parseIgdbSearch(body); },
+                           [this, state, generation, checkMerge](const QVariantList& games) {
+                    if (generation != m_searchGeneration) return;
+                    state->igdbResults = games;
+                    state->completedCount++;
+                    checkMerge();
+                });
+            }, SearchGroup);
+        });
     }
 
-    // If no IGDB results came through but CheapShark has results, show those
-    // (graceful fallback if IGDB is down or has no credentials)
-    if (state->igdbResults.isEmpty() && !state->cheapSharkResults.isEmpty()) {
-        for (const auto& csVar : state->cheapSharkResults) {
-            QVariantMap cs = csVar.toMap();
-            QVariantMap game;
-            game["title"]     = cs["title"];
-            game["steamAppID"] = cs["steamAppID"];
-            game["cheapSharkGameID"] = cs["gameID"];
-            game["cheapestPrice"] = cs["cheapest"];
-            game["salePrice"]     = cs["cheapest"];
-            game["hasPrice"]      = true;
+    // ── 2. CheapShark search (for price data + CheapShark game IDs) ──
+    {
+        QUrl url(CHEAPSHARK_BASE + "/games");
+        QUrlQuery query;
+        query.addQueryItem("title", title);
+        query.addQueryItem("limit", "60");
+        url.setQuery(query);
 
-            QString appId = cs["steamAppID"].toString();
-            if (!appId.isEmpty() && appId != "null" && appId != "0") {
-                game["headerImage"] = getSteamHeaderUrl(appId);
-                game["heroImage"]   = getSteamHeroUrl(appId);
-                game["capsuleImage"] = getSteamCapsuleUrl(appId);
-            } else {
-                game["headerImage"] = cs["thumb"];
-                game["capsuleImage"] = cs["thumb"];
+        QNetworkRequest req(url);
+        sendRequest(req, "GET", QByteArray(),
+                    [this, state, generation, checkMerge](const NetResult& result) {
+            if (generation != m_searchGeneration) return;
+
+            if (!result.ok) {
+                qWarning() << "CheapShark search failed:" << result.error;
+                state->completedCount++;
+                checkMerge();
+                return;
             }
 
-            results->append(game);
-        }
+            runDecoder([body = result.body]() { return parseCheapSharkSearch(body); },
+                       [this, state, generation, checkMerge](const QVariantList& games) {
+                if (generation != m_searchGeneration) return;
+                state->cheapSharkResults = games;
+                state->completedCount++;
+                checkMerge();
+            });
+        }, SearchGroup);
     }
+}
+
+void StoreApiManager::mergeSearchResults(std::shared_ptr<SearchMergeState> state, int generation)
+{
+    if (generation != m_searchGeneration)
+        return;
 
+    // Matching and merging are pure list work; do them in the pool and
+    // pick the price scrape back up on the GUI thread
+    runDecoder([state, owned = m_ownedIndex]() {
+        return mergeSearchLists(state->localResults, state->igdbResults, state->cheapSharkResults, owned);
+    }, [this, generation](const QVariantList& merged) {
+        if (generation == m_searchGeneration)
+            scrapeMissingPrices(std::make_shared<QVariantList>(merged), generation);
+    });
+}
+
+void StoreApiManager::scrapeMissingPrices(std::shared_ptr<QVariantList> results, int generation)
+{
     // Emit initial results immediately (games with CheapShark prices show up instantly)
     emit searchResultsReady(*results);
 
@@ -513,34 +1169,27 @@ void StoreApiManager::mergeSearchResults(std::shared_ptr<SearchMergeState> state
     };
     auto scrapeState = std::make_shared<ScrapeState>();
 
-    // Helper: update a game's price if this source is cheaper
-    auto updateIfCheaper = [](QVariantMap& game, double price, double retailPrice, int discountPct) {
-        QString priceStr = QString::number(price, 'f', 2);
-        QString existing = game["salePrice"].toString();
-        if (existing.isEmpty() || price < existing.toDouble()) {
-            game["salePrice"] = priceStr;
-            game["cheapestPrice"] = priceStr;
-            game["normalPrice"] = QString::number(retailPrice, 'f', 2);
-            if (discountPct > 0)
-                game["savings"] = QString::number(discountPct);
+    auto hasSteamId = [](const QString& steamId) {
+        return !steamId.isEmpty() && steamId != "null" && steamId != "0";
+    };
+    auto gogLink = [](const QVariantMap& game) {
+        for (const auto& urlVar : game["purchaseUrls"].toList()) {
+            QVariantMap link = urlVar.toMap();
+            if (link["category"].toInt() == 17)
+                return link["url"].toString();
         }
-        game["hasPrice"] = true;
+        return QString();
     };
 
     // First pass: count pending requests
-    for (int i = 0; i < results->size(); i++) {
-        QVariantMap game = (*results)[i].toMap();
+    for (const auto& gameVar : *results) {
+        QVariantMap game = gameVar.toMap();
         if (game["hasPrice"].toBool()) continue;
 
-        QString steamId = game["steamAppID"].toString();
-        if (!steamId.isEmpty() && steamId != "null" && steamId != "0")
+        if (hasSteamId(game["steamAppID"].toString()))
+            scrapeState->pending++;
+        if (!gogLink(game).isEmpty())
             scrapeState->pending++;
-
-        QVariantList purchaseUrls = game["purchaseUrls"].toList();
-        for (const auto& urlVar : purchaseUrls) {
-            int cat = urlVar.toMap()["category"].toInt();
-            if (cat == 17) scrapeState->pending++;  // GOG
-        }
 
         // Epic and GMG: always search by title
         scrapeState->pending += 2;
@@ -560,287 +1209,47 @@ void StoreApiManager::mergeSearchResults(std::shared_ptr<SearchMergeState> state
         }
     };
 
-    // Second pass: fire requests
-    for (int i = 0; i < results->size(); i++) {
-        QVariantMap game = (*results)[i].toMap();
-        if (game["hasPrice"].toBool()) continue;
-
-        QString gameTitle = game["title"].toString();
-        QString steamId = game["steamAppID"].toString();
-        bool hasSteam = !steamId.isEmpty() && steamId != "null" && steamId != "0";
-
-        QVariantList purchaseUrls = game["purchaseUrls"].toList();
-        QString gogUrl;
-        for (const auto& urlVar : purchaseUrls) {
-            QVariantMap link = urlVar.toMap();
-            if (link["category"].toInt() == 17) {
-                gogUrl = link["url"].toString();
-                break;
-            }
-        }
-
-        // ── 1. Steam Store API ──
-        if (hasSteam) {
-            QUrl url(STEAM_STORE_API + "/appdetails");
-            QUrlQuery query;
-            query.addQueryItem("appids", steamId);
-            query.addQueryItem("cc", "us");
-            query.addQueryItem("filters", "basic,price_overview");
-            url.setQuery(query);
-
-            QNetworkRequest req(url);
-            req.setTransferTimeout(15000);
-            QNetworkReply *reply = m_nam->get(req);
-
-            connect(reply, &QNetworkReply::finished, this,
-                [this, reply, i, steamId, results, scrapeState, generation, updateIfCheaper, emitIfDone]() {
-                reply->deleteLater();
-                if (generation != m_searchGeneration) return;
+    // A store's deal replaces the game's price if it is cheaper
+    auto applyDeal = [this, results, scrapeState, generation, emitIfDone](int i) -> DealHandler {
+        return [this, i, results, scrapeState, generation, emitIfDone](const QVariantMap& deal, bool) {
+            if (generation != m_searchGeneration) return;
 
-                if (reply->error() == QNetworkReply::NoError) {
-                    QJsonObject root = QJsonDocument::fromJson(reply->readAll()).object();
-                    QJsonObject appData = root[steamId].toObject();
-                    if (appData["success"].toBool()) {
-                        QJsonObject data = appData["data"].toObject();
-                        QJsonObject po = data["price_overview"].toObject();
-                        QVariantMap game = (*results)[i].toMap();
-                        if (!po.isEmpty()) {
-                            qDebug() << "Steam scrape: found price for appId" << steamId
-                                     << "$" << (po["final"].toInt() / 100.0);
-                            updateIfCheaper(game,
-                                po["final"].toInt() / 100.0,
-                                po["initial"].toInt() / 100.0,
-                                po["discount_percent"].toInt());
-                        } else if (data["is_free"].toBool()) {
-                            qDebug() << "Steam scrape: appId" << steamId << "is free";
-                            game["salePrice"] = QStringLiteral("0.00");
-                            game["cheapestPrice"] = QStringLiteral("0.00");
-                            game["hasPrice"] = true;
-                        } else {
-                            qDebug() << "Steam scrape: no price data for appId" << steamId;
-                        }
-                        (*results)[i] = game;
-                    } else {
-                        qDebug() << "Steam scrape: API returned failure for appId" << steamId;
-                    }
-                } else {
-                    qWarning() << "Steam scrape failed for appId" << steamId << ":" << reply->errorString();
+            if (!deal.isEmpty()) {
+                QVariantMap game = (*results)[i].toMap();
+                double price = deal["price"].toString().toDouble();
+                QString existing = game["salePrice"].toString();
+                if (existing.isEmpty() || price < existing.toDouble()) {
+                    QString priceStr = QString::number(price, 'f', 2);
+                    game["salePrice"] = priceStr;
+                    game["cheapestPrice"] = priceStr;
+                    game["normalPrice"] = QString::number(deal["retailPrice"].toString().toDouble(), 'f', 2);
+                    int discountPct = deal["savings"].toString().toInt();
+                    if (discountPct > 0)
+                        game["savings"] = QString::number(discountPct);
                 }
-                scrapeState->pending--;
-                emitIfDone();
-            });
-        }
-
-        // ── 2. GOG catalog API ──
-        if (!gogUrl.isEmpty()) {
-            QRegularExpression gogSlugRe("/game/([a-z0-9_-]+)");
-            QRegularExpressionMatch match = gogSlugRe.match(gogUrl);
-            if (match.hasMatch()) {
-                QString slug = match.captured(1);
-                QUrl catUrl("https://catalog.gog.com/v1/catalog");
-                QUrlQuery gogQuery;
-                gogQuery.addQueryItem("query", slug);
-                gogQuery.addQueryItem("limit", "1");
-                gogQuery.addQueryItem("countryCode", "US");
-                gogQuery.addQueryItem("currencyCode", "USD");
-                catUrl.setQuery(gogQuery);
-
-                QNetworkRequest gogReq(catUrl);
-                gogReq.setTransferTimeout(15000);
-                QNetworkReply *gogReply = m_nam->get(gogReq);
-
-                connect(gogReply, &QNetworkReply::finished, this,
-                    [this, gogReply, i, results, scrapeState, generation, updateIfCheaper, emitIfDone]() {
-                    gogReply->deleteLater();
-                    if (generation != m_searchGeneration) return;
-                    if (gogReply->error() == QNetworkReply::NoError) {
-                        QJsonObject root = QJsonDocument::fromJson(gogReply->readAll()).object();
-                        QJsonArray products = root["products"].toArray();
-                        if (!products.isEmpty()) {
-                            QJsonObject price = products.first().toObject()["price"].toObject();
-                            if (!price.isEmpty()) {
-                                QString finalStr = price["finalMoney"].toObject()["amount"].toString();
-                                QString baseStr = price["baseMoney"].toObject()["amount"].toString();
-                                if (!finalStr.isEmpty()) {
-                                    QVariantMap game = (*results)[i].toMap();
-                                    updateIfCheaper(game, finalStr.toDouble(), baseStr.toDouble(),
-                                                    price["discount"].toInt());
-                                    (*results)[i] = game;
-                                }
-                            }
-                        }
-                    }
-                    scrapeState->pending--;
-                    emitIfDone();
-                });
-            } else {
-                scrapeState->pending--;
-                emitIfDone();
+                game["hasPrice"] = true;
+                (*results)[i] = game;
             }
-        }
-
-        // ── 3. Epic Games Store (GraphQL search) ──
-        {
-            QUrl epicUrl("https://graphql.epicgames.com/graphql");
-            QNetworkRequest epicReq(epicUrl);
-            epicReq.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-            epicReq.setTransferTimeout(15000);
-
-            QJsonObject variables;
-            variables["keywords"] = gameTitle;
-            variables["country"] = QStringLiteral("US");
-
-            QJsonObject body;
-            body["query"] = QStringLiteral(
-                "query searchStoreQuery($keywords: String!, $country: String!) {"
-                "  Catalog {"
-                "    searchStore(keywords: $keywords, country: $country, count: 1,"
-                "               sortBy: \"relevancy\", sortDir: \"DESC\", category: \"games\") {"
-                "      elements {"
-                "        title"
-                "        price(country: $country) {"
-                "          totalPrice {"
-                "            discountPrice originalPrice discount"
-                "            currencyCode currencyInfo { decimals }"
-                "          }"
-                "        }"
-                "      }"
-                "    }"
-                "  }"
-                "}");
-            body["variables"] = variables;
-
-            QNetworkReply *epicReply = m_nam->post(epicReq, QJsonDocument(body).toJson(QJsonDocument::Compact));
-
-            connect(epicReply, &QNetworkReply::finished, this,
-                [this, epicReply, i, gameTitle, results, scrapeState, generation, updateIfCheaper, emitIfDone]() {
-                epicReply->deleteLater();
-                if (generation != m_searchGeneration) return;
+            scrapeState->pending--;
+            emitIfDone();
+        };
+    };
 
-                if (epicReply->error() == QNetworkReply::NoError) {
-                    QJsonObject root = QJsonDocument::fromJson(epicReply->readAll()).object();
-                    QJsonArray elements = root["data"].toObject()
-                        ["Catalog"].toObject()
-                        ["searchStore"].toObject()
-                        ["elements"].toArray();
-
-                    if (!elements.isEmpty()) {
-                        // Verify title is a reasonable match (startsWith handles edition suffixes)
-                        QString foundTitle = elements.first().toObject()["title"].toString();
-                        QString normFound = normalizeTitle(foundTitle);
-                        QString normSearch = normalizeTitle(gameTitle);
-                        if (normFound == normSearch
-                            || normFound.startsWith(normSearch)
-                            || normSearch.startsWith(normFound)) {
-                            QJsonObject totalPrice = elements.first().toObject()
-                                ["price"].toObject()["totalPrice"].toObject();
-                            int decimals = totalPrice["currencyInfo"].toObject()["decimals"].toInt(2);
-                            double divisor = std::pow(10.0, decimals);
-                            double finalPrice = totalPrice["discountPrice"].toInt() / divisor;
-                            double origPrice = totalPrice["originalPrice"].toInt() / divisor;
-                            int discountAmt = totalPrice["discount"].toInt();
-                            int discountPct = (origPrice > 0) ? qRound(discountAmt / divisor / origPrice * 100.0) : 0;
-
-                            if (finalPrice >= 0) {
-                                qDebug() << "Epic scrape: found price for" << gameTitle
-                                         << "$" << finalPrice;
-                                QVariantMap game = (*results)[i].toMap();
-                                updateIfCheaper(game, finalPrice, origPrice, discountPct);
-                                (*results)[i] = game;
-                            }
-                        } else {
-                            qDebug() << "Epic scrape: title mismatch for" << gameTitle
-                                     << "- Epic returned:" << foundTitle;
-                        }
-                    } else {
-                        qDebug() << "Epic scrape: no results for" << gameTitle;
-                    }
-                } else {
-                    qWarning() << "Epic scrape failed for" << gameTitle << ":" << epicReply->errorString();
-                }
-                scrapeState->pending--;
-                emitIfDone();
-            });
-        }
+    // Second pass: fire requests
+    for (int i = 0; i < results->size(); i++) {
+        QVariantMap game = (*results)[i].toMap();
+        if (game["hasPrice"].toBool()) continue;
 
-        // ── 4. Green Man Gaming (search API) ──
-        {
-            QUrl gmgUrl("https://www.greenmangaming.com/api/quicksearch/autocomplete/suggestions");
-            QUrlQuery gmgQuery;
-            gmgQuery.addQueryItem("term", gameTitle);
-            gmgQuery.addQueryItem("max", "1");
-            gmgUrl.setQuery(gmgQuery);
-
-            QNetworkRequest gmgReq(gmgUrl);
-            gmgReq.setRawHeader("Accept", "application/json");
-            gmgReq.setRawHeader("User-Agent",
-                "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36");
-            gmgReq.setTransferTimeout(15000);
-
-            QNetworkReply *gmgReply = m_nam->get(gmgReq);
-
-            connect(gmgReply, &QNetworkReply::finished, this,
-                [this, gmgReply, i, gameTitle, results, scrapeState, generation, updateIfCheaper, emitIfDone]() {
-                gmgReply->deleteLater();
-                if (generation != m_searchGeneration) return;
+        const QString gameTitle = game["title"].toString();
+        const QString steamId = game["steamAppID"].toString();
+        const QString gogUrl = gogLink(game);
 
-                if (gmgReply->error() == QNetworkReply::NoError) {
-                    QJsonDocument doc = QJsonDocument::fromJson(gmgReply->readAll());
-                    // GMG autocomplete returns an array of products
-                    QJsonArray arr = doc.isArray() ? doc.array() : QJsonArray();
-                    // Or it may be { products: [...] }
-                    if (arr.isEmpty() && doc.isObject())
-                        arr = doc.object()["products"].toArray();
-
-                    bool found = false;
-                    for (const auto& val : arr) {
-                        QJsonObject product = val.toObject();
-                        QString title = product["name"].toString();
-                        if (title.isEmpty())
-                            title = product["title"].toString();
-
-                        QString normProduct = normalizeTitle(title);
-                        QString normSearch = normalizeTitle(gameTitle);
-                        if (normProduct != normSearch
-                            && !normProduct.startsWith(normSearch)
-                            && !normSearch.startsWith(normProduct))
-                            continue;
-
-                        // Try multiple price field patterns GMG has used
-                        double price = -1;
-                        double basePrice = -1;
-
-                        if (product.contains("currentPrice")) {
-                            price = product["currentPrice"].toDouble(-1);
-                            basePrice = product["basePrice"].toDouble(price);
-                        } else if (product.contains("price")) {
-                            QJsonObject priceObj = product["price"].toObject();
-                            price = priceObj["current"].toDouble(-1);
-                            if (price < 0) price = priceObj["amount"].toDouble(-1);
-                            basePrice = priceObj["base"].toDouble(price);
-                        }
-
-                        if (price >= 0) {
-                            qDebug() << "GMG scrape: found price for" << gameTitle
-                                     << "$" << price;
-                            int discountPct = (basePrice > 0 && basePrice > price)
-                                ? qRound((1.0 - price / basePrice) * 100.0) : 0;
-                            QVariantMap game = (*results)[i].toMap();
-                            updateIfCheaper(game, price, basePrice, discountPct);
-                            (*results)[i] = game;
-                            found = true;
-                        }
-                        break;
-                    }
-                    if (!found)
-                        qDebug() << "GMG scrape: no matching result for" << gameTitle;
-                } else {
-                    qWarning() << "GMG scrape failed for" << gameTitle << ":" << gmgReply->errorString();
-                }
-                scrapeState->pending--;
-                emitIfDone();
-            });
-        }
+        if (hasSteamId(steamId))
+            scrapeSteamPrice(steamId, SearchGroup, applyDeal(i));
+        if (!gogUrl.isEmpty() && !scrapeGogPrice(gogUrl, SearchGroup, applyDeal(i)))
+            applyDeal(i)(QVariantMap(), true);
+        scrapeEpicPrice(gameTitle, SearchGroup, applyDeal(i));
+        scrapeGmgPrice(gameTitle, SearchGroup, applyDeal(i));
     }
 }
 
@@ -882,63 +1291,15 @@ void StoreApiManager::fetchGameDeals(const QString& cheapSharkGameId)
     url.setQuery(query);
 
     QNetworkRequest req(url);
-    req.setTransferTimeout(15000);
-    QNetworkReply *reply = m_nam->get(req);
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            emit gameDealsError(reply->errorString());
-            return;
-        }
-
-        QJsonObject root = QJsonDocument::fromJson(reply->readAll()).object();
-        QVariantMap details;
-
-        // Game info
-        QJsonObject info = root["info"].toObject();
-        details["title"]      = info["title"].toString();
-        details["steamAppID"] = info["steamAppID"].toString();
-        details["thumb"]      = info["thumb"].toString();
-
-        QString appId = info["steamAppID"].toString();
-        if (!appId.isEmpty() && appId != "null" && appId != "0") {
-            details["headerImage"] = getSteamHeaderUrl(appId);
-            details["heroImage"]   = getSteamHeroUrl(appId);
-        } else {
-            details["headerImage"] = info["thumb"].toString();
-            details["heroImage"]   = info["thumb"].toString();
-        }
-
-        // Cheapest price ever
-        QJsonObject cheapest = root["cheapestPriceEver"].toObject();
-        details["cheapestEverPrice"] = cheapest["price"].toString();
-        details["cheapestEverDate"]  = cheapest["date"].toInteger();
-
-        // All current deals across stores
-        QJsonArray dealsArr = root["deals"].toArray();
-        QVariantList deals;
-        for (const auto& val : dealsArr) {
-            QJsonObject obj = val.toObject();
-            QVariantMap deal;
-            deal["storeID"]     = obj["storeID"].toString();
-            deal["dealID"]      = obj["dealID"].toString();
-            deal["price"]       = obj["price"].toString();
-            deal["retailPrice"] = obj["retailPrice"].toString();
-            deal["savings"]     = obj["savings"].toString();
-
-            int storeId = obj["storeID"].toString().toInt();
-            deal["storeName"] = getStoreName(storeId);
-            deal["storeIcon"] = getStoreIconUrl(storeId);
-            deal["dealLink"]  = QStringLiteral("https://www.cheapshark.com/redirect?dealID=")
-                                + obj["dealID"].toString();
-            deal["source"]    = QStringLiteral("CheapShark");
-
-            deals.append(deal);
-        }
-        details["deals"] = deals;
 
-        emit gameDealsReady(details);
+    fetchCached(req, "GET", QByteArray(), GAME_DEALS_CACHE, [this](const QByteArray& body) {
+        runDecoder([body, names = m_storeNames, icons = m_storeIcons]() {
+            return QVariantList{parseGameDeals(body, names, icons)};
+        }, [this](const QVariantList& decoded) {
+            emit gameDealsReady(decoded.value(0).toMap());
+        });
+    }, [this](const QString& error) {
+        emit gameDealsError(error);
     });
 }
 
@@ -948,52 +1309,114 @@ void StoreApiManager::fetchStores()
 {
     QUrl url(CHEAPSHARK_BASE + "/stores");
     QNetworkRequest req(url);
-    req.setTransferTimeout(10000);
-    QNetworkReply *reply = m_nam->get(req);
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            emit storesError(reply->errorString());
-            return;
-        }
 
-        QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-        QVariantList stores;
-        m_storeNames.clear();
-        m_storeIcons.clear();
-
-        for (const auto& val : arr) {
-            QJsonObject obj = val.toObject();
-            int storeId = obj["storeID"].toString().toInt();
-            QString name = obj["storeName"].toString();
-            QJsonObject images = obj["images"].toObject();
-            QString icon = "https://www.cheapshark.com" + images["icon"].toString();
-
-            m_storeNames[storeId] = name;
-            m_storeIcons[storeId] = icon;
-
-            QVariantMap store;
-            store["storeID"]   = storeId;
-            store["storeName"] = name;
-            store["icon"]      = icon;
-            store["isActive"]  = obj["isActive"].toInt();
-            stores.append(store);
-        }
+    // Store names almost never change; a week-old list is still fresh
+    fetchCached(req, "GET", QByteArray(), STORES_CACHE, [this](const QByteArray& body) {
+        runDecoder([body]() { return parseStoreList(body); }, [this](const QVariantList& stores) {
+            m_storeNames.clear();
+            m_storeIcons.clear();
+            for (const auto& storeVar : stores) {
+                QVariantMap store = storeVar.toMap();
+                int storeId = store["storeID"].toInt();
+                m_storeNames[storeId] = store["storeName"].toString();
+                m_storeIcons[storeId] = store["icon"].toString();
+            }
 
-        m_storesLoaded = true;
-        emit storesReady(stores);
+            m_storesLoaded = true;
+            emit storesReady(stores);
+        });
+    }, [this](const QString& error) {
+        emit storesError(error);
     });
 }
 
 // ─── Store Price Scraping (fallback for games without CheapShark prices) ───
 
+QString StoreApiManager::priceSnapshotKey(const QString& steamAppId, const QString& gameTitle)
+{
+    if (!steamAppId.isEmpty() && steamAppId != "null" && steamAppId != "0")
+        return "steam:" + steamAppId;
+    return "title:" + normalizeTitle(gameTitle);
+}
+
 void StoreApiManager::fetchStorePrices(const QString& steamAppId, const QVariantList& purchaseUrls,
                                         const QString& gameTitle)
 {
+    const PriceJob job{priceSnapshotKey(steamAppId, gameTitle), steamAppId, purchaseUrls, gameTitle};
+    m_priceViewKey = job.key;
+
+    // Answer from the last scrape; only a stale one is refreshed, and
+    // that happens behind the popup rather than before it
+    QVariantList snapshot;
+    qint64 fetchedAt = 0;
+    if (m_db && m_db->getPriceSnapshot(job.key, &snapshot, &fetchedAt)) {
+        emit storePricesReady(snapshot);
+        if (QDateTime::currentSecsSinceEpoch() - fetchedAt >= PRICE_SNAPSHOT_TTL)
+            queuePriceRefresh(job);
+        return;
+    }
+
+    const bool started = scrapeStorePrices(job, [this, job](const QVariantList& deals, bool answered) {
+        finishPriceScrape(job, deals, answered, false);
+    });
+    if (!started)
+        emit storePricesError("No store links available");
+}
+
+void StoreApiManager::queuePriceRefresh(const PriceJob& job)
+{
+    if (job.key == m_priceRefreshKey) return;
+    for (const PriceJob& queued : m_priceQueue) {
+        if (queued.key == job.key) return;
+    }
+    m_priceQueue.append(job);
+    if (m_priceRefreshKey.isEmpty() && !m_priceTimer->isActive())
+        m_priceTimer->start();
+}
+
+void StoreApiManager::refreshNextPriceSnapshot()
+{
+    if (!m_priceRefreshKey.isEmpty() || m_priceQueue.isEmpty()) return;
+
+    const PriceJob job = m_priceQueue.takeFirst();
+    m_priceRefreshKey = job.key;
+    const bool started = scrapeStorePrices(job, [this, job](const QVariantList& deals, bool answered) {
+        finishPriceScrape(job, deals, answered, true);
+        m_priceRefreshKey.clear();
+        if (!m_priceQueue.isEmpty())
+            m_priceTimer->start();
+    });
+    if (!started) {
+        m_priceRefreshKey.clear();
+        if (!m_priceQueue.isEmpty())
+            m_priceTimer->start();
+    }
+}
+
+void StoreApiManager::finishPriceScrape(const PriceJob& job, const QVariantList& deals,
+                                        bool answered, bool background)
+{
+    // A scrape with network failures would overwrite good prices with
+    // holes; keep the old snapshot and try again next time
+    if (answered && m_db)
+        m_db->setPriceSnapshot(job.key, deals);
+
+    if (job.key != m_priceViewKey) return;
+    // The popup already shows the stale snapshot; don't blank it
+    if (background && !answered) return;
+    emit storePricesReady(deals);
+}
+
+bool StoreApiManager::scrapeStorePrices(const PriceJob& job, PriceHandler onDone)
+{
+    const QString& steamAppId = job.steamAppId;
+    const QVariantList& purchaseUrls = job.purchaseUrls;
+    const QString& gameTitle = job.gameTitle;
+
     struct PriceState {
         QVariantList deals;
         int pending = 0;
+        int unanswered = 0;   // network failures, as opposed to "no price"
     };
     auto priceState = std::make_shared<PriceState>();
 
@@ -1011,59 +1434,21 @@ void StoreApiManager::fetchStorePrices(const QString& steamAppId, const QVariant
     bool hasTitle = !gameTitle.trimmed().isEmpty();
     if (hasTitle) priceState->pending += 2;  // Epic + GMG
 
-    if (priceState->pending == 0) {
-        emit storePricesError("No store links available");
-        return;
-    }
+    if (priceState->pending == 0)
+        return false;
 
-    auto checkDone = [this, priceState]() {
-        if (priceState->pending <= 0)
-            emit storePricesReady(priceState->deals);
+    DealHandler collect = [priceState, onDone](const QVariantMap& deal, bool answered) {
+        if (!deal.isEmpty())
+            priceState->deals.append(deal);
+        if (!answered)
+            priceState->unanswered++;
+        if (--priceState->pending <= 0)
+            onDone(priceState->deals, priceState->unanswered == 0);
     };
 
     // ── 1. Steam Store API ──
-    if (hasSteam) {
-        QUrl url(STEAM_STORE_API + "/appdetails");
-        QUrlQuery query;
-        query.addQueryItem("appids", steamAppId);
-        query.addQueryItem("cc", "us");
-        query.addQueryItem("filters", "basic,price_overview");
-        url.setQuery(query);
-
-        QNetworkRequest req(url);
-        req.setTransferTimeout(15000);
-        QNetworkReply *reply = m_nam->get(req);
-
-        connect(reply, &QNetworkReply::finished, this, [reply, steamAppId, priceState, checkDone]() {
-            reply->deleteLater();
-            if (reply->error() == QNetworkReply::NoError) {
-                QJsonObject root = QJsonDocument::fromJson(reply->readAll()).object();
-                QJsonObject appData = root[steamAppId].toObject();
-                if (appData["success"].toBool()) {
-                    QJsonObject data = appData["data"].toObject();
-                    QJsonObject po = data["price_overview"].toObject();
-                    QVariantMap deal;
-                    deal["storeName"] = QStringLiteral("Steam");
-                    deal["storeIcon"] = QStringLiteral("https://www.cheapshark.com/img/stores/icons/0.png");
-                    deal["dealLink"] = QStringLiteral("https://store.steampowered.com/app/") + steamAppId;
-                    deal["source"] = QStringLiteral("Steam");
-                    if (!po.isEmpty()) {
-                        deal["price"] = QString::number(po["final"].toInt() / 100.0, 'f', 2);
-                        deal["retailPrice"] = QString::number(po["initial"].toInt() / 100.0, 'f', 2);
-                        deal["savings"] = QString::number(po["discount_percent"].toInt());
-                        priceState->deals.append(deal);
-                    } else if (data["is_free"].toBool()) {
-                        deal["price"] = QStringLiteral("0.00");
-                        deal["retailPrice"] = QStringLiteral("0.00");
-                        deal["savings"] = QStringLiteral("0");
-                        priceState->deals.append(deal);
-                    }
-                }
-            }
-            priceState->pending--;
-            checkDone();
-        });
-    }
+    if (hasSteam)
+        scrapeSteamPrice(steamAppId, NoGroup, collect);
 
     // ── 2. GOG + Itch.io from purchase URLs ──
     for (const auto& urlVar : purchaseUrls) {
@@ -1074,49 +1459,8 @@ void StoreApiManager::fetchStorePrices(const QString& steamAppId, const QVariant
 
         if (cat == 13 || cat == 16) continue;  // Steam + Epic handled separately
 
-        if (cat == 17 && storeUrl.contains("gog.com")) {
-            QRegularExpression gogSlugRe("/game/([a-z0-9_-]+)");
-            QRegularExpressionMatch match = gogSlugRe.match(storeUrl);
-            if (match.hasMatch()) {
-                QString slug = match.captured(1);
-                QUrl gogCatUrl("https://catalog.gog.com/v1/catalog");
-                QUrlQuery gogQuery;
-                gogQuery.addQueryItem("query", slug);
-                gogQuery.addQueryItem("limit", "1");
-                gogQuery.addQueryItem("countryCode", "US");
-                gogQuery.addQueryItem("currencyCode", "USD");
-                gogCatUrl.setQuery(gogQuery);
-
-                QNetworkRequest gogReq(gogCatUrl);
-                gogReq.setTransferTimeout(15000);
-                QNetworkReply *gogReply = m_nam->get(gogReq);
-
-                connect(gogReply, &QNetworkReply::finished, this,
-                    [gogReply, storeUrl, priceState, checkDone]() {
-                    gogReply->deleteLater();
-                    if (gogReply->error() == QNetworkReply::NoError) {
-                        QJsonArray products = QJsonDocument::fromJson(gogReply->readAll())
-                            .object()["products"].toArray();
-                        if (!products.isEmpty()) {
-                            QJsonObject price = products.first().toObject()["price"].toObject();
-                            if (!price.isEmpty()) {
-                                QVariantMap deal;
-                                deal["storeName"] = QStringLiteral("GOG");
-                                deal["price"] = price["finalMoney"].toObject()["amount"].toString();
-                                deal["retailPrice"] = price["baseMoney"].toObject()["amount"].toString();
-                                deal["savings"] = QString::number(price["discount"].toInt());
-                                deal["dealLink"] = storeUrl;
-                                deal["source"] = QStringLiteral("GOG");
-                                priceState->deals.append(deal);
-                            }
-                        }
-                    }
-                    priceState->pending--;
-                    checkDone();
-                });
-                continue;
-            }
-        }
+        if (cat == 17 && storeUrl.contains("gog.com") && scrapeGogPrice(storeUrl, NoGroup, collect))
+            continue;
 
         // Itch.io and others: show as purchase link without price
         QVariantMap deal;
@@ -1126,152 +1470,127 @@ void StoreApiManager::fetchStorePrices(const QString& steamAppId, const QVariant
         deal["savings"] = QStringLiteral("0");
         deal["dealLink"] = storeUrl;
         deal["source"] = storeName;
-        priceState->deals.append(deal);
-        priceState->pending--;
-        checkDone();
+        collect(deal, true);
     }
 
-    // ── 3. Epic Games Store (GraphQL) ──
+    // ── 3. Epic Games Store + 4. Green Man Gaming (title search) ──
     if (hasTitle) {
-        QUrl epicUrl("https://graphql.epicgames.com/graphql");
-        QNetworkRequest epicReq(epicUrl);
-        epicReq.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-        epicReq.setTransferTimeout(15000);
-
-        QJsonObject variables;
-        variables["keywords"] = gameTitle;
-        variables["country"] = QStringLiteral("US");
-        QJsonObject body;
-        body["query"] = QStringLiteral(
-            "query searchStoreQuery($keywords: String!, $country: String!) {"
-            "  Catalog {"
-            "    searchStore(keywords: $keywords, country: $country, count: 1,"
-            "               sortBy: \"relevancy\", sortDir: \"DESC\", category: \"games\") {"
-            "      elements {"
-            "        title"
-            "        price(country: $country) {"
-            "          totalPrice {"
-            "            discountPrice originalPrice discount"
-            "            currencyCode currencyInfo { decimals }"
-            "          }"
-            "        }"
-            "      }"
-            "    }"
-            "  }"
-            "}");
-        body["variables"] = variables;
-
-        QNetworkReply *epicReply = m_nam->post(epicReq, QJsonDocument(body).toJson(QJsonDocument::Compact));
-
-        connect(epicReply, &QNetworkReply::finished, this,
-            [epicReply, gameTitle, priceState, checkDone]() {
-            epicReply->deleteLater();
-            if (epicReply->error() == QNetworkReply::NoError) {
-                QJsonArray elements = QJsonDocument::fromJson(epicReply->readAll()).object()
-                    ["data"].toObject()["Catalog"].toObject()
-                    ["searchStore"].toObject()["elements"].toArray();
-
-                if (!elements.isEmpty()) {
-                    QString foundTitle = elements.first().toObject()["title"].toString();
-                    QString normFound = normalizeTitle(foundTitle);
-                    QString normSearch = normalizeTitle(gameTitle);
-                    if (normFound == normSearch
-                        || normFound.startsWith(normSearch)
-                        || normSearch.startsWith(normFound)) {
-                        QJsonObject tp = elements.first().toObject()
-                            ["price"].toObject()["totalPrice"].toObject();
-                        int decimals = tp["currencyInfo"].toObject()["decimals"].toInt(2);
-                        double divisor = std::pow(10.0, decimals);
-                        double finalPrice = tp["discountPrice"].toInt() / divisor;
-                        double origPrice = tp["originalPrice"].toInt() / divisor;
-                        int discountAmt = tp["discount"].toInt();
-                        int discountPct = (origPrice > 0) ? qRound(discountAmt / divisor / origPrice * 100.0) : 0;
-
-                        if (finalPrice >= 0) {
-                            QVariantMap deal;
-                            deal["storeName"] = QStringLiteral("Epic Games");
-                            deal["price"] = QString::number(finalPrice, 'f', 2);
-                            deal["retailPrice"] = QString::number(origPrice, 'f', 2);
-                            deal["savings"] = QString::number(discountPct);
-                            deal["dealLink"] = QStringLiteral("https://store.epicgames.com/en-US/browse?q=")
-                                + QUrl::toPercentEncoding(gameTitle);
-                            deal["source"] = QStringLiteral("Epic Games");
-                            priceState->deals.append(deal);
-                        }
-                    }
-                }
-            }
-            priceState->pending--;
-            checkDone();
-        });
+        scrapeEpicPrice(gameTitle, NoGroup, collect);
+        scrapeGmgPrice(gameTitle, NoGroup, collect);
     }
 
-    // ── 4. Green Man Gaming (search API) ──
-    if (hasTitle) {
-        QUrl gmgUrl("https://www.greenmangaming.com/api/quicksearch/autocomplete/suggestions");
-        QUrlQuery gmgQuery;
-        gmgQuery.addQueryItem("term", gameTitle);
-        gmgQuery.addQueryItem("max", "1");
-        gmgUrl.setQuery(gmgQuery);
-
-        QNetworkRequest gmgReq(gmgUrl);
-        gmgReq.setRawHeader("Accept", "application/json");
-        gmgReq.setRawHeader("User-Agent",
-            "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36");
-        gmgReq.setTransferTimeout(15000);
-
-        QNetworkReply *gmgReply = m_nam->get(gmgReq);
-
-        connect(gmgReply, &QNetworkReply::finished, this,
-            [gmgReply, gameTitle, priceState, checkDone]() {
-            gmgReply->deleteLater();
-            if (gmgReply->error() == QNetworkReply::NoError) {
-                QJsonDocument doc = QJsonDocument::fromJson(gmgReply->readAll());
-                QJsonArray arr = doc.isArray() ? doc.array() : QJsonArray();
-                if (arr.isEmpty() && doc.isObject())
-                    arr = doc.object()["products"].toArray();
-
-                for (const auto& val : arr) {
-                    QJsonObject product = val.toObject();
-                    QString title = product["name"].toString();
-                    if (title.isEmpty()) title = product["title"].toString();
-                    QString normProduct = normalizeTitle(title);
-                    QString normSearch = normalizeTitle(gameTitle);
-                    if (normProduct != normSearch
-                        && !normProduct.startsWith(normSearch)
-                        && !normSearch.startsWith(normProduct))
-                        continue;
-
-                    double price = -1, basePrice = -1;
-                    if (product.contains("currentPrice")) {
-                        price = product["currentPrice"].toDouble(-1);
-                        basePrice = product["basePrice"].toDouble(price);
-                    } else if (product.contains("price")) {
-                        QJsonObject po = product["price"].toObject();
-                        price = po["current"].toDouble(-1);
-                        if (price < 0) price = po["amount"].toDouble(-1);
-                        basePrice = po["base"].toDouble(price);
-                    }
-
-                    if (price >= 0) {
-                        int discountPct = (basePrice > 0 && basePrice > price)
-                            ? qRound((1.0 - price / basePrice) * 100.0) : 0;
-                        QVariantMap deal;
-                        deal["storeName"] = QStringLiteral("Green Man Gaming");
-                        deal["price"] = QString::number(price, 'f', 2);
-                        deal["retailPrice"] = QString::number(basePrice, 'f', 2);
-                        deal["savings"] = QString::number(discountPct);
-                        deal["dealLink"] = product["url"].toString();
-                        deal["source"] = QStringLiteral("GMG");
-                        priceState->deals.append(deal);
-                    }
-                    break;
-                }
-            }
-            priceState->pending--;
-            checkDone();
+    return true;
+}
+
+// ── One scraper per store ──
+// Shared by search results and the price popup.  The answer is parsed on
+// the decode pool; onDone gets the store's deal (empty if it has no
+// price) and whether the store could be reached at all.
+
+void StoreApiManager::scrapeDeal(const QNetworkRequest& req, const QByteArray& verb,
+                                 const QByteArray& body, int group, DealParser parse,
+                                 DealHandler onDone)
+{
+    sendRequest(req, verb, body, [this, parse, onDone, host = req.url().host()](const NetResult& result) {
+        if (!result.ok) {
+            qWarning() << "Price scrape failed on" << host << ":" << result.error;
+            // An HTTP error is still an answer; no status means no contact
+            onDone(QVariantMap(), result.httpStatus != 0);
+            return;
+        }
+        runDecoder([parse, body = result.body]() {
+            QVariantMap deal = parse(body);
+            return deal.isEmpty() ? QVariantList() : QVariantList{deal};
+        }, [onDone](const QVariantList& decoded) {
+            onDone(decoded.value(0).toMap(), true);
         });
-    }
+    }, group);
+}
+
+void StoreApiManager::scrapeSteamPrice(const QString& steamAppId, int group, DealHandler onDone)
+{
+    QUrl url(STEAM_STORE_API + "/appdetails");
+    QUrlQuery query;
+    query.addQueryItem("appids", steamAppId);
+    query.addQueryItem("cc", "us");
+    query.addQueryItem("filters", "basic,price_overview");
+    url.setQuery(query);
+
+    scrapeDeal(QNetworkRequest(url), "GET", QByteArray(), group,
+               [steamAppId](const QByteArray& body) { return parseSteamPrice(body, steamAppId); },
+               std::move(onDone));
+}
+
+bool StoreApiManager::scrapeGogPrice(const QString& storeUrl, int group, DealHandler onDone)
+{
+    static const QRegularExpression gogSlugRe("/game/([a-z0-9_-]+)");
+    QRegularExpressionMatch match = gogSlugRe.match(storeUrl);
+    if (!match.hasMatch())
+        return false;
+
+    QUrl url("https://catalog.gog.com/v1/catalog");
+    QUrlQuery query;
+    query.addQueryItem("query", match.captured(1));
+    query.addQueryItem("limit", "1");
+    query.addQueryItem("countryCode", "US");
+    query.addQueryItem("currencyCode", "USD");
+    url.setQuery(query);
+
+    scrapeDeal(QNetworkRequest(url), "GET", QByteArray(), group,
+               [storeUrl](const QByteArray& body) { return parseGogPrice(body, storeUrl); },
+               std::move(onDone));
+    return true;
+}
+
+void StoreApiManager::scrapeEpicPrice(const QString& gameTitle, int group, DealHandler onDone)
+{
+    QNetworkRequest req(QUrl("https://graphql.epicgames.com/graphql"));
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QJsonObject variables;
+    variables["keywords"] = gameTitle;
+    variables["country"] = QStringLiteral("US");
+    QJsonObject body;
+    body["query"] = QStringLiteral(
+        "query searchStoreQuery($keywords: String!, $country: String!) {"
+        "  Catalog {"
+        "    searchStore(keywords: $keywords, country: $country, count: 1,"
+        "               sortBy: \"relevancy\", sortDir: \"DESC\", category: \"games\") {"
+        "      elements {"
+        "        title"
+        "        price(country: $country) {"
+        "          totalPrice {"
+        "            discountPrice originalPrice discount"
+        "            currencyCode currencyInfo { decimals }"
+        "          }"
+        "        }"
+        "      }"
+        "    }"
+        "  }"
+        "}");
+    body["variables"] = variables;
+
+    scrapeDeal(req, "POST", QJsonDocument(body).toJson(QJsonDocument::Compact), group,
+               [gameTitle](const QByteArray& data) { return parseEpicPrice(data, gameTitle); },
+               std::move(onDone));
+}
+
+void StoreApiManager::scrapeGmgPrice(const QString& gameTitle, int group, DealHandler onDone)
+{
+    QUrl url("https://www.greenmangaming.com/api/quicksearch/autocomplete/suggestions");
+    QUrlQuery query;
+    query.addQueryItem("term", gameTitle);
+    query.addQueryItem("max", "1");
+    url.setQuery(query);
+
+    QNetworkRequest req(url);
+    req.setRawHeader("Accept", "application/json");
+    req.setRawHeader("User-Agent",
+        "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36");
+
+    scrapeDeal(req, "GET", QByteArray(), group,
+               [gameTitle](const QByteArray& body) { return parseGmgPrice(body, gameTitle); },
+               std::move(onDone));
 }
 
 // ─── IGDB API ───
@@ -1283,96 +1602,151 @@ void StoreApiManager::fetchIGDBGameInfo(const QString& gameName)
         return;
     }
 
+    const QUrl url(IGDB_BASE + "/games");
+
+    // IGDB uses POST with a body query
+    const QByteArray body = QString(
+        "search \"%1\"; "
+        "fields name,summary,storyline,cover.url,screenshots.url,"
+        "genres.name,platforms.name,first_release_date,rating,"
+        "aggregated_rating,total_rating; "
+        "limit 1;"
+    ).arg(gameName).toUtf8();
+
+    auto handleInfo = [this](const QByteArray& data) {
+        runDecoder([data]() { return QVariantList{parseIgdbGameInfo(data)}; },
+                   [this](const QVariantList& decoded) {
+            QVariantMap info = decoded.value(0).toMap();
+            if (info.isEmpty())
+                emit igdbGameInfoError("Game not found on IGDB");
+            else
+                emit igdbGameInfoReady(info);
+        });
+    };
+
+    // A fresh cached answer needs no token round-trip
+    QByteArray cachedBody;
+    if (lookupFresh("POST", url, body, IGDB_INFO_CACHE, &cachedBody)) {
+        handleInfo(cachedBody);
+        return;
+    }
+
     // Ensure we have a valid token, then make the request
-    refreshIGDBToken([this, gameName]() {
-        QUrl url(IGDB_BASE + "/games");
+    refreshIGDBToken([this, url, body, handleInfo]() {
         QNetworkRequest req(url);
         req.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
         req.setRawHeader("Client-ID", m_igdbClientId.toUtf8());
         req.setRawHeader("Authorization", ("Bearer " + m_igdbAccessToken).toUtf8());
-        req.setTransferTimeout(15000);
-
-        // IGDB uses POST with a body query
-        QString body = QString(
-            "search \"%1\"; "
-            "fields name,summary,storyline,cover.url,screenshots.url,"
-            "genres.name,platforms.name,first_release_date,rating,"
-            "aggregated_rating,total_rating; "
-            "limit 1;"
-        ).arg(gameName);
-
-        QNetworkReply *reply = m_nam->post(req, body.toUtf8());
-
-        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            reply->deleteLater();
-            if (reply->error() != QNetworkReply::NoError) {
-                emit igdbGameInfoError(reply->errorString());
-                return;
-            }
 
-            QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-            if (arr.isEmpty()) {
-                emit igdbGameInfoError("Game not found on IGDB");
-                return;
-            }
+        fetchCached(req, "POST", body, IGDB_INFO_CACHE, handleInfo, [this](const QString& error) {
+            emit igdbGameInfoError(error);
+        });
+    });
+}
 
-            QJsonObject obj = arr.first().toObject();
-            QVariantMap info;
-            info["name"]        = obj["name"].toString();
-            info["summary"]     = obj["summary"].toString();
-            info["storyline"]   = obj["storyline"].toString();
-            info["rating"]      = obj["rating"].toDouble();
-            info["totalRating"] = obj["total_rating"].toDouble();
-            info["aggregatedRating"] = obj["aggregated_rating"].toDouble();
+// ─── IGDB: library metadata enrichment ───
 
-            // Release date
-            if (obj.contains("first_release_date")) {
-                qint64 ts = obj["first_release_date"].toInteger();
-                info["releaseDate"] = QDateTime::fromSecsSinceEpoch(ts).toString("MMM d, yyyy");
-            }
+// IGDB allows 10 sub-queries per /multiquery call and 4 requests/s; one
+// batch in flight plus a short gap between batches stays inside both.
+static const int IGDB_BATCH_SIZE = 10;
+static const int IGDB_BATCH_INTERVAL_MS = 300;
 
-            // Cover URL (IGDB returns //images.igdb.com/... — prepend https:)
-            if (obj.contains("cover")) {
-                QString coverUrl = obj["cover"].toObject()["url"].toString();
-                if (coverUrl.startsWith("//"))
-                    coverUrl = "https:" + coverUrl;
-                // Get higher resolution: replace t_thumb with t_cover_big
-                coverUrl.replace("t_thumb", "t_cover_big");
-                info["coverUrl"] = coverUrl;
-            }
+// Library titles go into an APIcalypse string literal
+static QString igdbSearchTerm(QString title) {
+    title.remove(QChar(0x2122));   // ™
+    title.remove(QChar(0x00AE));   // ®
+    title.replace('\\', ' ');
+    title.replace('"', ' ');
+    return title.simplified();
+}
+
+void StoreApiManager::enrichLibraryMetadata()
+{
+    if (!m_db || m_enrichRunning) return;
+    if (m_igdbClientId.isEmpty() || m_igdbClientSecret.isEmpty()) return;
+
+    m_enrichQueue.clear();
+    for (const Game& g : m_db->getGamesNeedingMetadata())
+        m_enrichQueue.append({g.id, g.title});
+    if (m_enrichQueue.isEmpty()) return;
+
+    m_enrichRunning = true;
+    m_enrichTotal = m_enrichQueue.size();
+    m_enrichDone = 0;
+    m_enriched = 0;
+    qDebug() << "IGDB enrichment:" << m_enrichTotal << "games without metadata";
+    enrichNextBatch();
+}
+
+void StoreApiManager::enrichNextBatch()
+{
+    if (m_enrichQueue.isEmpty()) {
+        finishEnrichment();
+        return;
+    }
+
+    const QList<EnrichItem> batch = m_enrichQueue.mid(0, IGDB_BATCH_SIZE);
+
+    // One named sub-query per title; the name is the index in the batch
+    QByteArray body;
+    for (int i = 0; i < batch.size(); ++i) {
+        body += QString(
+            "query games \"%1\" { "
+            "search \"%2\"; "
+            "fields name,summary,genres.name,first_release_date,"
+            "total_rating,aggregated_rating; "
+            "limit 1; };\n"
+        ).arg(i).arg(igdbSearchTerm(batch[i].title)).toUtf8();
+    }
+
+    refreshIGDBToken([this, batch, body]() {
+        QNetworkRequest req(QUrl(IGDB_BASE + "/multiquery"));
+        req.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
+        req.setRawHeader("Client-ID", m_igdbClientId.toUtf8());
+        req.setRawHeader("Authorization", ("Bearer " + m_igdbAccessToken).toUtf8());
 
-            // Screenshots
-            QVariantList screenshots;
-            QJsonArray ssArr = obj["screenshots"].toArray();
-            for (const auto& ss : ssArr) {
-                QString ssUrl = ss.toObject()["url"].toString();
-                if (ssUrl.startsWith("//"))
-                    ssUrl = "https:" + ssUrl;
-                ssUrl.replace("t_thumb", "t_screenshot_big");
-                screenshots.append(ssUrl);
+        sendRequest(req, "POST", body, [this, batch](const NetResult& result) {
+            if (!result.ok) {
+                qWarning() << "IGDB enrichment batch failed:" << result.httpStatus << result.error;
+                if (result.httpStatus == 401)
+                    m_igdbAccessToken.clear();
+                // The batch's rows stay empty and are retried on the next run
+                finishEnrichment();
+                return;
             }
-            info["screenshots"] = screenshots;
-
-            // Genres
-            QStringList genres;
-            QJsonArray genreArr = obj["genres"].toArray();
-            for (const auto& g : genreArr)
-                genres.append(g.toObject()["name"].toString());
-            info["genres"] = genres.join(", ");
-
-            // Platforms
-            QStringList platforms;
-            QJsonArray platArr = obj["platforms"].toArray();
-            for (const auto& p : platArr)
-                platforms.append(p.toObject()["name"].toString());
-            info["platforms"] = platforms.join(", ");
-
-            emit igdbGameInfoReady(info);
+
+            runDecoder([body = result.body, size = int(batch.size())]() {
+                return parseIgdbEnrichment(body, size);
+            }, [this, batch](const QVariantList& rows) {
+                for (int i = 0; i < batch.size() && i < rows.size(); ++i) {
+                    QVariantMap row = rows[i].toMap();
+                    if (row["matched"].toBool())
+                        m_enriched++;
+                    m_db->setGameMetadata(batch[i].gameId, row["metadata"].toString(),
+                                          row["tags"].toString());
+                }
+
+                m_enrichQueue.remove(0, batch.size());
+                m_enrichDone += batch.size();
+                emit metadataEnrichmentProgress(m_enrichDone, m_enrichTotal);
+                QTimer::singleShot(IGDB_BATCH_INTERVAL_MS, this, &StoreApiManager::enrichNextBatch);
+            });
         });
+    }, [this]() {
+        finishEnrichment();
     });
 }
 
-void StoreApiManager::refreshIGDBToken(std::function<void()> onReady)
+void StoreApiManager::finishEnrichment()
+{
+    qDebug() << "IGDB enrichment:" << m_enrichDone << "of" << m_enrichTotal
+             << "games processed," << m_enriched << "matched";
+    m_enrichQueue.clear();
+    m_enrichRunning = false;
+    emit metadataEnrichmentFinished(m_enriched);
+}
+
+void StoreApiManager::refreshIGDBToken(std::function<void()> onReady, std::function<void()> onFailed)
 {
     // Check if current token is still valid (with 60s buffer)
     if (!m_igdbAccessToken.isEmpty() &&
@@ -1390,19 +1764,16 @@ void StoreApiManager::refreshIGDBToken(std::function<void()> onReady)
 
     QNetworkRequest req(url);
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
-    req.setTransferTimeout(10000);
-
-    QNetworkReply *reply = m_nam->post(req, QByteArray());
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply, onReady]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            qWarning() << "IGDB token refresh failed:" << reply->errorString();
-            emit igdbGameInfoError("Failed to authenticate with IGDB: " + reply->errorString());
+    sendRequest(req, "POST", QByteArray(), [this, onReady, onFailed](const NetResult& result) {
+        if (!result.ok) {
+            qWarning() << "IGDB token refresh failed:" << result.error;
+            emit igdbGameInfoError("Failed to authenticate with IGDB: " + result.error);
+            if (onFailed) onFailed();
             return;
         }
 
-        QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+        QJsonObject obj = QJsonDocument::fromJson(result.body).object();
         m_igdbAccessToken = obj["access_token"].toString();
         int expiresIn = obj["expires_in"].toInt();
         m_igdbTokenExpiry = QDateTime::currentSecsSinceEpoch() + expiresIn;
@@ -1512,26 +1883,70 @@ void StoreApiManager::fetchProtonRating(const QString& steamAppId)
 
     QUrl url(PROTONDB_BASE + "/" + steamAppId + ".json");
     QNetworkRequest req(url);
-    req.setTransferTimeout(10000);
-    QNetworkReply *reply = m_nam->get(req);
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply, steamAppId]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            emit protonRatingError(steamAppId, reply->errorString());
-            return;
-        }
+    fetchCached(req, "GET", QByteArray(), PROTON_CACHE, [this, steamAppId](const QByteArray& body) {
+        QVariantMap rating = parseProtonSummary(body);
+        if (m_db)
+            m_db->setProtonRating(steamAppId, rating["tier"].toString(), rating["confidence"].toString());
+        emit protonRatingReady(steamAppId, rating);
+    }, [this, steamAppId](const QString& error) {
+        emit protonRatingError(steamAppId, error);
+    });
+}
+
+QVariantMap StoreApiManager::parseProtonSummary(const QByteArray& body)
+{
+    QJsonObject obj = QJsonDocument::fromJson(body).object();
+    QVariantMap rating;
+    rating["tier"]           = obj["tier"].toString();
+    rating["trendingTier"]   = obj["trendingTier"].toString();
+    rating["bestTier"]       = obj["bestReportedTier"].toString();
+    rating["confidence"]     = obj["confidence"].toString();
+    rating["score"]          = obj["score"].toDouble();
+    rating["totalReports"]   = obj["total"].toInt();
+    return rating;
+}
 
-        QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
-        QVariantMap rating;
-        rating["tier"]           = obj["tier"].toString();
-        rating["trendingTier"]   = obj["trendingTier"].toString();
-        rating["bestTier"]       = obj["bestReportedTier"].toString();
-        rating["confidence"]     = obj["confidence"].toString();
-        rating["score"]          = obj["score"].toDouble();
-        rating["totalReports"]   = obj["total"].toInt();
+void StoreApiManager::prefetchProtonRatings()
+{
+    if (!m_db) return;
 
-        emit protonRatingReady(steamAppId, rating);
+    // Re-query rather than append: anything fetched since the last pass
+    // is fresh in the DB now, and newly scanned games are picked up.
+    m_protonQueue = m_db->getSteamAppIdsNeedingProtonRating(PROTON_RATING_TTL);
+    if (m_protonQueue.isEmpty() || m_protonTimer->isActive()) return;
+
+    qDebug() << "ProtonDB prefetch:" << m_protonQueue.size() << "apps to refresh";
+    m_protonUpdated = 0;
+    m_protonTimer->start();
+    prefetchNextProtonRating();
+}
+
+void StoreApiManager::prefetchNextProtonRating()
+{
+    if (m_protonQueue.isEmpty()) {
+        m_protonTimer->stop();
+        qDebug() << "ProtonDB prefetch: done," << m_protonUpdated << "ratings updated";
+        emit protonPrefetchFinished(m_protonUpdated);
+        return;
+    }
+
+    const QString appId = m_protonQueue.takeFirst();
+    QNetworkRequest req(QUrl(PROTONDB_BASE + "/" + appId + ".json"));
+
+    sendRequest(req, "GET", QByteArray(), [this, appId](const NetResult& result) {
+        if (result.ok) {
+            QVariantMap rating = parseProtonSummary(result.body);
+            m_db->setProtonRating(appId, rating["tier"].toString(), rating["confidence"].toString());
+            m_protonUpdated++;
+            emit protonRatingReady(appId, rating);
+        } else if (result.httpStatus == 404) {
+            // No reports for this app yet; don't ask again until the TTL
+            m_db->setProtonRating(appId, QString(), QString());
+        } else if (result.httpStatus == 0) {
+            // No network: stop here, the next scan resumes from the DB
+            m_protonQueue.clear();
+        }
     });
 }
 
@@ -1553,15 +1968,15 @@ QString StoreApiManager::getStoreIconUrl(int storeId)
 
 QString StoreApiManager::getSteamHeaderUrl(const QString& steamAppId)
 {
-    return STEAM_CDN + "/" + steamAppId + "/header.jpg";
+    return steamHeaderUrl(steamAppId);
 }
 
 QString StoreApiManager::getSteamHeroUrl(const QString& steamAppId)
 {
-    return STEAM_CDN + "/" + steamAppId + "/library_hero.jpg";
+    return steamHeroUrl(steamAppId);
 }
 
 QString StoreApiManager::getSteamCapsuleUrl(const QString& steamAppId)
 {
-    return STEAM_CDN + "/" + steamAppId + "/library_600x900_2x.jpg";
+    return steamCapsuleUrl(steamAppId);
 }
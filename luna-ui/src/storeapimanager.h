@@ -5,14 +5,45 @@
 #include <QVariantList>
 #include <QVariantMap>
 #include <QHash>
+#include <QStringList>
+#include <QUrl>
+#include <QThreadPool>
+#include "outboundscheduler.h"
+#include <functional>
 #include <memory>
 
 class QNetworkAccessManager;
+class QNetworkRequest;
+class QTimer;
+class Database;
+class ResponseCache;
 
 class StoreApiManager : public QObject {
     Q_OBJECT
+    // True while answers are being served from the response cache because
+    // the network failed; cleared by the next successful response.
+    Q_PROPERTY(bool offline READ isOffline NOTIFY offlineChanged)
 public:
     explicit StoreApiManager(QObject *parent = nullptr);
+    ~StoreApiManager();
+
+    // Enables the ProtonDB prefetch and persists on-demand ratings
+    void setDatabase(Database *db);
+    // Reload the library's title identity index; deals and search
+    // results matching it are tagged owned/libraryGameId
+    void refreshOwnedIndex();
+
+    // How long a cached response is served as-is (fresh), then served
+    // while a background refresh runs (stale).  Past both it is only
+    // used as the offline fallback.
+    struct CachePolicy {
+        qint64 freshSecs;
+        qint64 staleSecs;
+    };
+
+    bool isOffline() const { return m_offline; }
+    // Whether the first deals page for this sort is cached (offline browsing)
+    Q_INVOKABLE bool hasOfflineDeals(const QString& sortBy = "Deal Rating", int pageSize = 30);
 
     // ── CheapShark API ──
     Q_INVOKABLE void fetchDeals(const QString& sortBy = "Deal Rating",
@@ -22,7 +53,13 @@ public:
     Q_INVOKABLE void fetchStores();
 
     // ── Search (IGDB + CheapShark) ──
+    // Owned titles from the local library are emitted first, then the
+    // merged network results.  A new search aborts the previous one.
     Q_INVOKABLE void searchGames(const QString& title);
+    // Per keystroke: local results right away, network search once the
+    // user pauses typing
+    Q_INVOKABLE void searchGamesAsYouType(const QString& title);
+    Q_INVOKABLE void cancelSearch();
 
     // ── IGDB API ──
     Q_INVOKABLE void fetchIGDBGameInfo(const QString& gameName);
@@ -31,13 +68,22 @@ public:
     Q_INVOKABLE bool hasIGDBCredentials();
     Q_INVOKABLE bool hasBuiltInIGDBCredentials();
     Q_INVOKABLE QString getIGDBClientId();
+    // Fill games.metadata/tags for library games that have none, ten
+    // titles per IGDB /multiquery request.  Progress lives in the DB, so
+    // an interrupted run picks up where it stopped.
+    Q_INVOKABLE void enrichLibraryMetadata();
 
     // ── Store Price Scraping (fallback when CheapShark has no price) ──
+    // Served from the last snapshot in games.db when there is one; a
+    // stale snapshot is refreshed in the background and re-emitted.
     Q_INVOKABLE void fetchStorePrices(const QString& steamAppId, const QVariantList& purchaseUrls,
                                        const QString& gameTitle = QString());
 
     // ── ProtonDB API ──
     Q_INVOKABLE void fetchProtonRating(const QString& steamAppId);
+    // Walk the library's Steam games and refresh missing/expired ratings
+    // in games.db, one request at a time.  Emits protonRatingReady per app.
+    Q_INVOKABLE void prefetchProtonRatings();
 
     // ── Utility ──
     Q_INVOKABLE QString getStoreName(int storeId);
@@ -50,6 +96,9 @@ signals:
     // CheapShark
     void dealsReady(QVariantList deals);
     void dealsError(const QString& error);
+    // Same pages, tagged with the request they answer (for DealsModel)
+    void dealsPageReady(const QString& sortBy, int pageNumber, QVariantList deals);
+    void dealsPageError(const QString& sortBy, int pageNumber, const QString& error);
     void recentDealsReady(QVariantList deals);
     void recentDealsError(const QString& error);
     void gameDealsReady(QVariantMap details);
@@ -69,14 +118,104 @@ signals:
     void igdbGameInfoReady(QVariantMap gameInfo);
     void igdbGameInfoError(const QString& error);
     void igdbCredentialsSaved();
+    void metadataEnrichmentProgress(int done, int total);
+    void metadataEnrichmentFinished(int enriched);
 
     // ProtonDB
     void protonRatingReady(const QString& steamAppId, QVariantMap rating);
     void protonRatingError(const QString& steamAppId, const QString& error);
+    void protonPrefetchFinished(int updated);
+
+    void offlineChanged();
 
 private:
     QNetworkAccessManager *m_nam;
 
+    // Response cache (memory + disk) in front of m_nam
+    using BodyHandler = std::function<void(const QByteArray&)>;
+    using ErrorHandler = std::function<void(const QString&)>;
+    std::unique_ptr<ResponseCache> m_responseCache;
+    bool m_offline = false;
+    static QString cacheKey(const QByteArray& verb, const QUrl& url, const QByteArray& body);
+    static QUrl dealsUrl(const QString& sortBy, int pageNumber, int pageSize);
+    bool lookupFresh(const QByteArray& verb, const QUrl& url, const QByteArray& body,
+                     const CachePolicy& policy, QByteArray *out);
+    void fetchCached(const QNetworkRequest& req, const QByteArray& verb, const QByteArray& body,
+                     const CachePolicy& policy, BodyHandler onBody, ErrorHandler onError);
+    void setOffline(bool offline);
+
+    // JSON decoding, title matching and search merging run on the pool;
+    // the result is handed back on the GUI thread, ready to emit.
+    QThreadPool m_decodePool;
+    using Decoder = std::function<QVariantList()>;
+    using ListHandler = std::function<void(const QVariantList&)>;
+    void runDecoder(Decoder decode, ListHandler deliver);
+
+    // Every request goes through sendRequest().  Identical requests
+    // (verb + URL + body) issued while one is still running share its
+    // QNetworkReply and each waiter gets the same result.  Below that,
+    // the scheduler applies per-host rate limits, timeouts and retries.
+    OutboundScheduler *m_scheduler;
+    using NetResult = OutboundScheduler::Result;
+    using ResultHandler = std::function<void(const NetResult&)>;
+    // Requests tagged with a group can be dropped together; a shared
+    // reply is only aborted once none of its waiters still need it.
+    enum RequestGroup { NoGroup = 0, SearchGroup };
+    struct Waiter {
+        ResultHandler handler;
+        int group;
+    };
+    struct InFlight {
+        quint64 ticket = 0;
+        QList<Waiter> waiters;
+    };
+    QHash<QString, InFlight> m_inFlight;
+    void sendRequest(const QNetworkRequest& req, const QByteArray& verb, const QByteArray& body,
+                     ResultHandler onDone, int group = NoGroup);
+    void cancelRequests(int group);
+
+    // ProtonDB library prefetch
+    Database *m_db = nullptr;
+    QHash<QString, int> m_ownedIndex;   // Database::getTitleIdentityIndex()
+    QTimer *m_protonTimer;
+    QStringList m_protonQueue;
+    int m_protonUpdated = 0;
+    void prefetchNextProtonRating();
+    static QVariantMap parseProtonSummary(const QByteArray& body);
+
+    // Store price snapshots: fetchStorePrices() answers from games.db and
+    // stale snapshots are re-scraped one game at a time in the background
+    struct PriceJob {
+        QString key;
+        QString steamAppId;
+        QVariantList purchaseUrls;
+        QString gameTitle;
+    };
+    // answered is false if any store could not be reached
+    using PriceHandler = std::function<void(const QVariantList& deals, bool answered)>;
+    QString m_priceViewKey;       // game the detail popup last asked for
+    QString m_priceRefreshKey;    // background scrape in flight
+    QList<PriceJob> m_priceQueue;
+    QTimer *m_priceTimer;
+    static QString priceSnapshotKey(const QString& steamAppId, const QString& gameTitle);
+    bool scrapeStorePrices(const PriceJob& job, PriceHandler onDone);
+    void queuePriceRefresh(const PriceJob& job);
+    void refreshNextPriceSnapshot();
+    void finishPriceScrape(const PriceJob& job, const QVariantList& deals, bool answered, bool background);
+
+    // One scraper per store, used by both search and fetchStorePrices().
+    // onDone gets the store's deal (empty if none) and answered=false
+    // when the store could not be reached.
+    using DealHandler = std::function<void(const QVariantMap& deal, bool answered)>;
+    using DealParser = std::function<QVariantMap(const QByteArray& body)>;
+    void scrapeDeal(const QNetworkRequest& req, const QByteArray& verb, const QByteArray& body,
+                    int group, DealParser parse, DealHandler onDone);
+    void scrapeSteamPrice(const QString& steamAppId, int group, DealHandler onDone);
+    // False if the URL carries no GOG product slug
+    bool scrapeGogPrice(const QString& storeUrl, int group, DealHandler onDone);
+    void scrapeEpicPrice(const QString& gameTitle, int group, DealHandler onDone);
+    void scrapeGmgPrice(const QString& gameTitle, int group, DealHandler onDone);
+
     // Store name cache (storeID → name)
     QHash<int, QString> m_storeNames;
     QHash<int, QString> m_storeIcons;
@@ -91,16 +230,37 @@ private:
 
     // Search merge state for parallel IGDB + CheapShark queries
     struct SearchMergeState {
+        QVariantList localResults;   // owned titles, already emitted
         QVariantList igdbResults;
         QVariantList cheapSharkResults;
         int completedCount = 0;
     };
     int m_searchGeneration = 0;
+    QTimer *m_searchDebounce;
+    QString m_pendingSearch;
+    QVariantList m_pendingLocal;   // already emitted for m_pendingSearch
+    QVariantList localSearchResults(const QString& title);
+    // Network half of a search; local results were already emitted
+    void runNetworkSearch(const QString& title, const QVariantList& local);
     void mergeSearchResults(std::shared_ptr<SearchMergeState> state, int generation);
+    void scrapeMissingPrices(std::shared_ptr<QVariantList> results, int generation);
+
+    // IGDB library enrichment
+    struct EnrichItem {
+        int gameId;
+        QString title;
+    };
+    QList<EnrichItem> m_enrichQueue;
+    bool m_enrichRunning = false;
+    int m_enrichTotal = 0;
+    int m_enrichDone = 0;
+    int m_enriched = 0;
+    void enrichNextBatch();
+    void finishEnrichment();
 
     void loadIGDBCredentials();
     void saveIGDBCredentials();
-    void refreshIGDBToken(std::function<void()> onReady);
+    void refreshIGDBToken(std::function<void()> onReady, std::function<void()> onFailed = nullptr);
     QString igdbCredentialsPath() const;
 };
 
@@ -300,6 +300,8 @@ QVector<Game> EpicBackend::scanLibrary() {
         game.isInstalled = installedApps.contains(game.appId);
         game.launchCommand = "legendary launch " + game.appId;
         game.coverArtUrl = getCoverArtUrl(metadata);
+        game.backgroundArtUrl = getBackgroundArtUrl(metadata);
+        game.logoUrl = getLogoUrl(metadata);
 
         // Read install path from installed.json if installed
         if (game.isInstalled) {
@@ -343,6 +345,35 @@ QString EpicBackend::getCoverArtUrl(const QJsonObject& metadata) const {
         "CodeRedemption_340x440",
     };
 
+    QString url = keyImageUrl(metadata, preferredTypes);
+    if (!url.isEmpty()) return url;
+
+    // Fallback: use the first available image
+    if (!images.isEmpty()) {
+        return images.first().toObject()["url"].toString();
+    }
+
+    return QString();
+}
+
+QString EpicBackend::getBackgroundArtUrl(const QJsonObject& metadata) const {
+    static const QStringList preferredTypes = {
+        "DieselGameBox",
+        "OfferImageWide",
+        "DieselStoreFrontWide",
+    };
+    return keyImageUrl(metadata, preferredTypes);
+}
+
+QString EpicBackend::getLogoUrl(const QJsonObject& metadata) const {
+    static const QStringList preferredTypes = {
+        "DieselGameBoxLogo",
+    };
+    return keyImageUrl(metadata, preferredTypes);
+}
+
+QString EpicBackend::keyImageUrl(const QJsonObject& metadata, const QStringList& preferredTypes) {
+    QJsonArray images = metadata["keyImages"].toArray();
     for (const QString& type : preferredTypes) {
         for (const QJsonValue& img : images) {
             QJsonObject imgObj = img.toObject();
@@ -351,12 +382,6 @@ QString EpicBackend::getCoverArtUrl(const QJsonObject& metadata) const {
             }
         }
     }
-
-    // Fallback: use the first available image
-    if (!images.isEmpty()) {
-        return images.first().toObject()["url"].toString();
-    }
-
     return QString();
 }
 
@@ -392,6 +417,8 @@ QVector<Game> EpicBackend::parseLibraryResponse(const QByteArray& jsonData) cons
         game.isInstalled = installedApps.contains(game.appId);
         game.launchCommand = "legendary launch " + game.appId;
         game.coverArtUrl = getCoverArtUrl(metadata);
+        game.backgroundArtUrl = getBackgroundArtUrl(metadata);
+        game.logoUrl = getLogoUrl(metadata);
 
         if (!game.title.isEmpty() && !game.appId.isEmpty()) {
             games.append(game);
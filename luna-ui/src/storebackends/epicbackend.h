@@ -35,6 +35,11 @@ private:
 
     // Build cover art URL from Epic metadata
     QString getCoverArtUrl(const QJsonObject& metadata) const;
+    // Wide backdrop and title logo from the same keyImages array
+    QString getBackgroundArtUrl(const QJsonObject& metadata) const;
+    QString getLogoUrl(const QJsonObject& metadata) const;
+    // First keyImages URL matching the preferred types, in order
+    static QString keyImageUrl(const QJsonObject& metadata, const QStringList& preferredTypes);
 
     // Find Steam's Proton binary (same logic as SteamBackend)
     QString findProtonBinary() const;
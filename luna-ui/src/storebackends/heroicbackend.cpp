@@ -37,6 +37,8 @@ QVector<Game> HeroicBackend::scanLibrary() {
                 if (obj.contains("art_cover")) {
                     game.coverArtUrl = obj["art_cover"].toString();
                 }
+                game.backgroundArtUrl = obj["art_background"].toString();
+                game.logoUrl = obj["art_logo"].toString();
                 if (!game.title.isEmpty()) {
                     games.append(game);
                 }
@@ -59,6 +61,9 @@ QVector<Game> HeroicBackend::scanLibrary() {
                 game.appId = obj["app_name"].toString();
                 game.isInstalled = obj["is_installed"].toBool();
                 game.launchCommand = "heroic://launch/gog/" + game.appId;
+                game.coverArtUrl = obj["art_cover"].toString();
+                game.backgroundArtUrl = obj["art_background"].toString();
+                game.logoUrl = obj["art_logo"].toString();
                 if (!game.title.isEmpty()) {
                     games.append(game);
                 }
@@ -153,10 +153,26 @@ Game SteamBackend::parseAppManifest(const QString& manifestPath) {
         game.coverArtUrl = "https://steamcdn-a.akamaihd.net/steam/apps/" + game.appId + "/library_600x900_2x.jpg";
         qDebug() << "[steam-artwork] installed" << game.appId << game.title << "-> local cache MISSING, using CDN:" << game.coverArtUrl;
     }
+    fillExtraArtwork(game);
 
     return game;
 }
 
+void SteamBackend::fillExtraArtwork(Game& game) const {
+    QString cache = QDir::homePath() + "/.local/share/Steam/appcache/librarycache/" + game.appId;
+    QString cdn = "https://steamcdn-a.akamaihd.net/steam/apps/" + game.appId;
+
+    QString localHero = cache + "_library_hero.jpg";
+    game.backgroundArtUrl = QFile::exists(localHero) ? localHero : cdn + "/library_hero.jpg";
+
+    QString localLogo = cache + "_logo.png";
+    game.logoUrl = QFile::exists(localLogo) ? localLogo : cdn + "/logo.png";
+
+    // Icons are content-hashed on the CDN; only the client's copy is usable
+    QString localIcon = cache + "_icon.jpg";
+    if (QFile::exists(localIcon)) game.iconPath = localIcon;
+}
+
 // ═══════════════════════════════════════════════════════════════════
 // Game launching — direct executable to bypass Steam's launch dialog
 // ═══════════════════════════════════════════════════════════════════
@@ -540,6 +556,7 @@ QVector<Game> SteamBackend::parseOwnedGamesResponse(const QByteArray& jsonData)
                 game.appId + "/library_600x900_2x.jpg";
             qDebug() << "[steam-artwork] api" << game.appId << game.title << "-> CDN fallback:" << game.coverArtUrl;
         }
+        fillExtraArtwork(game);
 
         if (!game.title.isEmpty() && !isSteamTool(game.appId, game.title)) {
             games.append(game);
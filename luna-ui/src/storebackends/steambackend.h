@@ -24,6 +24,8 @@ public:
 private:
     QVector<QString> getLibraryFolders();
     Game parseAppManifest(const QString& manifestPath);
+    // Hero, logo and icon from the local library cache, else the CDN
+    void fillExtraArtwork(Game& game) const;
 
     // Direct launch helpers (bypass Steam's "Preparing to launch" popup)
     bool launchNativeGame(const Game& game, const QString& gameDir,